@@ -0,0 +1,461 @@
+/**
+  * @file	    bench.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Throughput and latency benchmarks for the adi_imu driver hot paths.
+ **/
+
+#include <stdio.h>
+#include <time.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+/* Calls per benchmark case */
+#define BENCH_CALLS                     2000
+
+/* Virtual time the streaming case runs for, in milliseconds */
+#define BENCH_STREAM_MS                 1000
+
+/* Simulated SCLK, in Hz */
+#define BENCH_SCLK_HZ                   1000000
+
+/* Host work modeled between bursts by the overlap cases, in microseconds */
+#define BENCH_WORK_US                   200
+
+/* Delay from the last word of an asynchronous transfer to its completion, in nanoseconds */
+#define BENCH_ASYNC_LATENCY_NS          2000
+
+/* Data access mode of this build, reported with every result */
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT
+    #define BENCH_CONFIG                "burst32"
+#elif ENABLE_BURST_MODE
+    #define BENCH_CONFIG                "burst16"
+#elif SENSOR_DATA_32BIT
+    #define BENCH_CONFIG                "regread32"
+#else
+    #define BENCH_CONFIG                "regread16"
+#endif
+
+/* Name of the decode case. Build with VERIFY_BURST_CHECKSUM=0 (bench_nochecksum) for the cost of the checksum */
+#if VERIFY_BURST_CHECKSUM
+    #define BENCH_DECODE_NAME           "adi_imu_DecodeBurst/batch16"
+#else
+    #define BENCH_DECODE_NAME           "adi_imu_DecodeBurst/batch16/nochecksum"
+#endif
+
+/* A benchmark case. Returns the number of samples delivered by one call */
+typedef uint32_t (*bench_Case)(adi_imu_Device *imu);
+
+/* Output registers read by the register-read cases, one full sample each */
+static const uint16_t bench_Regs16[] = { DIAG_STAT, X_GYRO_OUT, Y_GYRO_OUT, Z_GYRO_OUT, X_ACCL_OUT, Y_ACCL_OUT,
+                                         Z_ACCL_OUT, TEMP_OUT, DATA_CNTR };
+static const uint16_t bench_Regs32[] = { DIAG_STAT, X_GYRO_LOW, X_GYRO_OUT, Y_GYRO_LOW, Y_GYRO_OUT, Z_GYRO_LOW,
+                                         Z_GYRO_OUT, X_ACCL_LOW, X_ACCL_OUT, Y_ACCL_LOW, Y_ACCL_OUT, Z_ACCL_LOW,
+                                         Z_ACCL_OUT, TEMP_OUT, DATA_CNTR };
+
+#define BENCH_ARRAY_LEN(a)              (sizeof(a) / sizeof((a)[0]))
+
+/* Samples read per call by the batched register-read case */
+#define BENCH_BATCH_SAMPLES             16
+
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT & !ENABLE_DELTA_DATA
+/* Simulated ADIS16470-1 for the model detection cases */
+static const imu_sim_Config bench_Adis16470 = { 16470, 0x0003, 0x0001 };
+#endif
+
+static adi_imu_UnscaledData bench_Raw[BENCH_BATCH_SAMPLES];
+static uint16_t bench_RegData[BENCH_ARRAY_LEN(bench_Regs32) * BENCH_BATCH_SAMPLES];
+
+/**
+ * @brief Reads the process CPU time, in nanoseconds.
+ **/
+static uint64_t bench_CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Prints the CSV header.
+ **/
+static void bench_PrintHeader(void)
+{
+    printf("config,api,calls,cpu_ns_per_call,bytes_per_call,cs_per_call,bus_us_per_call,samples_per_s,stall_violations\n");
+}
+
+/**
+ * @brief Prints one result row.
+ **/
+static void bench_PrintResult(const char *api, uint32_t calls, uint64_t cpuNs, uint64_t busNs, uint32_t samples, const imu_sim_Stats *stats)
+{
+    printf("%s,%s,%u,%.1f,%.2f,%.2f,%.2f,%.1f,%u\n",
+           BENCH_CONFIG, api, calls,
+           (double) cpuNs / calls,
+           (double) stats->bytes / calls,
+           (double) stats->csAssertions / calls,
+           (double) busNs / calls / 1000.0,
+           (busNs > 0) ? (double) samples * 1e9 / (double) busNs : 0.0,
+           stats->stallViolations);
+}
+
+/**
+ * @brief Runs one benchmark case back to back and prints its result.
+ *
+ * CPU time includes the simulated transport, so compare results from the same simulator version only.
+ **/
+static void bench_Run(adi_imu_Device *imu, const char *api, bench_Case fn)
+{
+    imu_sim_Stats stats;
+    uint32_t samples = 0;
+    uint64_t busStart;
+    uint64_t cpuStart;
+    uint64_t cpuNs;
+
+    imu_sim_ClearStats();
+    busStart = imu_sim_Now();
+    cpuStart = bench_CpuNs();
+    for (uint32_t i = 0; i < BENCH_CALLS; i++)
+    {
+        samples += fn(imu);
+    }
+    cpuNs = bench_CpuNs() - cpuStart;
+    imu_sim_GetStats(imu->csPin, &stats);
+    bench_PrintResult(api, BENCH_CALLS, cpuNs, imu_sim_Now() - busStart, samples, &stats);
+}
+
+static uint32_t bench_GetSensorData(adi_imu_Device *imu)
+{
+    return (adi_imu_GetSensorData(imu, &bench_Raw[0]) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+
+#if ENABLE_SCALED_DATA
+static uint32_t bench_GetScaledSensorData(adi_imu_Device *imu)
+{
+    adi_imu_ScaledData data;
+
+    return (adi_imu_GetScaledSensorData(imu, &data) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+#endif
+
+#if ENABLE_SCALED_DATA
+/* Per-sample baseline of the batch case, same BENCH_BATCH_SAMPLES samples */
+static uint32_t bench_ScaleSensorData(adi_imu_Device *imu)
+{
+    static adi_imu_ScaledData out[BENCH_BATCH_SAMPLES];
+    uint32_t samples = 0;
+
+    for (uint16_t i = 0; i < BENCH_BATCH_SAMPLES; i++)
+    {
+        samples += (adi_imu_ScaleSensorData(imu, &bench_Raw[i], &out[i]) == ADI_IMU_SUCCESS) ? 1 : 0;
+    }
+    return samples;
+}
+
+static uint32_t bench_ScaleBatch(adi_imu_Device *imu)
+{
+    static float out[7][BENCH_BATCH_SAMPLES];
+    adi_imu_ScaledBatch batch = { out[0], out[1], out[2], out[3], out[4], out[5], out[6] };
+
+    return (adi_imu_ScaleBatch(imu, bench_Raw, BENCH_BATCH_SAMPLES, &batch) == ADI_IMU_SUCCESS) ? BENCH_BATCH_SAMPLES : 0;
+}
+#endif
+
+#if ENABLE_DECIMATION
+/* Host decimators for the 200, 100 and 50 Hz outputs of the decimation cases */
+static adi_imu_Decimator bench_Decim[3];
+
+/* One input sample per call, so cpu_ns_per_call is the cost per input sample */
+static uint32_t bench_Decimate(adi_imu_Device *imu)
+{
+    adi_imu_UnscaledData out;
+
+    (void) imu;
+    return adi_imu_Decimate(&bench_Decim[0], &bench_Raw[0], &out) ? 1 : 0;
+}
+
+static uint32_t bench_DecimateConcurrent(adi_imu_Device *imu)
+{
+    adi_imu_UnscaledData out;
+    uint32_t samples = 0;
+
+    (void) imu;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        samples += adi_imu_Decimate(&bench_Decim[i], &bench_Raw[0], &out) ? 1 : 0;
+    }
+    return samples;
+}
+
+#if ENABLE_SCALED_DATA
+static uint32_t bench_DecimateScaled(adi_imu_Device *imu)
+{
+    adi_imu_ScaledData out;
+
+    return adi_imu_DecimateScaled(imu, &bench_Decim[0], &bench_Raw[0], &out) ? 1 : 0;
+}
+#endif
+
+#if ENABLE_FIXED_POINT_DATA
+static uint32_t bench_DecimateFixed(adi_imu_Device *imu)
+{
+    adi_imu_FixedData out;
+
+    return adi_imu_DecimateFixed(imu, &bench_Decim[0], &bench_Raw[0], &out) ? 1 : 0;
+}
+#endif
+
+/* BENCH_BATCH_SAMPLES input samples per call, compare cpu_ns_per_call / 16 with the x10 per-sample case */
+static uint32_t bench_DecimateBlock(adi_imu_Device *imu)
+{
+    static adi_imu_UnscaledData out[BENCH_BATCH_SAMPLES];
+
+    (void) imu;
+    return adi_imu_DecimateBlock(&bench_Decim[0], bench_Raw, BENCH_BATCH_SAMPLES, out);
+}
+#endif
+
+#if ENABLE_BURST_MODE
+static adi_imu_BurstPipeline bench_Pipe;
+
+/* A burst captured once, decoded over and over by the decode case */
+static uint8_t bench_Burst[BURST_XFER_LENGTH];
+
+/**
+ * @brief Reads one burst into bench_Burst.
+ **/
+static adi_imu_Status bench_CaptureBurst(adi_imu_Device *imu)
+{
+    uint8_t tx[BURST_XFER_LENGTH];
+    adi_imu_SpiXfer xfer;
+    adi_imu_Status status;
+
+    xfer.txBuf = tx;
+    xfer.rxBuf = bench_Burst;
+    status = adi_imu_SubmitBurst(imu, &xfer, 0, 0);
+    if (status == ADI_IMU_SUCCESS)
+    {
+        status = adi_imu_WaitTransfer(&xfer);
+    }
+    return status;
+}
+
+/* Decodes the captured burst only, so cpu_ns_per_call / samples is the cost of the model dispatch and decoder */
+static uint32_t bench_DecodeBurst(adi_imu_Device *imu)
+{
+    uint32_t samples = 0;
+
+    for (uint16_t i = 0; i < BENCH_BATCH_SAMPLES; i++)
+    {
+        samples += (adi_imu_DecodeBurst(imu, bench_Burst, &bench_Raw[i]) == ADI_IMU_SUCCESS) ? 1 : 0;
+    }
+    return samples;
+}
+
+static uint32_t bench_PipelineGetSensorData(adi_imu_Device *imu)
+{
+    (void) imu;
+    return (adi_imu_PipelineGetSensorData(&bench_Pipe, &bench_Raw[0]) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+
+/* Blocking burst followed by BENCH_WORK_US of host work, the baseline of the overlap cases */
+static uint32_t bench_GetSensorDataWork(adi_imu_Device *imu)
+{
+    uint32_t samples = bench_GetSensorData(imu);
+
+    delay_US(BENCH_WORK_US);
+    return samples;
+}
+
+/* Pipelined burst, the next one stays on the wire while the host works. Only overlaps with ENABLE_ASYNC_SPI */
+static uint32_t bench_PipelineGetSensorDataWork(adi_imu_Device *imu)
+{
+    uint32_t samples = bench_PipelineGetSensorData(imu);
+
+    delay_US(BENCH_WORK_US);
+    return samples;
+}
+
+/* Burst left on the wire while the host works. Only overlaps with ENABLE_ASYNC_SPI */
+static uint32_t bench_SubmitBurstWork(adi_imu_Device *imu)
+{
+    uint8_t tx[BURST_XFER_LENGTH];
+    adi_imu_SpiXfer xfer;
+
+    xfer.txBuf = tx;
+    xfer.rxBuf = bench_Burst;
+    if (adi_imu_SubmitBurst(imu, &xfer, 0, 0) != ADI_IMU_SUCCESS)
+    {
+        return 0;
+    }
+    delay_US(BENCH_WORK_US);
+    if (adi_imu_WaitTransfer(&xfer) != ADI_IMU_SUCCESS)
+    {
+        return 0;
+    }
+    return (adi_imu_DecodeBurst(imu, bench_Burst, &bench_Raw[0]) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+#endif
+
+static uint32_t bench_ReadRegArray16(adi_imu_Device *imu)
+{
+    return (adi_imu_ReadRegArray(imu, bench_Regs16, bench_RegData, BENCH_ARRAY_LEN(bench_Regs16), 1) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+
+static uint32_t bench_ReadRegArray32(adi_imu_Device *imu)
+{
+    return (adi_imu_ReadRegArray(imu, bench_Regs32, bench_RegData, BENCH_ARRAY_LEN(bench_Regs32), 1) == ADI_IMU_SUCCESS) ? 1 : 0;
+}
+
+static uint32_t bench_ReadRegArrayBatch(adi_imu_Device *imu)
+{
+    return (adi_imu_ReadRegArray(imu, bench_Regs16, bench_RegData, BENCH_ARRAY_LEN(bench_Regs16), BENCH_BATCH_SAMPLES) == ADI_IMU_SUCCESS) ? BENCH_BATCH_SAMPLES : 0;
+}
+
+static uint32_t bench_ReadRegCached(adi_imu_Device *imu)
+{
+    uint16_t val;
+
+    adi_imu_ReadReg(imu, PRODUCT_ID_REG, &val);
+    return 0;
+}
+
+static uint32_t bench_ReadRegVolatile(adi_imu_Device *imu)
+{
+    uint16_t val;
+
+    adi_imu_ReadReg(imu, DATA_CNTR, &val);
+    return 0;
+}
+
+static uint32_t bench_WriteReg(adi_imu_Device *imu)
+{
+    adi_imu_WriteReg(imu, SCRATCH_REG, 0x1234);
+    return 0;
+}
+
+static uint32_t bench_CheckComs(adi_imu_Device *imu)
+{
+    adi_imu_CheckComs(imu);
+    return 0;
+}
+
+static uint32_t bench_GetDeviceInfo(adi_imu_Device *imu)
+{
+    adi_imu_DeviceInfo info;
+
+    adi_imu_GetDeviceInfo(imu, &info);
+    return 0;
+}
+
+#if ENABLE_STREAMING
+/**
+ * @brief Streams for BENCH_STREAM_MS of virtual time and prints the sustained sample rate.
+ **/
+static void bench_Stream(adi_imu_Device *imu)
+{
+    static adi_imu_UnscaledData buf[STREAM_RING_SIZE];
+    imu_sim_Stats stats;
+    uint32_t samples = 0;
+    uint16_t numRead;
+    uint64_t busStart;
+    uint64_t cpuStart;
+    uint64_t cpuNs;
+
+    imu_sim_ClearStats();
+    busStart = imu_sim_Now();
+    cpuStart = bench_CpuNs();
+    adi_imu_StreamStart(imu, DIO1, RISING_EDGE);
+    for (uint32_t ms = 0; ms < BENCH_STREAM_MS; ms++)
+    {
+        delay_MS(1);
+        adi_imu_StreamRead(imu, buf, STREAM_RING_SIZE, &numRead);
+        samples += numRead;
+    }
+    adi_imu_StreamStop(imu);
+    cpuNs = bench_CpuNs() - cpuStart;
+    imu_sim_GetStats(imu->csPin, &stats);
+    bench_PrintResult("adi_imu_Stream", (samples > 0) ? samples : 1, cpuNs, imu_sim_Now() - busStart, samples, &stats);
+}
+#endif
+
+int main(void)
+{
+    static adi_imu_Device imu;
+
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(BENCH_SCLK_HZ);
+#if ENABLE_ASYNC_SPI
+    imu_sim_SetAsyncCompletion(TRUE, BENCH_ASYNC_LATENCY_NS);
+#endif
+    if (adi_imu_Init(&imu, 0) != ADI_IMU_SUCCESS)
+    {
+        fprintf(stderr, "adi_imu_Init failed\n");
+        return 1;
+    }
+
+    bench_PrintHeader();
+    bench_Run(&imu, "adi_imu_GetSensorData", bench_GetSensorData);
+#if ENABLE_BURST_MODE
+    adi_imu_PipelineInit(&imu, &bench_Pipe, 0, 0);
+    bench_Run(&imu, "adi_imu_PipelineGetSensorData", bench_PipelineGetSensorData);
+    bench_CaptureBurst(&imu);
+    bench_Run(&imu, BENCH_DECODE_NAME, bench_DecodeBurst);
+    bench_Run(&imu, "adi_imu_GetSensorData/work", bench_GetSensorDataWork);
+    bench_Run(&imu, "adi_imu_SubmitBurst/work", bench_SubmitBurstWork);
+    bench_Run(&imu, "adi_imu_PipelineGetSensorData/work", bench_PipelineGetSensorDataWork);
+#endif
+#if ENABLE_SCALED_DATA
+    bench_Run(&imu, "adi_imu_GetScaledSensorData", bench_GetScaledSensorData);
+#endif
+    bench_Run(&imu, "adi_imu_ReadRegArray/sample16", bench_ReadRegArray16);
+    bench_Run(&imu, "adi_imu_ReadRegArray/sample32", bench_ReadRegArray32);
+    bench_Run(&imu, "adi_imu_ReadRegArray/batch16", bench_ReadRegArrayBatch);
+    bench_Run(&imu, "adi_imu_ReadReg/cached", bench_ReadRegCached);
+    bench_Run(&imu, "adi_imu_ReadReg/volatile", bench_ReadRegVolatile);
+    bench_Run(&imu, "adi_imu_WriteReg", bench_WriteReg);
+    bench_Run(&imu, "adi_imu_CheckComs", bench_CheckComs);
+    bench_Run(&imu, "adi_imu_GetDeviceInfo", bench_GetDeviceInfo);
+#if ENABLE_SCALED_DATA
+    bench_Run(&imu, "adi_imu_ScaleSensorData/batch16", bench_ScaleSensorData);
+    bench_Run(&imu, "adi_imu_ScaleBatch/batch16", bench_ScaleBatch);
+#endif
+#if ENABLE_DECIMATION
+    /* Host decimation cases run on the full-rate input, so no IMU configuration is needed */
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        adi_imu_DecimatorInit(&bench_Decim[i], (uint16_t) (10 << i));
+    }
+    bench_Run(&imu, "adi_imu_Decimate/x10", bench_Decimate);
+    bench_Run(&imu, "adi_imu_Decimate/x10+x20+x40", bench_DecimateConcurrent);
+#if ENABLE_SCALED_DATA
+    bench_Run(&imu, "adi_imu_DecimateScaled/x10", bench_DecimateScaled);
+#endif
+#if ENABLE_FIXED_POINT_DATA
+    bench_Run(&imu, "adi_imu_DecimateFixed/x10", bench_DecimateFixed);
+#endif
+    bench_Run(&imu, "adi_imu_DecimateBlock/x10/batch16", bench_DecimateBlock);
+#endif
+#if ENABLE_STREAMING
+    bench_Stream(&imu);
+#endif
+
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT & !ENABLE_DELTA_DATA
+    /* A member without a 32-bit burst, detected by adi_imu_Init() and read with its 16-bit burst. It has no
+       delta burst, so the case is skipped with ENABLE_DELTA_DATA */
+    imu_sim_Reset(&bench_Adis16470);
+    imu_sim_SetSclk(BENCH_SCLK_HZ);
+    if (adi_imu_Init(&imu, 0) != ADI_IMU_SUCCESS)
+    {
+        fprintf(stderr, "adi_imu_Init failed for the ADIS16470\n");
+        return 1;
+    }
+    bench_Run(&imu, "adi_imu_GetSensorData/16470", bench_GetSensorData);
+    bench_CaptureBurst(&imu);
+    bench_Run(&imu, "adi_imu_DecodeBurst/16470", bench_DecodeBurst);
+#endif
+
+    return 0;
+}
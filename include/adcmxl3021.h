@@ -0,0 +1,109 @@
+/**
+  * @file		  adcmxl3021.h
+  * @date		  10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		ADCMXL3021 register map and configuration file.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "adcmxl3021_regmap.h"
+
+/* Device and family-specific definitions and configurations */
+#define ENABLE_MAGNETOMETER                     0
+#define ENABLE_BAROMETER                        0
+#define SUPPORTS_INERTIAL_DATA                  0
+#define SUPPORTS_32BIT_REGS                     0
+#define SUPPORTS_BURST                          0
+#define SUPPORTS_32BIT_BURST                    0
+#define SUPPORTS_PAGES                          1
+#define MAX_DATA_RATE                           220000
+#define SUPPORTS_PPS                            0
+#define SUPPORTS_EXTERNAL_SYNC                  0
+#define SUPPORTS_ARBITRARY_DEC_RATE             0
+#define SUPPORTS_RANGE_REG                      0
+#define SUPPORTS_BURST_CHECKSUM_CRC             0
+#define SUPPORTS_BURST_CNT                      0
+#define SUPPORTS_BURST_STATUS                   0
+#define SUPPORTS_FIR_BANKS                      1
+#define SUPPORTS_CAPTURE                        1
+#define SUPPORTS_DELTA_DATA                     0
+#define SUPPORTS_BARTLETT_FILTER                0
+
+/* Family-specific timing parameters */
+#define STALL_TIME_US                           16
+#define POWER_ON_TIME_MS                        500
+#define RESET_RECOVERY_TIME_MS                  500
+#define FACTORY_CAL_RESTORE_TIME_MS             300
+#define FLASH_MEMORY_BACKUP_TIME_MS             150
+#define FLASH_MEMORY_TEST_TIME_MS               75
+#define SELF_TEST_TIME_MS                       50
+
+/* Component-specific register locations */
+#define SCRATCH_REG                             REG_USER_SCRATCH
+#define FIRMWARE_REV_REG                        REG_REV_DAY
+#define FIRMWARE_DATE_MONTH_REG                 REG_REV_DAY
+#define FIRMWARE_YEAR_REG                       REG_YEAR_MON
+#define PRODUCT_ID_REG                          REG_PROD_ID
+#define SERIAL_NUMBER_REG                       REG_SERIAL_NUM
+#define COMMAND_REG                             REG_GLOB_CMD
+#define MISC_CTRL_REG                           REG_MISC_CTRL
+#define DECIMATE_REG                            REG_AVG_CNT
+
+/* Members of the family, X(PROD_ID, 32-bit burst support, BURST_SEL support). adi_imu_Init() selects the entry
+   matching the part and assumes the first one until then */
+#define MODEL_TABLE(X)                          X(3021, 0, 0)
+
+/* On-chip decimation. AVG_CNT holds log2 of the averaging factor */
+#define DECIMATE_MAX                            16
+#if SUPPORTS_PAGES
+  #define PAGE_ID_REG                           REG_PAGE_ID
+#endif
+
+/* FIR coefficient banks. Bank n (A = 0) occupies page n + 1, one 16-bit tap per register */
+#if SUPPORTS_FIR_BANKS
+  #define FIR_BANK_COUNT                        6
+  #define FIR_BANK_TAPS                         32
+  #define FIR_BANK_PAGE(bank)                   ((bank) + 1)
+  #define FIR_COEF_REG(bank, tap)               ((uint16_t) (FIR_COEF_A00 + ((bank) << 8) + 2 * (tap)))
+#endif
+
+/* Capture buffers. Every read of an axis buffer register returns the entry at BUF_PNTR and advances it */
+#if SUPPORTS_CAPTURE
+  #define CAPTURE_AXES                          3
+  #define CAPTURE_TIME_SAMPLES                  4096
+  #define CAPTURE_FFT_BINS                      2048
+  #define CAPTURE_POLL_INTERVAL_MS              1
+  #define CAPTURE_BUF_REG(axis)                 ((uint16_t) (REG_X_BUF + 2 * (axis)))
+#endif
+
+/* Register shadow cache policies, X(register, policy). Registers not listed are volatile and never cached */
+#if ENABLE_REG_CACHE
+  #define REG_CACHE_TABLE(X)                    X(REG_PROD_ID,      CACHE_IMMUTABLE) \
+                                                X(REG_REV_DAY,      CACHE_IMMUTABLE) \
+                                                X(REG_YEAR_MON,     CACHE_IMMUTABLE) \
+                                                X(REG_SERIAL_NUM,   CACHE_IMMUTABLE) \
+                                                X(REG_REC_CTRL,     CACHE_WRITE_THROUGH) \
+                                                X(REG_REC_PRD,      CACHE_WRITE_THROUGH) \
+                                                X(REG_FILT_CTRL,    CACHE_WRITE_THROUGH) \
+                                                X(REG_AVG_CNT,      CACHE_WRITE_THROUGH) \
+                                                X(REG_MISC_CTRL,    CACHE_WRITE_THROUGH)
+#endif
+
+/* Record control register bit definitions */
+#define BITP_REC_CTRL_REG_MODE                  0
+#define BITM_REC_CTRL_REG_MODE                  (3 << BITP_REC_CTRL_REG_MODE)
+
+/* Command register bit definitions */
+#define BITP_COMMAND_REG_CAPTURE                11
+#define BITP_COMMAND_REG_SOFTWARE_RST           7
+#define BITP_COMMAND_REG_FLASH_MEM_UPD          6
+#define BITP_COMMAND_REG_FLASH_MEM_TEST         5
+#define BITP_COMMAND_REG_FACTORY_RESTORE        3
+#define BITP_COMMAND_REG_SELF_TEST              2
+#define BITM_COMMAND_REG_CAPTURE                (1 << BITP_COMMAND_REG_CAPTURE)
+#define BITM_COMMAND_REG_SOFTWARE_RST           (1 << BITP_COMMAND_REG_SOFTWARE_RST)
+#define BITM_COMMAND_REG_FLASH_MEM_UPD          (1 << BITP_COMMAND_REG_FLASH_MEM_UPD)
+#define BITM_COMMAND_REG_FLASH_MEM_TEST         (1 << BITP_COMMAND_REG_FLASH_MEM_TEST)
+#define BITM_COMMAND_REG_FACTORY_RESTORE        (1 << BITP_COMMAND_REG_FACTORY_RESTORE)
+#define BITM_COMMAND_REG_SELF_TEST              (1 << BITP_COMMAND_REG_SELF_TEST)
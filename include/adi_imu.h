@@ -29,12 +29,63 @@ extern "C" {
     #include "adis1649x.h" /* ADIS16495, ADIS16497 */
 #elif ADIS1650X
     #include "adis1650x.h" /* ADIS16500, ADIS16505, ADIS16507 */
+#elif ADCMXL3021
+    #include "adcmxl3021.h" /* ADcmXL3021 */
 #endif
 
 /* Conversion function constants */
 #define IMU_GET_16BITS(buf, idx)    ( ((buf[idx] << 8) & 0xFF00) | (buf[1+idx] & 0xFF) )
 #define IMU_GET_32BITS(buf, idx)    ( (uint32_t)((buf[2+idx] << 24) & 0xFF000000) | (uint32_t)((buf[3+idx] << 16) & 0xFF0000) | (uint32_t)((buf[idx] << 8) & 0xFF00) | (uint32_t)(buf[1+idx] & 0xFF) )
 
+/* Burst field decoders referenced by the family BURST_LAYOUT tables */
+#define BURST_U16(buf, idx)         ((uint32_t) IMU_GET_16BITS(buf, idx))
+#define BURST_S16(buf, idx)         ((int32_t) (int16_t) IMU_GET_16BITS(buf, idx))
+#define BURST_S32(buf, idx)         ((int32_t) IMU_GET_32BITS(buf, idx))
+#define BURST_S16_WIDE(buf, idx)    ((int32_t) ((uint32_t) BURST_S16(buf, idx) << 16))
+
+/* Byte sums of each burst field type, accumulated into the burst checksum */
+#define BURST_U16_SUM(buf, idx)     ((uint16_t) (buf[idx] + buf[1+idx]))
+#define BURST_S16_SUM(buf, idx)     ((uint16_t) (buf[idx] + buf[1+idx]))
+#define BURST_S32_SUM(buf, idx)     ((uint16_t) (buf[idx] + buf[1+idx] + buf[2+idx] + buf[3+idx]))
+#define BURST_S16_WIDE_SUM(buf, idx)    BURST_S16_SUM(buf, idx)
+
+/* Register word decoders referenced by the family REGREAD_LAYOUT tables. 32-bit values take the low word first */
+#define REG_U16(words, idx)         ((uint32_t) (words)[idx])
+#define REG_S16(words, idx)         ((int32_t) (int16_t) (words)[idx])
+#define REG_S32(words, idx)         ((int32_t) (((uint32_t) (words)[(idx) + 1] << 16) | (words)[idx]))
+
+
+/* Sensor data word width. 32-bit data is only produced if both the access mode and the IMU support it */
+#if ENABLE_BURST_MODE
+    #define SENSOR_DATA_32BIT           (ENABLE_32_BIT_BURST_MODE & SUPPORTS_32BIT_BURST)
+#else
+    #define SENSOR_DATA_32BIT           (ENABLE_32BIT_DATA & SUPPORTS_32BIT_REGS)
+    #if ENABLE_DELTA_DATA & SENSOR_DATA_32BIT
+        #define REGREAD_LAYOUT          REGREAD_LAYOUT_DELTA_32
+    #elif ENABLE_DELTA_DATA
+        #define REGREAD_LAYOUT          REGREAD_LAYOUT_DELTA_16
+    #elif SENSOR_DATA_32BIT
+        #define REGREAD_LAYOUT          REGREAD_LAYOUT_32
+    #else
+        #define REGREAD_LAYOUT          REGREAD_LAYOUT_16
+    #endif
+#endif
+
+/* Standard gravity used to convert accelerometer data to m/s^2 */
+#define STANDARD_GRAVITY                (float) 9.80665
+
+/* Fixed-point output format. Scaled values are signed Q16.16 */
+#define FIXED_POINT_FRAC_BITS           16
+
+/* Extra fraction bits carried by the fixed-point scale factors, sized so every factor fits in 31 bits */
+#define FIXED_SCALE_16BIT_SHIFT         16
+#define FIXED_SCALE_32BIT_SHIFT         32
+
+/* Converts a units per LSB constant into a fixed-point scale factor. Only use with constant arguments */
+#define FIXED_SCALE(unitsPerLsb, shift) ((int32_t) ((double) (unitsPerLsb) * (double) (1ULL << (FIXED_POINT_FRAC_BITS + (shift))) + 0.5))
+
+/* Applies a fixed-point scale factor to an unscaled value, rounding to the nearest Q16.16 LSB */
+#define FIXED_MUL(raw, scale, shift)    ((int32_t) ((((int64_t) (raw) * (scale)) + (1LL << ((shift) - 1))) >> (shift)))
 
 /* Boolean typedef */
 typedef enum {
@@ -91,11 +142,83 @@ typedef enum {
     ADI_IMU_SPIRW_FAILED,                   /* (1) SPI read/write failed */
     ADI_IMU_PRODID_VERIFY_FAILED,           /* (2) Product ID read from the device does not match the compiled library */
     ADI_IMU_INVALID_DATA_RATE,              /* (3) An invalid data rate was requested */
-    ADI_IMU_BURST_NOT_SUPPORTED,            /* (4) The selected IMU configuration does not support burst data capture */
+    ADI_IMU_BURST_NOT_SUPPORTED,            /* (4) The selected IMU configuration does not support burst data capture in the compiled format */
     ADI_IMU_CHECK_SPI_COMS_FAILED,          /* (5) The SPI communication verification routine failed to read back valid data */
+    ADI_IMU_STREAM_NOT_RUNNING,             /* (6) The requested operation requires the streaming engine to be running */
+    ADI_IMU_STREAM_OVERRUN,                 /* (7) The sample ring buffer was full and one or more samples were dropped */
+    ADI_IMU_PIPELINE_FULL,                  /* (8) Every burst pipeline slot is in flight or awaiting decode */
+    ADI_IMU_PIPELINE_EMPTY,                 /* (9) No burst has been submitted to the pipeline */
+    ADI_IMU_BUS_FULL,                       /* (10) The bus scheduler already holds BUS_MAX_DEVICES devices */
+    ADI_IMU_BURST_CONFIG_FAILED,            /* (11) The IMU did not accept the burst configuration written to MSC_CTRL */
+    ADI_IMU_BURST_CHECKSUM_FAILED,          /* (12) The burst checksum did not match the received payload */
+    ADI_IMU_INVALID_FIR_BANK,               /* (13) The requested FIR coefficient bank does not exist on the IMU */
+    ADI_IMU_CAPTURE_TIMEOUT,                /* (14) The IMU did not complete the capture in the allotted time */
+    ADI_IMU_COMMAND_TIMEOUT,                /* (15) The IMU did not respond within the datasheet command execution time */
+    ADI_IMU_STATUS_COUNT                    /* Number of status codes, not returned by the library */
 } adi_imu_Status;
 
-/* Scaled data struct */
+#if ENABLE_INSTRUMENTATION
+/* Instrumented entry points, X(name) */
+#define INSTR_API_TABLE(X)                  X(READ_REG) \
+                                            X(WRITE_REG) \
+                                            X(READ_REG_ARRAY) \
+                                            X(WRITE_REG_BATCH) \
+                                            X(CHECK_COMS) \
+                                            X(GET_SENSOR_DATA) \
+                                            X(PIPELINE_GET_SENSOR_DATA) \
+                                            X(STREAM_BURST) \
+                                            X(STREAM_READ)
+
+#define INSTR_API_ENUM(name)                INSTR_API_##name,
+typedef enum {
+    INSTR_API_TABLE(INSTR_API_ENUM)
+    INSTR_API_COUNT
+} adi_imu_InstrApi;
+#undef INSTR_API_ENUM
+
+/* Duration statistics, in timer_GetCycles() ticks. Bin i of the histogram counts durations below
+   2^(i + 1 + INSTR_HIST_SHIFT) ticks, the last bin everything longer */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[INSTR_HIST_BINS];
+} adi_imu_InstrTiming;
+
+/* Durations tracked by the instrumentation */
+typedef enum {
+    INSTR_TIMING_TRANSFER = 0,
+    INSTR_TIMING_DECODE = 1
+} adi_imu_InstrTimingId;
+
+/* Instrumentation snapshot */
+typedef struct {
+    uint32_t calls[INSTR_API_COUNT];        /* Returns from each entry point */
+    uint32_t apiErrors[INSTR_API_COUNT];    /* Returns from each entry point with a status other than ADI_IMU_SUCCESS */
+    uint32_t errors[ADI_IMU_STATUS_COUNT];  /* Returns from every entry point, by status code */
+    uint32_t transfers;                     /* SPI transfers completed */
+    uint32_t bytes;                         /* Bytes clocked in each direction */
+    uint32_t csAssertions;                  /* CS assertion/deassertion cycles */
+    adi_imu_InstrTiming transferTime;       /* Submission to completion of every SPI transfer */
+    adi_imu_InstrTiming decodeTime;         /* adi_imu_DecodeBurst() */
+} adi_imu_InstrStats;
+
+/* Records the status returned by an instrumented entry point and passes it through */
+#define INSTR_RETURN(api, status)           adi_imu_InstrRecord(INSTR_API_##api, (status))
+
+/* Declares a start timestamp for INSTR_DECODE_DONE */
+#define INSTR_TIMESTAMP(var)                uint32_t var = timer_GetCycles()
+
+/* Records the duration of a burst decode */
+#define INSTR_DECODE_DONE(start)            adi_imu_InstrTime(INSTR_TIMING_DECODE, timer_GetCycles() - (start))
+#else
+#define INSTR_RETURN(api, status)           (status)
+#define INSTR_TIMESTAMP(var)
+#define INSTR_DECODE_DONE(start)
+#endif
+
+/* Scaled data struct. Gyroscope data in deg/s, accelerometer data in m/s^2, temperature in degrees C */
 #if ENABLE_SCALED_DATA
 typedef struct {
 #if SUPPORTS_BURST_STATUS
@@ -125,7 +248,7 @@ typedef struct {
     } adi_imu_ScaledData;
 #endif
 
-/* Target 16-bit scale factors */
+/* Target 16-bit scale factors, stored as output units per LSB */
 #if ENABLE_SCALED_DATA
 typedef struct {
     float gyro16Scale;
@@ -140,10 +263,9 @@ typedef struct {
 } adi_imu_16Bit_ScaleFactors;
 #endif
 
-/* Target 32-bit scale factors */
+/* Target 32-bit scale factors, stored as output units per LSB */
 #if ENABLE_SCALED_DATA
-    #if SUPPORTS_32BIT_REGS
-        #if ENABLE_32BIT_DATA
+    #if SENSOR_DATA_32BIT
         typedef struct {
             float gyro32Scale;
             float accel32Scale;
@@ -155,10 +277,52 @@ typedef struct {
                 float baroScale;
             #endif
         } adi_imu_32Bit_ScaleFactors;
-        #endif
     #endif
 #endif
 
+/* Fixed-point scaled data struct. Same units as adi_imu_ScaledData, in signed Q16.16 */
+#if ENABLE_FIXED_POINT_DATA
+typedef struct {
+#if SUPPORTS_BURST_STATUS
+    uint32_t status;
+#endif
+#if SUPPORTS_BURST_CNT
+    uint32_t count;
+#endif
+    int32_t xg;
+    int32_t yg;
+    int32_t zg;
+    int32_t xa;
+    int32_t ya;
+    int32_t za;
+    int32_t temperature;
+#if ENABLE_MAGNETOMETER
+    int32_t xm;
+    int32_t ym;
+    int32_t zm;
+#endif
+#if ENABLE_BAROMETER
+    int32_t baro;
+#endif
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    uint32_t chksm_crc;
+#endif
+} adi_imu_FixedData;
+
+/* Fixed-point scale factors. Q16.16 units per LSB, left shifted by the data word's FIXED_SCALE_xxBIT_SHIFT */
+typedef struct {
+    int32_t gyroScale;
+    int32_t accelScale;
+    int32_t tempScale;                      /* Temperature is always a 16-bit word */
+    #if ENABLE_MAGNETOMETER
+        int32_t magScale;
+    #endif
+    #if ENABLE_BAROMETER
+        int32_t baroScale;
+    #endif
+} adi_imu_FixedScaleFactors;
+#endif
+
 /* Unscaled data struct */
 typedef struct {
 #if SUPPORTS_BURST_STATUS
@@ -185,52 +349,630 @@ typedef struct {
 #if SUPPORTS_BURST_CHECKSUM_CRC
     uint32_t chksm_crc;
 #endif
+#if ENABLE_SAMPLE_SEQUENCE
+    uint64_t sequence;                      /* Set by the streaming engine only */
+#endif
+#if ENABLE_TIMESTAMPS
+    uint64_t timestamp;                     /* Host time of the sample in timer_GetNanos() time. Set by the streaming engine only */
+#endif
 } adi_imu_UnscaledData;
 
+#if ENABLE_REG_CACHE
+/* Register shadow cache policies */
+typedef enum {
+    CACHE_VOLATILE = 0,                     /* Always read from the IMU */
+    CACHE_WRITE_THROUGH = 1,                /* Cached after the first read or write, writes always reach the IMU */
+    CACHE_IMMUTABLE = 2                     /* Read once, never changes at runtime */
+} adi_imu_CachePolicy;
+
+/* Register shadow cache slots, one per REG_CACHE_TABLE entry */
+#define REG_CACHE_SLOT(reg, policy)         REG_CACHE_IDX_##reg,
+typedef enum {
+    REG_CACHE_TABLE(REG_CACHE_SLOT)
+    REG_CACHE_ENTRIES
+} adi_imu_RegCacheIndex;
+#undef REG_CACHE_SLOT
+
+/* Register shadow cache statistics */
+typedef struct {
+    uint32_t hits;                          /* Cacheable register reads served from memory */
+    uint32_t misses;                        /* Cacheable register reads which had to go to the IMU */
+} adi_imu_CacheStats;
+#endif
+
+#if SUPPORTS_CAPTURE
+/* Capture record modes, written to the REC_CTRL mode field */
+typedef enum {
+    REC_MODE_MANUAL_FFT = 0,                /* One FFT record per capture command */
+    REC_MODE_AUTO_FFT = 1,                  /* FFT records captured every REC_PRD */
+    REC_MODE_MANUAL_TIME = 2,               /* One time-domain record per capture command */
+    REC_MODE_REAL_TIME = 3                  /* Continuous time-domain streaming */
+} adi_imu_RecordMode;
+
+/* Capture buffer axes */
+typedef enum {
+    CAPTURE_AXIS_X = 0,
+    CAPTURE_AXIS_Y = 1,
+    CAPTURE_AXIS_Z = 2
+} adi_imu_CaptureAxis;
+#endif
+
+#if ENABLE_DELTA_INTEGRATION
+/* Integrated delta angle/velocity over one window */
+typedef struct {
+    float dAngle[3];                        /* Rotation over the window, coning compensated, in degrees */
+    float dVelocity[3];                     /* Velocity change in the window start frame, rotation and sculling compensated, in m/s */
+    uint16_t samples;                       /* IMU samples integrated */
+#if SUPPORTS_BURST_STATUS
+    uint16_t status;                        /* DIAG_STAT of every sample OR'd together */
+#endif
+#if SUPPORTS_BURST_CNT
+    uint16_t count;                         /* DATA_CNTR of the last sample */
+#endif
+} adi_imu_DeltaSummary;
+
+/* Delta integration state. Angles are kept in radians so the compensation terms need no conversion */
+typedef struct {
+    uint16_t window;                        /* Samples per summary */
+    uint16_t samples;                       /* Samples in the current window */
+    float angle[3];                         /* Sum of the delta angles */
+    float velocity[3];                      /* Sum of the delta velocities */
+    float coning[3];                        /* Coning compensation */
+    float sculling[3];                      /* Sculling compensation */
+#if SUPPORTS_BURST_STATUS
+    uint16_t status;
+#endif
+} adi_imu_DeltaIntegrator;
+#endif
+
+#if ENABLE_DECIMATION
+/* Channels filtered by the host decimators: xg, yg, zg, xa, ya, za, temperature */
+#define DECIM_CHANNELS                  7
+
+/* Host CIC decimator for one output rate. Integrators and combs wrap modulo 2^64 by design */
+typedef struct {
+    uint16_t factor;                        /* Input samples per output sample */
+    uint16_t phase;                         /* Input samples since the last output */
+    uint64_t gain;                          /* factor ^ DECIM_CIC_ORDER, divided out of every output */
+    uint64_t integ[DECIM_CIC_ORDER][DECIM_CHANNELS];
+    uint64_t delay[DECIM_CIC_ORDER][DECIM_CHANNELS];
+#if SUPPORTS_BURST_STATUS
+    uint32_t status;                        /* DIAG_STAT of every input sample OR'd together */
+#endif
+} adi_imu_Decimator;
+
+/* Split of the decimation between the IMU and the host for a set of output rates */
+typedef struct {
+    uint16_t decimate;                      /* DECIMATE_REG value */
+#if SUPPORTS_BARTLETT_FILTER
+    uint16_t filter;                        /* FILTER_REG value */
+#endif
+    uint16_t deviceFactor;                  /* On-chip decimation factor */
+    uint8_t numOutputs;
+    uint16_t hostFactor[DECIM_MAX_OUTPUTS]; /* Host decimation factor of each requested rate, in request order */
+} adi_imu_DecimationPlan;
+#endif
+
+#if SUPPORTS_EXTERNAL_SYNC
+/* Sample clock source, written to the MSC_CTRL SYNC_FUNCTION field */
+typedef enum {
+    SYNC_INTERNAL = 0,                      /* Internal sample clock */
+    SYNC_DIRECT = 1,                        /* One sample per sync input edge */
+    SYNC_SCALED = 2,                        /* Internal clock locked to the sync input times UP_SCALE, e.g. a 1 Hz PPS */
+    SYNC_OUTPUT = 3,                        /* Internal clock, the sync pin outputs the sample clock */
+    SYNC_PULSE = 5                          /* One sample per sync input pulse, ADIS16475 and ADIS16477 only */
+} adi_imu_SyncMode;
+#endif
+
+#if ENABLE_TIMESTAMPS
+/* Sample timestamp estimator. Maps the IMU sample clock onto the host clock */
+typedef struct {
+    adi_imu_SyncMode mode;
+    uint32_t periodNs;                      /* Nominal sample period */
+    uint32_t syncPeriodNs;                  /* Sync input period, SYNC_SCALED only */
+    uint16_t lastCount;                     /* DATA_CNTR, or TIME_STAMP in SYNC_SCALED, of the last sample */
+    adi_imu_Boolean valid;                  /* The fields below hold an estimate */
+    uint64_t deviceNs;                      /* IMU time of the last sample, unwrapped */
+    uint64_t pulseNs;                       /* IMU time of the last sync pulse, SYNC_SCALED only */
+    uint64_t hostNs;                        /* Estimated host time of the last sample */
+    int32_t skewPpb;                        /* Host clock rate relative to the IMU clock, minus one */
+} adi_imu_TimeSync;
+#endif
+
+/* Register/value pair for batched register writes */
+typedef struct {
+    uint16_t pageIDRegAddr;
+    uint16_t val;
+} adi_imu_RegWrite;
+
+/* Start-up condition of the IMUs brought up by adi_imu_InitGroup() */
+typedef enum {
+    BOOT_POWER_ON = 0,                      /* Power was just applied, wait up to POWER_ON_TIME_MS */
+    BOOT_SOFTWARE_RESET = 1                 /* Reset every IMU first, then wait up to RESET_RECOVERY_TIME_MS */
+} adi_imu_BootMode;
+
+/* Page tracker value used while the page selected in the IMU is not known */
+#define ADI_IMU_PAGE_UNKNOWN            0xFFFF
+
+/* IMU device context */
+typedef struct adi_imu_Device adi_imu_Device;
+
+/* Shared SPI bus scheduler */
+typedef struct adi_imu_Bus adi_imu_Bus;
+
+/* SPI transfer descriptor used by the non-blocking transport */
+typedef struct adi_imu_SpiXfer adi_imu_SpiXfer;
+
+/* SPI transfer completion callback */
+typedef void (*adi_imu_SpiCallback)(adi_imu_SpiXfer *xfer);
+
+struct adi_imu_SpiXfer {
+    uint8_t csPin;                          /* Chip select of the target device */
+    uint8_t *txBuf;                         /* Owned by the transport until the transfer completes */
+    uint8_t *rxBuf;                         /* Owned by the transport until the transfer completes */
+    uint16_t xferLen;
+    uint16_t wordLen;
+    uint16_t stallTime;
+    adi_imu_SpiCallback callback;           /* Optional, called from the completion context */
+    void *context;                          /* Opaque pointer for use by the callback */
+    volatile adi_imu_Boolean done;          /* Set once the buffers belong to the caller again */
+    volatile adi_imu_Status status;         /* Transfer result, valid once done is set */
+#if ENABLE_INSTRUMENTATION
+    uint32_t startCycles;                   /* timer_GetCycles() at submission */
+#endif
+};
+
+/* Length of a register access word in bytes. Every register frame is a separate CS assertion */
+#define REG_XFER_WORD_LENGTH                2
+
+/* Length of a complete burst transaction in bytes, including the trigger word. Buffers are sized for the longest
+   burst of the family, the length of each transaction comes from the model description */
+#if ENABLE_BURST_MODE
+    #define BURST_XFER_LENGTH               (BURST_BYTE_LENGTH + 2)
+#endif
+
+/* Value passed to adi_imu_FindModel() for the description assumed until the part is identified */
+#define ADI_IMU_MODEL_DEFAULT               0
+
+/* Burst decoder generated from a family burst layout table */
+typedef adi_imu_Status (*adi_imu_BurstDecoder)(const uint8_t *burstRx, adi_imu_UnscaledData *data_struct);
+
+/* Description of one member of the compiled family, selected from PROD_ID by adi_imu_Init() */
+typedef struct {
+    uint16_t prodId;
+    uint16_t stallTimeUs;
+    uint16_t resetRecoveryTimeMs;
+    uint16_t flashBackupTimeMs;
+#if ENABLE_BURST_MODE
+    adi_imu_BurstDecoder decodeBurst;       /* Decoder of the burst format read from this model */
+    uint16_t burstXferLength;               /* Burst transaction length, including the trigger word */
+    uint16_t burstCtrl;                     /* MSC_CTRL burst size selection for the burst format */
+    adi_imu_Boolean hasBurstSel;            /* MSC_CTRL BURST_SEL exists, so the burst can carry the delta outputs */
+#endif
+#if ENABLE_SCALED_DATA
+    float accel16Scale;                     /* Accelerometer (or delta velocity) units per LSB */
+    #if SENSOR_DATA_32BIT
+        float accel32Scale;
+    #endif
+#endif
+#if ENABLE_FIXED_POINT_DATA
+    int32_t accelFixedScale;                /* Fixed-point factor matching the sensor data word width */
+#endif
+} adi_imu_Model;
+
+#if ENABLE_BURST_MODE
+/* Burst pipeline slot ownership */
+typedef enum {
+    BURST_SLOT_FREE = 0,                    /* Owned by the pipeline, ready to be submitted */
+    BURST_SLOT_IN_FLIGHT = 1,               /* Owned by the SPI transport */
+    BURST_SLOT_READY = 2,                   /* Transfer complete, waiting to be acquired by the decoder */
+    BURST_SLOT_DECODING = 3                 /* Owned by the decoder until released */
+} adi_imu_BurstSlotState;
+
+typedef struct adi_imu_BurstPipeline adi_imu_BurstPipeline;
+
+/* Burst pipeline completion callback */
+typedef void (*adi_imu_PipelineCallback)(adi_imu_BurstPipeline *pipe);
+
+/* Burst pipeline slot */
+typedef struct {
+    uint8_t txBuf[BURST_XFER_LENGTH];
+    uint8_t rxBuf[BURST_XFER_LENGTH];
+    adi_imu_SpiXfer xfer;
+    volatile adi_imu_BurstSlotState state;
+    adi_imu_BurstPipeline *pipe;
+#if ENABLE_TIMESTAMPS
+    uint64_t edgeNs;                        /* Data-ready edge the burst was read for. Set by the streaming engine only */
+#endif
+} adi_imu_BurstSlot;
+
+/* N-deep burst pipeline. Slots are submitted and decoded in strict FIFO order */
+struct adi_imu_BurstPipeline {
+    adi_imu_BurstSlot slots[BURST_PIPELINE_DEPTH];
+    uint8_t submitIdx;
+    uint8_t decodeIdx;
+    adi_imu_Device *imu;                    /* Device the bursts are read from */
+    adi_imu_PipelineCallback onComplete;    /* Optional, called from the completion context */
+    void *context;                          /* Opaque pointer for use by onComplete */
+};
+#endif
+
+#if ENABLE_SCALED_DATA
+/* Structure-of-arrays output of the batch scaling stage. Each array holds one entry per sample */
+typedef struct {
+    float *xg;
+    float *yg;
+    float *zg;
+    float *xa;
+    float *ya;
+    float *za;
+    float *temperature;
+#if ENABLE_MAGNETOMETER
+    float *xm;
+    float *ym;
+    float *zm;
+#endif
+#if ENABLE_BAROMETER
+    float *baro;
+#endif
+} adi_imu_ScaledBatch;
+#endif
+
+#if ENABLE_STREAMING
+/* Single-producer/single-consumer sample ring buffer */
+typedef struct {
+    adi_imu_UnscaledData samples[STREAM_RING_SIZE];
+    volatile uint32_t head;                 /* Written by the producer (data-ready context) only */
+    volatile uint32_t tail;                 /* Written by the consumer (application context) only */
+    volatile uint32_t overruns;             /* Written by the producer only */
+    uint32_t overrunsReported;              /* Written by the consumer only */
+} adi_imu_SampleRing;
+
+/* Streaming engine statistics */
+typedef struct {
+    uint32_t samples;                       /* Samples pushed into the ring buffer */
+    uint32_t overruns;                      /* Samples dropped because the ring buffer was full */
+    uint32_t spiErrors;                     /* Bursts discarded because the SPI transfer failed */
+    uint32_t checksumErrors;                /* Bursts discarded because the checksum did not match */
+#if SUPPORTS_BURST_CNT
+    uint32_t missed;                        /* Samples skipped by the IMU between two bursts, from DATA_CNTR */
+    uint32_t duplicates;                    /* Bursts discarded because DATA_CNTR did not advance */
+#endif
+} adi_imu_StreamStats;
+#endif
+
+/* IMU device context. One per physical IMU, owned by the application */
+struct adi_imu_Device {
+    uint8_t csPin;                          /* Chip select passed to the SPI transport */
+    const adi_imu_Model *model;             /* Description of the connected model */
+    uint8_t txBuf[SPI_BUFF_SIZE];           /* Register transaction buffers */
+    uint8_t rxBuf[SPI_BUFF_SIZE];
+    adi_imu_Status status;                  /* Result of the last transaction */
+#if VERIFY_BURST_CHECKSUM
+    uint32_t checksumErrors;                /* Bursts rejected by adi_imu_GetSensorData and the pipeline */
+#endif
+#if ENABLE_REG_CACHE
+    uint16_t regCache[REG_CACHE_ENTRIES];   /* Shadow copies of the REG_CACHE_TABLE registers */
+    uint32_t regCacheValid;                 /* One bit per regCache entry holding a value */
+    adi_imu_CacheStats cacheStats;
+#endif
+#if SUPPORTS_PAGES
+    uint16_t activePage;                    /* Page currently selected in the IMU, or ADI_IMU_PAGE_UNKNOWN */
+#endif
+#if SUPPORTS_CAPTURE
+    uint16_t recordCount;                   /* REC_CNTR when the last capture was started */
+#endif
+#if ENABLE_FIR_BANK_CACHE
+    int16_t firCache[FIR_BANK_COUNT][FIR_BANK_TAPS];    /* Shadow copies of the FIR coefficient banks */
+    uint8_t firCacheValid;                  /* One bit per bank whose shadow copy matches the IMU */
+    adi_imu_Boolean firDirty;               /* Taps were written since the last flash update */
+#endif
+#if ENABLE_SCALED_DATA
+    adi_imu_16Bit_ScaleFactors scale16;     /* Units per LSB for the connected model */
+    #if SENSOR_DATA_32BIT
+        adi_imu_32Bit_ScaleFactors scale32;
+    #endif
+#endif
+#if ENABLE_FIXED_POINT_DATA
+    adi_imu_FixedScaleFactors fixedScale;   /* Fixed-point factors matching the sensor data word width */
+#endif
+#if SUPPORTS_EXTERNAL_SYNC
+    uint16_t syncHz;                        /* Sync input frequency given to adi_imu_SetSyncMode(), 0 if not set */
+#endif
+#if ENABLE_STREAMING
+    adi_imu_SampleRing ring;
+    adi_imu_StreamStats streamStats;
+    adi_imu_BurstPipeline pipeline;         /* Bursts owned by the streaming producer */
+    volatile uint32_t reserved;             /* Ring slots reserved for bursts in flight */
+    volatile adi_imu_Boolean streaming;
+    adi_imu_DatRdyGPIO drPin;
+    adi_imu_Bus *bus;                       /* Shared bus scheduler, or NULL for a dedicated bus */
+    uint8_t busIndex;
+    #if SUPPORTS_BURST_CNT
+        uint16_t lastCount;                 /* DATA_CNTR of the last published sample */
+        adi_imu_Boolean countValid;         /* lastCount holds a value */
+        adi_imu_Boolean countIsTimeStamp;   /* The bursts carry TIME_STAMP in place of DATA_CNTR */
+    #endif
+    #if ENABLE_SAMPLE_SEQUENCE
+        uint64_t sequence;                  /* Sequence number of the last published sample */
+    #endif
+    #if ENABLE_TIMESTAMPS
+        volatile uint64_t edgeNs;           /* Time of the last data-ready edge */
+        adi_imu_TimeSync timeSync;
+    #endif
+#endif
+};
+
+#if ENABLE_STREAMING
+/* Round-robin burst scheduler for several IMUs sharing one SPI bus */
+struct adi_imu_Bus {
+    adi_imu_Device *devices[BUS_MAX_DEVICES];
+    uint8_t numDevices;
+    uint8_t next;                           /* Round-robin position */
+    volatile uint32_t pending;              /* One bit per device with an unserviced data-ready edge */
+    volatile adi_imu_Boolean busy;          /* A burst is on the wire */
+    volatile adi_imu_Boolean scheduling;    /* Re-entrancy guard for adi_imu_BusSchedule() */
+};
+#endif
+
 /* Initialization routine */
-adi_imu_Status adi_imu_Init();
+adi_imu_Status adi_imu_Init(adi_imu_Device *imu, uint8_t csPin);
+
+/* Start up, verify and configure several IMUs with a single shared wait */
+adi_imu_Status adi_imu_InitGroup(adi_imu_Device *imus, const uint8_t *csPins, uint8_t numImus, adi_imu_BootMode mode, const adi_imu_RegWrite *config, uint16_t numConfig);
 
 /* Write to IMU register */
-adi_imu_Status adi_imu_WriteReg(uint16_t pageIDRegAddr, uint16_t val);
+adi_imu_Status adi_imu_WriteReg(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val);
+
+/* Write several IMU registers in one transaction */
+adi_imu_Status adi_imu_WriteRegBatch(adi_imu_Device *imu, const adi_imu_RegWrite *writes, uint16_t numWrites);
 
 /* Read several IMU registers at once */
-adi_imu_Status adi_imu_ReadRegArray(const uint16_t *regList, uint16_t *outData, uint16_t numRegs, uint16_t timesToRead);
+adi_imu_Status adi_imu_ReadRegArray(adi_imu_Device *imu, const uint16_t *regList, uint16_t *outData, uint16_t numRegs, uint16_t timesToRead);
 
 /* Read a single IMU register */
-adi_imu_Status adi_imu_ReadReg(uint16_t pageIDRegAddr, uint16_t *val);
+adi_imu_Status adi_imu_ReadReg(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t *val);
 
 /* Execute a flash update */
-adi_imu_Status adi_imu_FlashUpdate();
+adi_imu_Status adi_imu_FlashUpdate(adi_imu_Device *imu);
 
 /* Execute a software reset */
-adi_imu_Status adi_imu_SoftwareReset();
+adi_imu_Status adi_imu_SoftwareReset(adi_imu_Device *imu);
 
 /* Configure the sensor data rate */
-adi_imu_Status adi_imu_SetDataRate(uint16_t dataRate);
+adi_imu_Status adi_imu_SetDataRate(adi_imu_Device *imu, uint16_t dataRate);
 
 /* Check SPI communication */
-adi_imu_Status adi_imu_CheckComs();
+adi_imu_Status adi_imu_CheckComs(adi_imu_Device *imu);
+
+/* Look up the description of a member of the compiled family */
+const adi_imu_Model *adi_imu_FindModel(uint16_t prodId);
+
+/* Identify the connected model from PROD_ID and select its description */
+adi_imu_Status adi_imu_DetectModel(adi_imu_Device *imu);
 
 /* Update device info/state */
-adi_imu_Status adi_imu_GetDeviceInfo(adi_imu_DeviceInfo *data_info);
+adi_imu_Status adi_imu_GetDeviceInfo(adi_imu_Device *imu, adi_imu_DeviceInfo *data_info);
 
 #if SUPPORTS_PAGES
     /* Set the active register page */
-    adi_imu_Status adi_imu_SetActivePage(uint16_t page);
+    adi_imu_Status adi_imu_SetActivePage(adi_imu_Device *imu, uint16_t page);
 
     /* Get the active register page */
-    adi_imu_Status adi_imu_GetActivePage(uint16_t *active_page);
+    adi_imu_Status adi_imu_GetActivePage(adi_imu_Device *imu, uint16_t *active_page);
+#endif
+
+#if SUPPORTS_FIR_BANKS
+    /* Upload a complete FIR coefficient bank */
+    adi_imu_Status adi_imu_WriteFirBank(adi_imu_Device *imu, uint8_t bank, const int16_t *coeffs);
+
+    /* Read back a complete FIR coefficient bank */
+    adi_imu_Status adi_imu_ReadFirBank(adi_imu_Device *imu, uint8_t bank, int16_t *coeffs);
+
+    /* Store every uploaded FIR coefficient bank in flash */
+    adi_imu_Status adi_imu_CommitFirBanks(adi_imu_Device *imu);
+#endif
+
+#if SUPPORTS_CAPTURE
+    /* Select the record mode used by the next capture */
+    adi_imu_Status adi_imu_SetRecordMode(adi_imu_Device *imu, adi_imu_RecordMode mode);
+
+    /* Start a capture */
+    adi_imu_Status adi_imu_StartCapture(adi_imu_Device *imu);
+
+    /* Wait for the capture started by adi_imu_StartCapture() to complete */
+    adi_imu_Status adi_imu_WaitCapture(adi_imu_Device *imu, uint32_t timeoutMs);
+
+    /* Load a stored record into the capture buffers */
+    adi_imu_Status adi_imu_LoadRecord(adi_imu_Device *imu, uint16_t record);
+
+    /* Download part of one axis of the capture buffers */
+    adi_imu_Status adi_imu_ReadCaptureBuffer(adi_imu_Device *imu, adi_imu_CaptureAxis axis, uint16_t start, uint16_t count, uint16_t *outData);
+
+    /* Capture a record and download every axis */
+    adi_imu_Status adi_imu_CaptureRecord(adi_imu_Device *imu, uint32_t timeoutMs, uint16_t samplesPerAxis, uint16_t *outData);
 #endif
 
 /* Trigger a read of the inertial data and populate the unscaled data struct */
-adi_imu_Status adi_imu_GetSensorData(adi_imu_UnscaledData *data_struct);
+adi_imu_Status adi_imu_GetSensorData(adi_imu_Device *imu, adi_imu_UnscaledData *data_struct);
+
+/* Start a burst read without waiting for it to complete */
+adi_imu_Status adi_imu_SubmitBurst(adi_imu_Device *imu, adi_imu_SpiXfer *xfer, adi_imu_SpiCallback callback, void *context);
+
+/* Parse a received burst buffer into the unscaled data struct */
+adi_imu_Status adi_imu_DecodeBurst(const adi_imu_Device *imu, const uint8_t *burstRx, adi_imu_UnscaledData *data_struct);
+
+#if ENABLE_BURST_MODE
+    /* Reset a burst pipeline bound to a device, releasing every slot */
+    adi_imu_Status adi_imu_PipelineInit(adi_imu_Device *imu, adi_imu_BurstPipeline *pipe, adi_imu_PipelineCallback onComplete, void *context);
+
+    /* Put the next burst on the wire */
+    adi_imu_Status adi_imu_PipelineSubmit(adi_imu_BurstPipeline *pipe);
+
+    /* Check whether the oldest submitted burst has completed */
+    adi_imu_Boolean adi_imu_PipelineReady(const adi_imu_BurstPipeline *pipe);
+
+    /* Take ownership of the oldest completed burst buffer */
+    adi_imu_Status adi_imu_PipelineAcquire(adi_imu_BurstPipeline *pipe, const uint8_t **burstRx);
+
+    /* Hand the acquired burst buffer back to the pipeline */
+    adi_imu_Status adi_imu_PipelineRelease(adi_imu_BurstPipeline *pipe);
+
+    /* Keep one burst in flight while decoding the previous one */
+    adi_imu_Status adi_imu_PipelineGetSensorData(adi_imu_BurstPipeline *pipe, adi_imu_UnscaledData *data_struct);
+#endif
+
+/* Submit a transfer to the SPI transport */
+adi_imu_Status adi_imu_SubmitTransfer(adi_imu_SpiXfer *xfer);
+
+/* Signal transfer completion. Called by the SPI transport */
+void adi_imu_CompleteTransfer(adi_imu_SpiXfer *xfer, adi_imu_Status xferStatus);
+
+/* Poll a submitted transfer for completion */
+adi_imu_Boolean adi_imu_TransferDone(const adi_imu_SpiXfer *xfer);
+
+/* Wait for a submitted transfer to complete */
+adi_imu_Status adi_imu_WaitTransfer(adi_imu_SpiXfer *xfer);
 
 #if ENABLE_SCALED_DATA
     /* Trigger a read of the inertial data and populate the scaled data struct */
-    adi_imu_Status adi_imu_GetScaledSensorData(adi_imu_ScaledData *data_struct);
+    adi_imu_Status adi_imu_GetScaledSensorData(adi_imu_Device *imu, adi_imu_ScaledData *data_struct);
+
+    /* Apply the device scale factors to a single unscaled sample */
+    adi_imu_Status adi_imu_ScaleSensorData(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, adi_imu_ScaledData *data_struct);
+
+    /* Apply the device scale factors to a batch of unscaled samples in one pass */
+    adi_imu_Status adi_imu_ScaleBatch(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, uint16_t numSamples, adi_imu_ScaledBatch *out);
+#endif
+
+#if ENABLE_DELTA_INTEGRATION
+    /* Start integrating delta samples into windows of a fixed number of samples */
+    adi_imu_Status adi_imu_DeltaInit(adi_imu_DeltaIntegrator *integ, uint16_t window);
+
+    /* Add one delta sample to the current window */
+    adi_imu_Boolean adi_imu_DeltaAdd(const adi_imu_Device *imu, adi_imu_DeltaIntegrator *integ, const adi_imu_UnscaledData *raw, adi_imu_DeltaSummary *summary);
+
+    #if ENABLE_STREAMING
+    /* Drain the streaming ring buffer through a delta integrator */
+    adi_imu_Status adi_imu_DeltaStreamRead(adi_imu_Device *imu, adi_imu_DeltaIntegrator *integ, adi_imu_DeltaSummary *summaries, uint16_t maxSummaries, uint16_t *numRead);
+    #endif
+#endif
+
+#if SUPPORTS_EXTERNAL_SYNC
+    /* Select the sample clock source */
+    adi_imu_Status adi_imu_SetSyncMode(adi_imu_Device *imu, adi_imu_SyncMode mode, adi_imu_EdgeType edge, uint16_t syncHz);
+#endif
+
+#if ENABLE_TIMESTAMPS
+    /* Reset a timestamp estimator for the current sample clock configuration */
+    adi_imu_Status adi_imu_TimeSyncInit(adi_imu_Device *imu, adi_imu_TimeSync *ts);
+
+    /* Fuse the data-ready edge time of a sample with its DATA_CNTR or TIME_STAMP */
+    uint64_t adi_imu_TimeSyncUpdate(adi_imu_TimeSync *ts, uint16_t count, uint64_t edgeNs);
+#endif
+
+#if ENABLE_DECIMATION
+    /* Split the decimation for a set of output rates between the IMU and the host */
+    adi_imu_Status adi_imu_PlanDecimation(const uint16_t *rates, uint8_t numRates, adi_imu_DecimationPlan *plan);
+
+    /* Configure the IMU for a decimation plan and reset one host decimator per output */
+    adi_imu_Status adi_imu_ApplyDecimationPlan(adi_imu_Device *imu, const adi_imu_DecimationPlan *plan, adi_imu_Decimator *decimators);
+
+    /* Reset a host decimator */
+    adi_imu_Status adi_imu_DecimatorInit(adi_imu_Decimator *dec, uint16_t factor);
+
+    /* Feed one sample to a host decimator */
+    adi_imu_Boolean adi_imu_Decimate(adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_UnscaledData *out);
+
+    /* Feed a block of samples to a host decimator */
+    uint16_t adi_imu_DecimateBlock(adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, uint16_t numSamples, adi_imu_UnscaledData *out);
+
+    #if ENABLE_SCALED_DATA
+    /* Feed one sample to a host decimator and scale the output */
+    adi_imu_Boolean adi_imu_DecimateScaled(const adi_imu_Device *imu, adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_ScaledData *out);
+    #endif
+
+    #if ENABLE_FIXED_POINT_DATA
+    /* Feed one sample to a host decimator and scale the output using integer math only */
+    adi_imu_Boolean adi_imu_DecimateFixed(const adi_imu_Device *imu, adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_FixedData *out);
+    #endif
+#endif
+
+#if ENABLE_FIXED_POINT_DATA
+    /* Trigger a read of the inertial data and populate the fixed-point data struct */
+    adi_imu_Status adi_imu_GetFixedSensorData(adi_imu_Device *imu, adi_imu_FixedData *data_struct);
+
+    /* Apply the device scale factors to a single unscaled sample using integer math only */
+    adi_imu_Status adi_imu_FixedScaleSensorData(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, adi_imu_FixedData *data_struct);
+#endif
+
+#if ENABLE_REG_CACHE
+    /* Drop every shadow register and clear the cache statistics */
+    adi_imu_Status adi_imu_CacheReset(adi_imu_Device *imu);
+
+    /* Drop every shadow register which may have changed on the IMU */
+    adi_imu_Status adi_imu_CacheInvalidate(adi_imu_Device *imu);
+
+    /* Look up a register in the shadow cache */
+    adi_imu_Boolean adi_imu_CacheRead(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t *val);
+
+    /* Record a value read from the IMU in the shadow cache */
+    void adi_imu_CacheFill(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val);
+
+    /* Record a value written to the IMU in the shadow cache */
+    void adi_imu_CacheWrite(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val);
+
+    /* Get the shadow cache hit and miss counters */
+    adi_imu_Status adi_imu_GetCacheStats(adi_imu_Device *imu, adi_imu_CacheStats *stats);
+#endif
+
+#if ENABLE_INSTRUMENTATION
+    /* Record the status returned by an instrumented entry point */
+    adi_imu_Status adi_imu_InstrRecord(adi_imu_InstrApi api, adi_imu_Status status);
+
+    /* Record a duration */
+    void adi_imu_InstrTime(adi_imu_InstrTimingId timing, uint32_t cycles);
+
+    /* Record a completed SPI transfer */
+    void adi_imu_InstrTransfer(const adi_imu_SpiXfer *xfer);
+
+    /* Clear every instrumentation counter */
+    void adi_imu_InstrReset(void);
+
+    /* Copy the instrumentation counters */
+    void adi_imu_InstrSnapshot(adi_imu_InstrStats *stats);
+#endif
+
+#if ENABLE_STREAMING
+    /* Start capturing one burst per data-ready edge */
+    adi_imu_Status adi_imu_StreamStart(adi_imu_Device *imu, adi_imu_DatRdyGPIO drPin, adi_imu_EdgeType edge);
+
+    /* Stop the streaming engine */
+    adi_imu_Status adi_imu_StreamStop(adi_imu_Device *imu);
+
+    /* Data-ready handler. Called by the platform on every data-ready edge with the device as context */
+    void adi_imu_StreamDataReadyISR(void *context);
+
+    /* Get the number of samples waiting in the ring buffer */
+    uint16_t adi_imu_StreamAvailable(adi_imu_Device *imu);
+
+    /* Drain a batch of samples from the ring buffer */
+    adi_imu_Status adi_imu_StreamRead(adi_imu_Device *imu, adi_imu_UnscaledData *buf, uint16_t maxSamples, uint16_t *numRead);
+
+    /* Get the streaming engine statistics */
+    adi_imu_Status adi_imu_StreamGetStats(adi_imu_Device *imu, adi_imu_StreamStats *stats);
+
+    /* Reset a shared bus scheduler */
+    adi_imu_Status adi_imu_BusInit(adi_imu_Bus *bus);
+
+    /* Attach a device to a shared bus scheduler. Must be called before adi_imu_StreamStart() */
+    adi_imu_Status adi_imu_BusAddDevice(adi_imu_Bus *bus, adi_imu_Device *imu);
+
+    /* Put the next pending burst on a shared bus */
+    void adi_imu_BusSchedule(adi_imu_Bus *bus);
 #endif
 
 #ifdef __cplusplus
 }
 #endif
-#endif
+#endif
\ No newline at end of file
@@ -12,13 +12,17 @@
 
 /**
  * IMU family selection. Uncomment the target IMU family to build in support. 
- * Only one device should be selected at a time!
+ * Only one device should be selected at a time! A family defined by the build, e.g. -DADCMXL3021=1,
+ * takes precedence over the selection below.
  **/
+#if !defined(ADIS16448) && !defined(ADIS1646X) && !defined(ADIS1647X) && !defined(ADIS1649X) && !defined(ADIS1650X) && !defined(ADCMXL3021)
 //#define ADIS16448                         1
 //#define ADIS1646X                         1
 #define ADIS1647X                         1
 //#define ADIS1649X                         1
 //#define ADIS1650X                         1
+//#define ADCMXL3021                        1
+#endif
 
 /* Enable the user-specified IMU header */
 #if ADIS16448
@@ -31,6 +35,8 @@
     #include "adis1649x.h" /* ADIS16495, ADIS16497 */
 #elif ADIS1650X
     #include "adis1650x.h" /* ADIS16500, ADIS16505, ADIS16507 */
+#elif ADCMXL3021
+    #include "adcmxl3021.h" /* ADcmXL3021 */
 #endif
 
 /**
@@ -45,36 +51,213 @@
  * Enable compiling floating-point operations. 
  * Adds support for applying scale factors to IMU data.
  **/
-#define ENABLE_SCALED_DATA                1
+#if SUPPORTS_INERTIAL_DATA
+  #define ENABLE_SCALED_DATA              1
+#endif
+
+
+/**
+ * Enable compiling fixed-point scaled data support. 
+ * Applies the scale factors using integer math only and produces signed Q16.16 output.
+ * Intended for targets without a floating-point unit. Independent of ENABLE_SCALED_DATA.
+ * May be overridden from the build flags.
+ **/
+#if SUPPORTS_INERTIAL_DATA
+  #ifndef ENABLE_FIXED_POINT_DATA
+    #define ENABLE_FIXED_POINT_DATA       0
+  #endif
+#endif
 
 
 /**
  * Enable using burst read mode to access sensor data?
- * Does not affect discreet register reads/writes.
+ * Does not affect discreet register reads/writes. May be overridden from the build flags.
  **/
 #if SUPPORTS_BURST
-  #define ENABLE_BURST_MODE               1
+  #ifndef ENABLE_BURST_MODE
+    #define ENABLE_BURST_MODE             1
+  #endif
 #endif
 
 
 /**
  * Enable 32-bit reads to access sensor data (if the sensor supports it)?
+ * The ADIS16470 only supports 16-bit bursts and is read with them, widened to 32-bit LSBs, when detected.
+ * May be overridden from the build flags.
  **/
 #if SUPPORTS_32BIT_BURST
-  #define ENABLE_32_BIT_BURST_MODE        1
+  #ifndef ENABLE_32_BIT_BURST_MODE
+    #define ENABLE_32_BIT_BURST_MODE      1
+  #endif
+#endif
+
+
+/**
+ * Read the delta angle and delta velocity outputs instead of the gyroscope and accelerometer outputs?
+ * Every sample then carries the rotation (degrees) and velocity change (m/s) over its sample period in
+ * xg..zg and xa..za, scaled data included. May be overridden from the build flags.
+ **/
+#if SUPPORTS_DELTA_DATA
+  #ifndef ENABLE_DELTA_DATA
+    #define ENABLE_DELTA_DATA             0
+  #endif
+#endif
+
+
+/**
+ * Enable summing delta samples over fixed-length windows with coning and sculling compensation.
+ **/
+#if ENABLE_DELTA_DATA & ENABLE_SCALED_DATA
+  #define ENABLE_DELTA_INTEGRATION        1
+#endif
+
+
+/**
+ * Enable the host-side CIC decimators and the output rate planner, for output rates below the IMU data
+ * rate and for several output rates from a single sample stream.
+ * DECIM_CIC_ORDER sets the number of integrator/comb stages. Each output carries the decimation factor to
+ * the power DECIM_CIC_ORDER of gain internally, which must not exceed 2^32.
+ * DECIM_MAX_OUTPUTS sets the number of output rates one plan can serve.
+ **/
+#if SUPPORTS_INERTIAL_DATA
+  #define ENABLE_DECIMATION               1
+  #define DECIM_CIC_ORDER                 3
+  #define DECIM_MAX_OUTPUTS               4
+#endif
+
+
+/**
+ * Verify the burst checksum while decoding (if the sensor supports it)?
+ * Corrupted bursts are rejected with ADI_IMU_BURST_CHECKSUM_FAILED and never reach the caller.
+ * May be overridden from the build flags.
+ **/
+#if SUPPORTS_BURST_CHECKSUM_CRC
+  #ifndef VERIFY_BURST_CHECKSUM
+    #define VERIFY_BURST_CHECKSUM         1
+  #endif
 #endif
 
 
 /**
  * Perform an IMU communications check after executing any subroutine.
+ * Not needed by commands which end with a readiness poll.
  **/
 #define CHECK_COMS_AFTER_COMMAND          1
 
 
+/**
+ * Detect the end of a flash update or software reset by polling PROD_ID instead of always waiting the
+ * datasheet worst case. The poll interval starts at READY_POLL_MIN_INTERVAL_US and doubles up to
+ * READY_POLL_MAX_INTERVAL_US. The datasheet execution time remains the hard timeout.
+ **/
+#define ENABLE_READY_POLL                 1
+#define READY_POLL_MIN_INTERVAL_US        500
+#define READY_POLL_MAX_INTERVAL_US        8000
+
+
+/**
+ * Enable the register shadow cache. Identification and configuration registers listed in the family
+ * REG_CACHE_TABLE are served from memory after the first access instead of being read over SPI.
+ **/
+#define ENABLE_REG_CACHE                  1
+
+
 /**
  * Set the tx and rx buffer size. Used for managing SPI transactions.
  **/
 #define SPI_BUFF_SIZE                     64
 
 
+/**
+ * Use the non-blocking SPI transport (spi_TransferAsync) for bursts and register transactions.
+ * When disabled, the blocking spi_Transfer is used and no asynchronous transport is required.
+ * May be overridden from the build flags.
+ **/
+#ifndef ENABLE_ASYNC_SPI
+#define ENABLE_ASYNC_SPI                  0
+#endif
+
+
+/**
+ * Set the number of burst buffers in the burst pipeline. Two gives classic ping-pong buffering where
+ * burst N+1 is on the wire while burst N is decoded.
+ **/
+#define BURST_PIPELINE_DEPTH              2
+
+
+/**
+ * Enable the data-ready driven streaming engine. One burst is captured per
+ * data-ready edge and pushed into a lock-free sample ring buffer.
+ **/
+#if ENABLE_BURST_MODE
+  #define ENABLE_STREAMING                1
+#endif
+
+
+/**
+ * Set the depth of the streaming sample ring buffer. Must be a power of two.
+ **/
+#define STREAM_RING_SIZE                  64
+
+
+/**
+ * Tag every streamed sample with a monotonically increasing 64-bit sequence number (if the sensor supports it)?
+ * The sequence is reconstructed from DATA_CNTR, so missed samples leave matching gaps in it.
+ **/
+#if SUPPORTS_BURST_CNT
+  #define ENABLE_SAMPLE_SEQUENCE          0
+#endif
+
+
+/**
+ * Timestamp samples on the host clock (if the sensor supports it)? The data-ready edge time is fused with
+ * DATA_CNTR (TIME_STAMP in scaled sync mode) by a clock offset and skew estimator which removes the interrupt
+ * latency jitter and follows the drift between the IMU and host clocks. The streaming engine stamps every
+ * sample, reading the edge time with timer_GetNanos(), which the platform must then implement.
+ * May be overridden from the build flags.
+ * TIMESYNC_LATENCY_NS is the shortest data-ready interrupt latency of the platform, removed from every timestamp.
+ * TIMESYNC_RESYNC_NS is the timestamp error beyond which the estimator starts over, e.g. after a sync input loss.
+ **/
+#if SUPPORTS_BURST_CNT & SUPPORTS_EXTERNAL_SYNC
+  #ifndef ENABLE_TIMESTAMPS
+    #define ENABLE_TIMESTAMPS             0
+  #endif
+  #define TIMESYNC_LATENCY_NS             0
+  #define TIMESYNC_RESYNC_NS              1000000
+#endif
+
+
+/**
+ * Keep a shadow copy of the FIR coefficient banks (if the sensor has them)?
+ * Bank uploads then only write the taps which changed. Costs FIR_BANK_COUNT * FIR_BANK_TAPS words per device.
+ **/
+#if SUPPORTS_FIR_BANKS
+  #define ENABLE_FIR_BANK_CACHE           1
+#endif
+
+
+/**
+ * Enable the hot-path instrumentation: call and error counters, bus traffic and transfer/decode duration
+ * histograms. Requires the platform to implement timer_GetCycles(). Compiles to nothing when disabled.
+ * May be overridden from the build flags.
+ **/
+#ifndef ENABLE_INSTRUMENTATION
+  #define ENABLE_INSTRUMENTATION          0
+#endif
+
+
+/**
+ * Set the number of log2 bins in each instrumentation duration histogram, and the number of cycle counter
+ * bits dropped before binning. The last bin collects everything from 2^(INSTR_HIST_BINS + INSTR_HIST_SHIFT - 1) ticks.
+ **/
+#define INSTR_HIST_BINS                   16
+#define INSTR_HIST_SHIFT                  4
+
+
+/**
+ * Set the maximum number of IMUs a single bus scheduler can round-robin between.
+ **/
+#define BUS_MAX_DEVICES                   4
+
+
 #endif
@@ -0,0 +1,576 @@
+/**
+  * @file		  adi_imu_traits.hpp
+  * @date		  10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Compile-time IMU model descriptions and model-specialized access for C++ targets.
+ **/
+
+#ifndef __ADI_IMU_TRAITS_HPP_
+#define __ADI_IMU_TRAITS_HPP_
+
+extern "C" {
+#include "adi_imu.h"
+#include "spi_driver.h"
+}
+
+/**
+ * Every IMU model is described by a traits struct holding its register locations, timing, capabilities and
+ * scale factors as compile-time constants. adi_imu::Imu is specialized on a model, a burst format and an output
+ * selection, so each instance gets its own burst decoder with every field offset, word width and scale factor
+ * folded in, and using a feature the model lacks fails to compile instead of being checked at run time.
+ *
+ * The descriptions do not depend on the family selected in adi_imu_conf.h, so IMUs of different models and
+ * families can share one build and one SPI bus. Only the transport (adi_imu_SubmitTransfer()) is shared with the
+ * C driver. When the selected family is described here, its traits are checked against the family header below.
+ **/
+
+namespace adi_imu
+{
+
+/* Burst payload layouts, byte offsets after the trigger response word. 32-bit outputs are sent low word first */
+struct Burst16
+{
+    static constexpr bool wide = false;
+    static constexpr uint16_t byteLength = 20;
+    static constexpr uint16_t statusIndex = 0;
+    static constexpr uint16_t gyroIndex = 2;
+    static constexpr uint16_t accelIndex = 8;
+    static constexpr uint16_t tempIndex = 14;
+    static constexpr uint16_t countIndex = 16;
+    static constexpr uint16_t checksumIndex = 18;
+};
+
+struct Burst32
+{
+    static constexpr bool wide = true;
+    static constexpr uint16_t byteLength = 32;
+    static constexpr uint16_t statusIndex = 0;
+    static constexpr uint16_t gyroIndex = 2;
+    static constexpr uint16_t accelIndex = 14;
+    static constexpr uint16_t tempIndex = 26;
+    static constexpr uint16_t countIndex = 28;
+    static constexpr uint16_t checksumIndex = 30;
+};
+
+/* Burst output selection (MSC_CTRL BURST_SEL) */
+enum class Output
+{
+    Inertial,                               /* Gyroscope and accelerometer */
+    Delta                                   /* Delta angle and delta velocity */
+};
+
+/* ADIS16470, ADIS16475, ADIS16477 family description */
+struct ADIS1647XFamily
+{
+    /* Capabilities */
+    static constexpr bool supportsBurst = true;
+    static constexpr bool supportsPages = false;
+    static constexpr bool supportsRangeReg = true;
+
+    /* Timing */
+    static constexpr uint16_t stallTimeUs = 16;
+    static constexpr uint16_t powerOnTimeMs = 252;
+    static constexpr uint16_t resetRecoveryTimeMs = 193;
+    static constexpr uint16_t selfTestTimeMs = 14;
+    static constexpr uint32_t maxDataRate = 2000;
+    static constexpr uint16_t decimateMax = 2000;
+
+    /* Registers, [15:8] = page id, [7:0] = reg addr */
+    static constexpr uint16_t pageIdReg = 0x0000;
+    static constexpr uint16_t prodIdReg = 0x0072;
+    static constexpr uint16_t rangeReg = 0x005E;
+    static constexpr uint16_t miscCtrlReg = 0x0060;
+    static constexpr uint16_t commandReg = 0x0068;
+
+    /* Register fields */
+    static constexpr uint16_t rangeMask = 0x000C;
+    static constexpr uint16_t miscCtrlBurstSize = 1 << 9;
+    static constexpr uint16_t miscCtrlBurstSel = 1 << 8;
+
+    /* Burst access */
+    static constexpr uint16_t burstTriggerReg = commandReg;
+    static constexpr uint16_t burstPayloadOffset = 2;
+
+    /* Scale factors, in units per LSB */
+    static constexpr float tempScale = 0.1f;
+
+    /* Gyroscope LSB/(degree/s) of the 16-bit output for a RANG_MDL[3:2] setting */
+    static constexpr float GyroLsbPerDps(adi_imu_RangeReg range)
+    {
+        return (range == RANGE_125DPS) ? 160.0f : ((range == RANGE_500DPS) ? 40.0f : 10.0f);
+    }
+
+    /* Delta angle range, in degrees, for a RANG_MDL[3:2] setting */
+    static constexpr float DeltaAngleRange(adi_imu_RangeReg range)
+    {
+        return (range == RANGE_125DPS) ? 360.0f : ((range == RANGE_500DPS) ? 720.0f : 2160.0f);
+    }
+};
+
+/**
+ * @brief ADIS1647X model description.
+ *
+ * @tparam ProdId The PROD_ID reported by the model.
+ *
+ * @tparam Range The gyroscope range reported in RANG_MDL[3:2].
+ *
+ * @tparam AccelLsbPerG The accelerometer LSB/g of the 16-bit output, times 1000.
+ *
+ * @tparam DeltaVelRange The delta velocity range, in m/s.
+ *
+ * @tparam Has32BitBurst Whether MSC_CTRL BURST_SIZE selects a 32-bit burst.
+ *
+ * @tparam HasBurstSel Whether MSC_CTRL BURST_SEL selects the delta outputs for the burst.
+ **/
+template<uint16_t ProdId, adi_imu_RangeReg Range, uint32_t AccelLsbPerG, uint16_t DeltaVelRange, bool Has32BitBurst, bool HasBurstSel>
+struct ADIS1647XModel : ADIS1647XFamily
+{
+    static constexpr uint16_t prodId = ProdId;
+    static constexpr adi_imu_RangeReg range = Range;
+    static constexpr bool supports32BitBurst = Has32BitBurst;
+    static constexpr bool supportsDeltaData = HasBurstSel;
+
+    static constexpr float gyro16Scale = 1.0f / GyroLsbPerDps(Range);
+    static constexpr float gyro32Scale = gyro16Scale / 65536.0f;
+    static constexpr float accel16Scale = STANDARD_GRAVITY * 1000.0f / (float) AccelLsbPerG;
+    static constexpr float accel32Scale = accel16Scale / 65536.0f;
+    static constexpr float deltaAngle16Scale = DeltaAngleRange(Range) / 32768.0f;
+    static constexpr float deltaAngle32Scale = DeltaAngleRange(Range) / 2147483648.0f;
+    static constexpr float deltaVel16Scale = (float) DeltaVelRange / 32768.0f;
+    static constexpr float deltaVel32Scale = (float) DeltaVelRange / 2147483648.0f;
+};
+
+typedef ADIS1647XModel<16470, RANGE_2000DPS, 800000, 400, false, false> ADIS16470;
+typedef ADIS1647XModel<16475, RANGE_125DPS, 4000000, 100, true, true> ADIS16475_1;
+typedef ADIS1647XModel<16475, RANGE_500DPS, 4000000, 100, true, true> ADIS16475_2;
+typedef ADIS1647XModel<16475, RANGE_2000DPS, 4000000, 100, true, true> ADIS16475_3;
+typedef ADIS1647XModel<16477, RANGE_125DPS, 800000, 400, true, true> ADIS16477_1;
+typedef ADIS1647XModel<16477, RANGE_500DPS, 800000, 400, true, true> ADIS16477_2;
+typedef ADIS1647XModel<16477, RANGE_2000DPS, 800000, 400, true, true> ADIS16477_3;
+
+/* ADcmXL3021 description. Register access only, the capture API of the C driver covers its data */
+struct ADcmXL3021
+{
+    /* Capabilities */
+    static constexpr bool supportsBurst = false;
+    static constexpr bool supportsPages = true;
+    static constexpr bool supportsRangeReg = false;
+    static constexpr bool supportsDeltaData = false;
+    static constexpr bool supports32BitBurst = false;
+
+    /* Timing */
+    static constexpr uint16_t stallTimeUs = 16;
+    static constexpr uint16_t powerOnTimeMs = 500;
+    static constexpr uint16_t resetRecoveryTimeMs = 500;
+    static constexpr uint16_t selfTestTimeMs = 50;
+    static constexpr uint32_t maxDataRate = 220000;
+    static constexpr uint16_t decimateMax = 16;
+
+    /* Registers, [15:8] = page id, [7:0] = reg addr */
+    static constexpr uint16_t pageIdReg = 0x0000;
+    static constexpr uint16_t prodIdReg = 0x0056;
+    static constexpr uint16_t miscCtrlReg = 0x0064;
+    static constexpr uint16_t commandReg = 0x003E;
+
+    static constexpr uint16_t prodId = 3021;
+};
+
+/* Raw sample. Same field names as adi_imu_UnscaledData, independent of the family selected in adi_imu_conf.h */
+struct UnscaledData
+{
+    uint32_t status;
+    uint32_t count;
+    int32_t xg;
+    int32_t yg;
+    int32_t zg;
+    int32_t xa;
+    int32_t ya;
+    int32_t za;
+    int32_t temperature;
+    uint32_t chksm_crc;
+};
+
+/* Scaled sample. Angular rate in degrees/s, acceleration in m/s^2, or degrees and m/s for delta outputs */
+struct ScaledData
+{
+    float xg;
+    float yg;
+    float zg;
+    float xa;
+    float ya;
+    float za;
+    float temperature;
+};
+
+/* Burst word readers and checksum byte sums, selected by the burst format */
+template<bool Wide>
+struct BurstWord;
+
+template<>
+struct BurstWord<false>
+{
+    static int32_t Get(const uint8_t *buf) { return (int32_t) (int16_t) IMU_GET_16BITS(buf, 0); }
+    static uint16_t Sum(const uint8_t *buf) { return (uint16_t) (buf[0] + buf[1]); }
+};
+
+template<>
+struct BurstWord<true>
+{
+    static int32_t Get(const uint8_t *buf) { return (int32_t) IMU_GET_32BITS(buf, 0); }
+    static uint16_t Sum(const uint8_t *buf) { return (uint16_t) (buf[0] + buf[1] + buf[2] + buf[3]); }
+};
+
+/* Scale factors of a model for a burst format and output selection */
+template<class Model, class Format, Output Out>
+struct BurstScale
+{
+    static constexpr float gyro = (Out == Output::Delta) ? (Format::wide ? Model::deltaAngle32Scale : Model::deltaAngle16Scale)
+                                                         : (Format::wide ? Model::gyro32Scale : Model::gyro16Scale);
+    static constexpr float accel = (Out == Output::Delta) ? (Format::wide ? Model::deltaVel32Scale : Model::deltaVel16Scale)
+                                                          : (Format::wide ? Model::accel32Scale : Model::accel16Scale);
+};
+
+/**
+ * @brief IMU access specialized on a model description.
+ *
+ * @tparam Model An IMU model description, e.g. adi_imu::ADIS16477_2.
+ *
+ * @tparam Format The burst payload layout, adi_imu::Burst16 or adi_imu::Burst32.
+ *
+ * @tparam Out The burst output selection.
+ *
+ * Register access works with every model. The burst functions only compile for models with a burst, and
+ * Burst32 and Output::Delta only for models which support them.
+ **/
+template<class Model, class Format = Burst16, Output Out = Output::Inertial>
+class Imu
+{
+public:
+    /* Burst transfer length, including the trigger word */
+    static constexpr uint16_t burstXferLength = Format::byteLength + 2;
+
+    /**
+     * @brief Binds the instance to its chip select.
+     *
+     * @param csPin The chip select passed to the SPI transport for every transaction with this device.
+     **/
+    explicit Imu(uint8_t csPin) : csPin(csPin), activePage(ADI_IMU_PAGE_UNKNOWN)
+    {
+    }
+
+    /**
+     * @brief Verifies the connected model and configures the burst format.
+     *
+     * @return ADI_IMU_PRODID_VERIFY_FAILED if PROD_ID, or RANG_MDL when the family has one, does not match the
+     * model description, ADI_IMU_BURST_CONFIG_FAILED if the IMU did not accept the burst format, otherwise a
+     * status code indicating the success of the SPI transactions.
+     **/
+    adi_imu_Status Init()
+    {
+        adi_imu_Status status;
+        uint16_t val = 0;
+
+        activePage = ADI_IMU_PAGE_UNKNOWN;
+        status = ReadReg(Model::prodIdReg, val);
+        if (status != ADI_IMU_SUCCESS)
+        {
+            return status;
+        }
+        if (val != Model::prodId)
+        {
+            return ADI_IMU_PRODID_VERIFY_FAILED;
+        }
+        return Verify(ModelTag<Model::supportsRangeReg>());
+    }
+
+    /**
+     * @brief Writes a 16-bit register.
+     *
+     * @param pageIDRegAddr The register location, [15:8] = page id, [7:0] = reg addr.
+     *
+     * @param val The value to be written.
+     *
+     * @return A status code indicating the success of the SPI transaction.
+     **/
+    adi_imu_Status WriteReg(uint16_t pageIDRegAddr, uint16_t val)
+    {
+        uint16_t len = SelectPage(pageIDRegAddr);
+
+        txBuf[len] = (uint8_t) (0x80 | (pageIDRegAddr & 0xFF));
+        txBuf[len + 1] = (uint8_t) (val & 0xFF);
+        txBuf[len + 2] = (uint8_t) (0x80 | ((pageIDRegAddr & 0xFF) + 1));
+        txBuf[len + 3] = (uint8_t) ((val >> 8) & 0xFF);
+        if (Model::supportsPages && ((pageIDRegAddr & 0xFF) == (Model::pageIdReg & 0xFF)))
+        {
+            activePage = val;
+        }
+
+        return Transfer(len + 4, REG_XFER_WORD_LENGTH);
+    }
+
+    /**
+     * @brief Reads a 16-bit register.
+     *
+     * @param pageIDRegAddr The register location, [15:8] = page id, [7:0] = reg addr.
+     *
+     * @param val The value read back.
+     *
+     * @return A status code indicating the success of the SPI transaction.
+     **/
+    adi_imu_Status ReadReg(uint16_t pageIDRegAddr, uint16_t &val)
+    {
+        adi_imu_Status status;
+        uint16_t len = SelectPage(pageIDRegAddr);
+
+        txBuf[len] = (uint8_t) (pageIDRegAddr & 0xFF);
+        txBuf[len + 1] = 0x00;
+        txBuf[len + 2] = 0x00;
+        txBuf[len + 3] = 0x00;
+        status = Transfer(len + 4, REG_XFER_WORD_LENGTH);
+        /* The response to the read is clocked out by the following word */
+        val = (uint16_t) ((rxBuf[len + 2] << 8) | rxBuf[len + 3]);
+
+        return status;
+    }
+
+    /**
+     * @brief Reads one sample with a single burst.
+     *
+     * @param data The sample to be populated.
+     *
+     * @return ADI_IMU_BURST_CHECKSUM_FAILED if the checksum did not match, otherwise a status code indicating the
+     * success of the SPI transaction.
+     **/
+    adi_imu_Status ReadBurst(UnscaledData &data)
+    {
+        static_assert(Model::supportsBurst, "The model has no burst read");
+        adi_imu_Status status;
+
+        txBuf[0] = (uint8_t) (Model::burstTriggerReg & 0xFF);
+        for (uint16_t i = 1; i < burstXferLength; i++)
+        {
+            txBuf[i] = 0x00;
+        }
+        status = Transfer(burstXferLength, burstXferLength);
+        if (status != ADI_IMU_SUCCESS)
+        {
+            return status;
+        }
+
+        return DecodeBurst(rxBuf, data);
+    }
+
+    /**
+     * @brief Decodes a raw burst response.
+     *
+     * @param burstRx The received burst, including the leading trigger response word.
+     *
+     * @param data The sample to be populated. Still written on a checksum mismatch and must then be discarded.
+     *
+     * @return ADI_IMU_BURST_CHECKSUM_FAILED if the checksum did not match, ADI_IMU_SUCCESS otherwise.
+     *
+     * Every offset and word width is a constant of the template arguments, so this compiles to straight-line
+     * loads with the checksum summed in the same pass, like the BURST_LAYOUT expansion of adi_imu_DecodeBurst().
+     **/
+    static adi_imu_Status DecodeBurst(const uint8_t *burstRx, UnscaledData &data)
+    {
+        static_assert(Model::supportsBurst, "The model has no burst read");
+        typedef BurstWord<Format::wide> Word;
+        const uint8_t *payload = burstRx + Model::burstPayloadOffset;
+        const uint16_t width = Format::wide ? 4 : 2;
+        uint16_t checksum;
+
+        data.status = (uint32_t) IMU_GET_16BITS(payload, Format::statusIndex);
+        data.xg = Word::Get(payload + Format::gyroIndex);
+        data.yg = Word::Get(payload + Format::gyroIndex + width);
+        data.zg = Word::Get(payload + Format::gyroIndex + 2 * width);
+        data.xa = Word::Get(payload + Format::accelIndex);
+        data.ya = Word::Get(payload + Format::accelIndex + width);
+        data.za = Word::Get(payload + Format::accelIndex + 2 * width);
+        data.temperature = (int32_t) (int16_t) IMU_GET_16BITS(payload, Format::tempIndex);
+        data.count = (uint32_t) IMU_GET_16BITS(payload, Format::countIndex);
+        data.chksm_crc = (uint32_t) IMU_GET_16BITS(payload, Format::checksumIndex);
+
+        checksum = BurstWord<false>::Sum(payload + Format::statusIndex);
+        for (uint16_t i = 0; i < 3; i++)
+        {
+            checksum += Word::Sum(payload + Format::gyroIndex + i * width);
+            checksum += Word::Sum(payload + Format::accelIndex + i * width);
+        }
+        checksum += BurstWord<false>::Sum(payload + Format::tempIndex);
+        checksum += BurstWord<false>::Sum(payload + Format::countIndex);
+
+        return (checksum == data.chksm_crc) ? ADI_IMU_SUCCESS : ADI_IMU_BURST_CHECKSUM_FAILED;
+    }
+
+    /**
+     * @brief Applies the scale factors of the model to a burst sample.
+     *
+     * @param raw The unscaled sample.
+     *
+     * @param scaled The sample to be populated.
+     **/
+    static void Scale(const UnscaledData &raw, ScaledData &scaled)
+    {
+        static_assert(Model::supportsBurst, "The model has no burst read");
+        typedef BurstScale<Model, Format, Out> Factor;
+
+        scaled.xg = (float) raw.xg * Factor::gyro;
+        scaled.yg = (float) raw.yg * Factor::gyro;
+        scaled.zg = (float) raw.zg * Factor::gyro;
+        scaled.xa = (float) raw.xa * Factor::accel;
+        scaled.ya = (float) raw.ya * Factor::accel;
+        scaled.za = (float) raw.za * Factor::accel;
+        scaled.temperature = (float) raw.temperature * Model::tempScale;
+    }
+
+private:
+    template<bool HasRangeReg>
+    struct ModelTag
+    {
+    };
+
+    /* Checks the gyroscope range of the connected IMU, then configures the burst */
+    adi_imu_Status Verify(ModelTag<true>)
+    {
+        adi_imu_Status status;
+        uint16_t val = 0;
+
+        status = ReadReg(Model::rangeReg, val);
+        if (status != ADI_IMU_SUCCESS)
+        {
+            return status;
+        }
+        if ((val & Model::rangeMask) != Model::range)
+        {
+            return ADI_IMU_PRODID_VERIFY_FAILED;
+        }
+        return ConfigureBurst(BurstTag<Model::supportsBurst>());
+    }
+
+    /* Families without a range register are identified by PROD_ID alone */
+    adi_imu_Status Verify(ModelTag<false>)
+    {
+        return ConfigureBurst(BurstTag<Model::supportsBurst>());
+    }
+
+    template<bool HasBurst>
+    struct BurstTag
+    {
+    };
+
+    /* Selects the burst size and output in MSC_CTRL, reading the write back like adi_imu_Init() */
+    adi_imu_Status ConfigureBurst(BurstTag<true>)
+    {
+        static_assert(!Format::wide || Model::supports32BitBurst, "The model only supports 16-bit bursts");
+        static_assert((Out == Output::Inertial) || Model::supportsDeltaData, "The model has no delta outputs");
+        const uint16_t mask = Model::miscCtrlBurstSize | Model::miscCtrlBurstSel;
+        const uint16_t burstCtrl = (Format::wide ? Model::miscCtrlBurstSize : 0) | ((Out == Output::Delta) ? Model::miscCtrlBurstSel : 0);
+        adi_imu_Status status;
+        uint16_t miscCtrl = 0;
+
+        status = ReadReg(Model::miscCtrlReg, miscCtrl);
+        if ((status != ADI_IMU_SUCCESS) || ((miscCtrl & mask) == burstCtrl))
+        {
+            return status;
+        }
+        status = WriteReg(Model::miscCtrlReg, (uint16_t) ((miscCtrl & ~mask) | burstCtrl));
+        if (status == ADI_IMU_SUCCESS)
+        {
+            status = ReadReg(Model::miscCtrlReg, miscCtrl);
+        }
+        if ((status == ADI_IMU_SUCCESS) && ((miscCtrl & mask) != burstCtrl))
+        {
+            status = ADI_IMU_BURST_CONFIG_FAILED;
+        }
+
+        return status;
+    }
+
+    adi_imu_Status ConfigureBurst(BurstTag<false>)
+    {
+        return ADI_IMU_SUCCESS;
+    }
+
+    /* Queues a PAGE_ID write if the register is not on the active page. Returns the tx buffer offset after it */
+    uint16_t SelectPage(uint16_t pageIDRegAddr)
+    {
+        uint16_t page = (uint16_t) (pageIDRegAddr >> 8);
+
+        if (!Model::supportsPages || (page == activePage) || ((pageIDRegAddr & 0xFF) == (Model::pageIdReg & 0xFF)))
+        {
+            return 0;
+        }
+        txBuf[0] = (uint8_t) (0x80 | (Model::pageIdReg & 0xFF));
+        txBuf[1] = (uint8_t) page;
+        activePage = page;
+
+        return 2;
+    }
+
+    /* Blocking transfer of the tx buffer through the transport selected in the C driver */
+    adi_imu_Status Transfer(uint16_t xferLen, uint16_t wordLen)
+    {
+        adi_imu_Status status;
+        adi_imu_SpiXfer xfer;
+
+        xfer.csPin = csPin;
+        xfer.txBuf = txBuf;
+        xfer.rxBuf = rxBuf;
+        xfer.xferLen = xferLen;
+        xfer.wordLen = wordLen;
+        xfer.stallTime = Model::stallTimeUs;
+        xfer.callback = 0;
+        xfer.context = 0;
+
+        status = adi_imu_SubmitTransfer(&xfer);
+        if (status != ADI_IMU_SUCCESS)
+        {
+            return status;
+        }
+
+        return adi_imu_WaitTransfer(&xfer);
+    }
+
+    /* Register transactions need at most a page select and one register access */
+    static constexpr uint16_t bufferLength = (burstXferLength > 6) ? burstXferLength : 6;
+
+    uint8_t csPin;
+    uint16_t activePage;
+    uint8_t txBuf[bufferLength];
+    uint8_t rxBuf[bufferLength];
+};
+
+/* Cross-check the description of the family selected in adi_imu_conf.h against its header */
+#if ADIS1647X
+static_assert(ADIS1647XFamily::stallTimeUs == STALL_TIME_US, "ADIS1647X timing out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::powerOnTimeMs == POWER_ON_TIME_MS, "ADIS1647X timing out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::resetRecoveryTimeMs == RESET_RECOVERY_TIME_MS, "ADIS1647X timing out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::maxDataRate == MAX_DATA_RATE, "ADIS1647X timing out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::decimateMax == DECIMATE_MAX, "ADIS1647X timing out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::prodIdReg == PRODUCT_ID_REG, "ADIS1647X registers out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::rangeReg == RANGE_REG, "ADIS1647X registers out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::miscCtrlReg == MISC_CTRL_REG, "ADIS1647X registers out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::commandReg == COMMAND_REG, "ADIS1647X registers out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::miscCtrlBurstSize == BITM_MISC_CTRL_REG_BURST_SIZE, "ADIS1647X registers out of sync with adis1647x.h");
+static_assert(ADIS1647XFamily::miscCtrlBurstSel == BITM_MISC_CTRL_REG_BURST_SEL, "ADIS1647X registers out of sync with adis1647x.h");
+#if ENABLE_BURST_MODE
+static_assert(ADIS1647XFamily::burstPayloadOffset == BURST_PAYLOAD_OFFSET, "ADIS1647X burst out of sync with adis1647x.h");
+static_assert((SENSOR_DATA_32BIT ? Burst32::byteLength : Burst16::byteLength) == BURST_BYTE_LENGTH, "ADIS1647X burst out of sync with adis1647x.h");
+static_assert((SENSOR_DATA_32BIT ? Burst32::countIndex : Burst16::countIndex) == COUNT_INDEX, "ADIS1647X burst out of sync with adis1647x.h");
+#endif
+#elif ADCMXL3021
+static_assert(ADcmXL3021::stallTimeUs == STALL_TIME_US, "ADcmXL3021 timing out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::powerOnTimeMs == POWER_ON_TIME_MS, "ADcmXL3021 timing out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::resetRecoveryTimeMs == RESET_RECOVERY_TIME_MS, "ADcmXL3021 timing out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::maxDataRate == MAX_DATA_RATE, "ADcmXL3021 timing out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::decimateMax == DECIMATE_MAX, "ADcmXL3021 timing out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::pageIdReg == PAGE_ID_REG, "ADcmXL3021 registers out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::prodIdReg == PRODUCT_ID_REG, "ADcmXL3021 registers out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::miscCtrlReg == MISC_CTRL_REG, "ADcmXL3021 registers out of sync with adcmxl3021.h");
+static_assert(ADcmXL3021::commandReg == COMMAND_REG, "ADcmXL3021 registers out of sync with adcmxl3021.h");
+#endif
+
+}
+
+#endif
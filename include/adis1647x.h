@@ -11,9 +11,10 @@
 /* Device and family-specific definitions and configurations */
 #define ENABLE_MAGNETOMETER                     0
 #define ENABLE_BAROMETER                        0
+#define SUPPORTS_INERTIAL_DATA                  1
 #define SUPPORTS_32BIT_REGS                     1
 #define SUPPORTS_BURST                          1
-#define SUPPORTS_32BIT_BURST                    0
+#define SUPPORTS_32BIT_BURST                    1
 #define SUPPORTS_PAGES                          0
 #define MAX_DATA_RATE                           2000
 #define SUPPORTS_PPS                            1
@@ -23,6 +24,10 @@
 #define SUPPORTS_BURST_CHECKSUM_CRC             1
 #define SUPPORTS_BURST_CNT                      1
 #define SUPPORTS_BURST_STATUS                   1
+#define SUPPORTS_FIR_BANKS                      0
+#define SUPPORTS_CAPTURE                        0
+#define SUPPORTS_DELTA_DATA                     1
+#define SUPPORTS_BARTLETT_FILTER                1
 
 /* Family-specific timing parameters */
 #define STALL_TIME_US                           16
@@ -43,6 +48,25 @@
 #define COMMAND_REG                             GLOB_CMD
 #define MISC_CTRL_REG                           MSC_CTRL
 #define DECIMATE_REG                            DEC_RATE
+
+/* Members of the family, X(PROD_ID, 32-bit burst support, BURST_SEL support). adi_imu_Init() selects the entry
+   matching the part and assumes the first one until then */
+#define MODEL_TABLE(X)                          X(16470, 0, 0) \
+                                                X(16475, 1, 1) \
+                                                X(16477, 1, 1)
+
+/* Scaled sync (PPS) mode. The burst then carries TIME_STAMP, the time since the last sync pulse, in place of DATA_CNTR */
+#if SUPPORTS_PPS
+  #define SYNC_SCALED_MAX_HZ                    128
+  #define TIME_STAMP_LSB_NS                     49020
+#endif
+
+/* On-chip decimation and filtering. DEC_RATE holds the decimation factor minus one, FILT_CTRL log2 of the Bartlett stage length */
+#define DECIMATE_MAX                            2000
+#if SUPPORTS_BARTLETT_FILTER
+  #define FILTER_REG                            FILT_CTRL
+  #define FILTER_SIZE_MAX                       6
+#endif
 #if SUPPORTS_PAGES
   #define PAGE_ID_REG                           PAGE_ID
 #endif
@@ -51,7 +75,7 @@
 #endif
 
 /* Component-specific scale factors */
-#if ENABLE_SCALED_DATA
+#if ENABLE_SCALED_DATA | ENABLE_FIXED_POINT_DATA
   /* Enable 32-bit scale factors if either the burst or regular reads support it */
   #if SUPPORTS_32BIT_REGS | SUPPORTS_32BIT_BURST
     #define GYRO_32BIT_SCALE_125                (float) 10485760
@@ -68,35 +92,200 @@
   #define ACCEL_16BIT_SCALE_40G                   (float) 800
   #define TEMPERATURE_SCALE                       (float) 10
   #define TEMPERATURE_OFFSET                      (float) 0
+
+  /* Model-specific scale selection. The gyro range comes from RANG_MDL, the accelerometer range from PROD_ID */
+  #define GYRO_16BIT_SCALE_FOR_RANGE(r)           (((r) == RANGE_125DPS) ? GYRO_16BIT_SCALE_125 : \
+                                                  (((r) == RANGE_500DPS) ? GYRO_16BIT_SCALE_500 : GYRO_16BIT_SCALE_2000))
+  #define ACCEL_16BIT_SCALE_FOR_PROD_ID(id)       (((id) == 16475) ? ACCEL_16BIT_SCALE_8G : ACCEL_16BIT_SCALE_40G)
+  #if SUPPORTS_32BIT_REGS | SUPPORTS_32BIT_BURST
+    #define GYRO_32BIT_SCALE_FOR_RANGE(r)         (((r) == RANGE_125DPS) ? GYRO_32BIT_SCALE_125 : \
+                                                  (((r) == RANGE_500DPS) ? GYRO_32BIT_SCALE_500 : GYRO_32BIT_SCALE_2000))
+    #define ACCEL_32BIT_SCALE_FOR_PROD_ID(id)     (((id) == 16475) ? ACCEL_32BIT_SCALE_8G : ACCEL_32BIT_SCALE_40G)
+  #endif
+
+  /* Delta angle (LSB/degree) and delta velocity (LSB/(m/s), +/-100 m/s for the ADIS16475, +/-400 m/s otherwise)
+     scale factors. The delta angle range follows the gyro range: +/-360, +/-720 or +/-2160 degrees */
+  #define DELTANG_16BIT_SCALE_FOR_RANGE(r)        (((r) == RANGE_125DPS) ? (float) (32768.0 / 360.0) : \
+                                                  (((r) == RANGE_500DPS) ? (float) (32768.0 / 720.0) : (float) (32768.0 / 2160.0)))
+  #define DELTVEL_16BIT_SCALE_FOR_PROD_ID(id)     (((id) == 16475) ? (float) 327.68 : (float) 81.92)
+  #if SUPPORTS_32BIT_REGS | SUPPORTS_32BIT_BURST
+    #define DELTANG_32BIT_SCALE_FOR_RANGE(r)      (((r) == RANGE_125DPS) ? (float) (2147483648.0 / 360.0) : \
+                                                  (((r) == RANGE_500DPS) ? (float) (2147483648.0 / 720.0) : (float) (2147483648.0 / 2160.0)))
+    #define DELTVEL_32BIT_SCALE_FOR_PROD_ID(id)   (((id) == 16475) ? (float) 21474836.48 : (float) 5368709.12)
+  #endif
+#endif
+
+/* Fixed-point scale selection. Every branch is folded to an integer constant at compile time */
+#if ENABLE_FIXED_POINT_DATA
+  #define GYRO_16BIT_FIXED_FOR_RANGE(r)           (((r) == RANGE_125DPS) ? FIXED_SCALE(1.0 / GYRO_16BIT_SCALE_125, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  (((r) == RANGE_500DPS) ? FIXED_SCALE(1.0 / GYRO_16BIT_SCALE_500, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  FIXED_SCALE(1.0 / GYRO_16BIT_SCALE_2000, FIXED_SCALE_16BIT_SHIFT)))
+  #define ACCEL_16BIT_FIXED_FOR_PROD_ID(id)       (((id) == 16475) ? FIXED_SCALE(STANDARD_GRAVITY / ACCEL_16BIT_SCALE_8G, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  FIXED_SCALE(STANDARD_GRAVITY / ACCEL_16BIT_SCALE_40G, FIXED_SCALE_16BIT_SHIFT))
+  #define TEMPERATURE_FIXED_SCALE                 FIXED_SCALE(1.0 / TEMPERATURE_SCALE, FIXED_SCALE_16BIT_SHIFT)
+  #define TEMPERATURE_FIXED_OFFSET                FIXED_SCALE(TEMPERATURE_OFFSET, 0)
+  #if SUPPORTS_32BIT_REGS | SUPPORTS_32BIT_BURST
+    #define GYRO_32BIT_FIXED_FOR_RANGE(r)         (((r) == RANGE_125DPS) ? FIXED_SCALE(1.0 / GYRO_32BIT_SCALE_125, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  (((r) == RANGE_500DPS) ? FIXED_SCALE(1.0 / GYRO_32BIT_SCALE_500, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  FIXED_SCALE(1.0 / GYRO_32BIT_SCALE_2000, FIXED_SCALE_32BIT_SHIFT)))
+    #define ACCEL_32BIT_FIXED_FOR_PROD_ID(id)     (((id) == 16475) ? FIXED_SCALE(STANDARD_GRAVITY / ACCEL_32BIT_SCALE_8G, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  FIXED_SCALE(STANDARD_GRAVITY / ACCEL_32BIT_SCALE_40G, FIXED_SCALE_32BIT_SHIFT))
+  #endif
+  #define DELTANG_16BIT_FIXED_FOR_RANGE(r)        (((r) == RANGE_125DPS) ? FIXED_SCALE(360.0 / 32768.0, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  (((r) == RANGE_500DPS) ? FIXED_SCALE(720.0 / 32768.0, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  FIXED_SCALE(2160.0 / 32768.0, FIXED_SCALE_16BIT_SHIFT)))
+  #define DELTVEL_16BIT_FIXED_FOR_PROD_ID(id)     (((id) == 16475) ? FIXED_SCALE(1.0 / 327.68, FIXED_SCALE_16BIT_SHIFT) : \
+                                                  FIXED_SCALE(1.0 / 81.92, FIXED_SCALE_16BIT_SHIFT))
+  #if SUPPORTS_32BIT_REGS | SUPPORTS_32BIT_BURST
+    #define DELTANG_32BIT_FIXED_FOR_RANGE(r)      (((r) == RANGE_125DPS) ? FIXED_SCALE(360.0 / 2147483648.0, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  (((r) == RANGE_500DPS) ? FIXED_SCALE(720.0 / 2147483648.0, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  FIXED_SCALE(2160.0 / 2147483648.0, FIXED_SCALE_32BIT_SHIFT)))
+    #define DELTVEL_32BIT_FIXED_FOR_PROD_ID(id)   (((id) == 16475) ? FIXED_SCALE(1.0 / 21474836.48, FIXED_SCALE_32BIT_SHIFT) : \
+                                                  FIXED_SCALE(1.0 / 5368709.12, FIXED_SCALE_32BIT_SHIFT))
+  #endif
 #endif
 
 /* Burst mode-specific definitions */
 #if SUPPORTS_BURST
   #if ENABLE_BURST_MODE
     #define BURST_TRIGGER_REG                   GLOB_CMD
-    #define BURST_BYTE_LENGTH                   20
     #define BURST_PAYLOAD_OFFSET                2
 
-    /* 16-bit Burst message definition */
-    #define STATUS_INDEX                        0
-    #define XG_INDEX                            2
-    #define YG_INDEX                            4
-    #define ZG_INDEX                            6
-    #define XA_INDEX                            8
-    #define YA_INDEX                            10
-    #define ZA_INDEX                            12
-    #define TEMP_OUT_INDEX                      14
-    #define COUNT_INDEX                         16
-    #define CHECKSUM_INDEX                      18
+    #if ENABLE_32_BIT_BURST_MODE
+      /* 32-bit Burst message definition (MSC_CTRL BURST_SIZE = 1, ADIS16475/ADIS16477 only). Low word first */
+      #define BURST_BYTE_LENGTH                 32
+      #define STATUS_INDEX                      0
+      #define XG_INDEX                          2
+      #define YG_INDEX                          6
+      #define ZG_INDEX                          10
+      #define XA_INDEX                          14
+      #define YA_INDEX                          18
+      #define ZA_INDEX                          22
+      #define TEMP_OUT_INDEX                    26
+      #define COUNT_INDEX                       28
+      #define CHECKSUM_INDEX                    30
+
+      /* Burst payload layout, X(field, byte index, decoder). The checksum word follows the last field */
+      #define BURST_LAYOUT(X)                   X(status,       STATUS_INDEX,   BURST_U16) \
+                                                X(xg,           XG_INDEX,       BURST_S32) \
+                                                X(yg,           YG_INDEX,       BURST_S32) \
+                                                X(zg,           ZG_INDEX,       BURST_S32) \
+                                                X(xa,           XA_INDEX,       BURST_S32) \
+                                                X(ya,           YA_INDEX,       BURST_S32) \
+                                                X(za,           ZA_INDEX,       BURST_S32) \
+                                                X(temperature,  TEMP_OUT_INDEX, BURST_S16) \
+                                                X(count,        COUNT_INDEX,    BURST_U16)
+
+      /* 16-bit burst of the members without a 32-bit burst (ADIS16470). The inertial fields are widened to 32-bit
+         LSBs so the samples of every member share the 32-bit scale factors */
+      #define BURST_NARROW_BYTE_LENGTH          20
+      #define BURST_NARROW_CHECKSUM_INDEX       18
+      #define BURST_LAYOUT_NARROW(X)            X(status,       0,              BURST_U16) \
+                                                X(xg,           2,              BURST_S16_WIDE) \
+                                                X(yg,           4,              BURST_S16_WIDE) \
+                                                X(zg,           6,              BURST_S16_WIDE) \
+                                                X(xa,           8,              BURST_S16_WIDE) \
+                                                X(ya,           10,             BURST_S16_WIDE) \
+                                                X(za,           12,             BURST_S16_WIDE) \
+                                                X(temperature,  14,             BURST_S16) \
+                                                X(count,        16,             BURST_U16)
+    #else
+      /* 16-bit Burst message definition */
+      #define BURST_BYTE_LENGTH                 20
+      #define STATUS_INDEX                      0
+      #define XG_INDEX                          2
+      #define YG_INDEX                          4
+      #define ZG_INDEX                          6
+      #define XA_INDEX                          8
+      #define YA_INDEX                          10
+      #define ZA_INDEX                          12
+      #define TEMP_OUT_INDEX                    14
+      #define COUNT_INDEX                       16
+      #define CHECKSUM_INDEX                    18
+
+      /* Burst payload layout, X(field, byte index, decoder). The checksum word follows the last field */
+      #define BURST_LAYOUT(X)                   X(status,       STATUS_INDEX,   BURST_U16) \
+                                                X(xg,           XG_INDEX,       BURST_S16) \
+                                                X(yg,           YG_INDEX,       BURST_S16) \
+                                                X(zg,           ZG_INDEX,       BURST_S16) \
+                                                X(xa,           XA_INDEX,       BURST_S16) \
+                                                X(ya,           YA_INDEX,       BURST_S16) \
+                                                X(za,           ZA_INDEX,       BURST_S16) \
+                                                X(temperature,  TEMP_OUT_INDEX, BURST_S16) \
+                                                X(count,        COUNT_INDEX,    BURST_U16)
+    #endif
+  #endif
+#endif
+
+/* Register-read data layouts used when burst mode is disabled, X(field, register, decoder). REG_S32 fields read
+   the *_LOW register and the *_OUT register above it, low word first */
+#if SUPPORTS_INERTIAL_DATA
+  #define REGREAD_LAYOUT_16(X)                  X(status,       DIAG_STAT,      REG_U16) \
+                                                X(xg,           X_GYRO_OUT,     REG_S16) \
+                                                X(yg,           Y_GYRO_OUT,     REG_S16) \
+                                                X(zg,           Z_GYRO_OUT,     REG_S16) \
+                                                X(xa,           X_ACCL_OUT,     REG_S16) \
+                                                X(ya,           Y_ACCL_OUT,     REG_S16) \
+                                                X(za,           Z_ACCL_OUT,     REG_S16) \
+                                                X(temperature,  TEMP_OUT,       REG_S16) \
+                                                X(count,        DATA_CNTR,      REG_U16)
+  #define REGREAD_LAYOUT_32(X)                  X(status,       DIAG_STAT,      REG_U16) \
+                                                X(xg,           X_GYRO_LOW,     REG_S32) \
+                                                X(yg,           Y_GYRO_LOW,     REG_S32) \
+                                                X(zg,           Z_GYRO_LOW,     REG_S32) \
+                                                X(xa,           X_ACCL_LOW,     REG_S32) \
+                                                X(ya,           Y_ACCL_LOW,     REG_S32) \
+                                                X(za,           Z_ACCL_LOW,     REG_S32) \
+                                                X(temperature,  TEMP_OUT,       REG_S16) \
+                                                X(count,        DATA_CNTR,      REG_U16)
+  #if SUPPORTS_DELTA_DATA
+    /* Delta angle and delta velocity outputs, read into the gyroscope and accelerometer fields */
+    #define REGREAD_LAYOUT_DELTA_16(X)          X(status,       DIAG_STAT,      REG_U16) \
+                                                X(xg,           X_DELTANG_OUT,  REG_S16) \
+                                                X(yg,           Y_DELTANG_OUT,  REG_S16) \
+                                                X(zg,           Z_DELTANG_OUT,  REG_S16) \
+                                                X(xa,           X_DELTVEL_OUT,  REG_S16) \
+                                                X(ya,           Y_DELTVEL_OUT,  REG_S16) \
+                                                X(za,           Z_DELTVEL_OUT,  REG_S16) \
+                                                X(temperature,  TEMP_OUT,       REG_S16) \
+                                                X(count,        DATA_CNTR,      REG_U16)
+    #define REGREAD_LAYOUT_DELTA_32(X)          X(status,       DIAG_STAT,      REG_U16) \
+                                                X(xg,           X_DELTANG_LOW,  REG_S32) \
+                                                X(yg,           Y_DELTANG_LOW,  REG_S32) \
+                                                X(zg,           Z_DELTANG_LOW,  REG_S32) \
+                                                X(xa,           X_DELTVEL_LOW,  REG_S32) \
+                                                X(ya,           Y_DELTVEL_LOW,  REG_S32) \
+                                                X(za,           Z_DELTVEL_LOW,  REG_S32) \
+                                                X(temperature,  TEMP_OUT,       REG_S16) \
+                                                X(count,        DATA_CNTR,      REG_U16)
   #endif
 #endif
 
+/* Register shadow cache policies, X(register, policy). Registers not listed are volatile and never cached */
+#if ENABLE_REG_CACHE
+  #define REG_CACHE_TABLE(X)                    X(PROD_ID,      CACHE_IMMUTABLE) \
+                                                X(FIRM_REV,     CACHE_IMMUTABLE) \
+                                                X(FIRM_DM,      CACHE_IMMUTABLE) \
+                                                X(FIRM_Y,       CACHE_IMMUTABLE) \
+                                                X(SERIAL_NUM,   CACHE_IMMUTABLE) \
+                                                X(RANG_MDL,     CACHE_IMMUTABLE) \
+                                                X(FILT_CTRL,    CACHE_WRITE_THROUGH) \
+                                                X(MSC_CTRL,     CACHE_WRITE_THROUGH) \
+                                                X(UP_SCALE,     CACHE_WRITE_THROUGH) \
+                                                X(DEC_RATE,     CACHE_WRITE_THROUGH) \
+                                                X(NULL_CFG,     CACHE_WRITE_THROUGH)
+#endif
+
 /* Misc. control register bit definitions */
+#define BITP_MISC_CTRL_REG_BURST_SIZE           9
+#define BITP_MISC_CTRL_REG_BURST_SEL            8
 #define BITP_MISC_CTRL_REG_LIN_G_COMP           7
 #define BITP_MISC_CTRL_REG_POP_COMP             6
 #define BITP_MISC_CTRL_REG_SYNC_FUNCTION        2
 #define BITP_MISC_CTRL_REG_SYNC_POLARITY        1
 #define BITP_MISC_CTRL_REG_DR_POLARITY          0
+#define BITM_MISC_CTRL_REG_BURST_SIZE           (1 << BITP_MISC_CTRL_REG_BURST_SIZE)
+#define BITM_MISC_CTRL_REG_BURST_SEL            (1 << BITP_MISC_CTRL_REG_BURST_SEL)
 #define BITM_MISC_CTRL_REG_LIN_G_COMP           (1 << BITP_MISC_CTRL_REG_LIN_G_COMP)
 #define BITM_MISC_CTRL_REG_POP_COMP             (1 << BITP_MISC_CTRL_REG_POP_COMP)
 #define BITM_MISC_CTRL_REG_SYNC_FUNCTION        (7 << BITP_MISC_CTRL_REG_SYNC_FUNCTION)
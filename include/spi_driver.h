@@ -12,7 +12,9 @@
 #include "adi_imu_conf.h"
 
 /** 
- * @brief Gets the active IMU page if the IMU supports it.
+ * @brief Performs a blocking SPI transfer.
+ * 
+ * @param csPin The chip select of the target IMU.
  * 
  * @param txBuf The BYTE array to be transmitted.
  * 
@@ -29,7 +31,57 @@
  * This function provides an interface between the SPI hardware and the IMU library. This function must be implemented
  * exactly as described for the library to work properly!
  **/
-adi_imu_Status spi_Transfer(uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime);
+adi_imu_Status spi_Transfer(uint8_t csPin, uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime);
+
+/** 
+ * @brief Starts a non-blocking SPI transfer.
+ * 
+ * @param xfer The transfer descriptor. csPin, txBuf, rxBuf, xferLen, wordLen and stallTime follow the same rules
+ * as spi_Transfer().
+ * 
+ * @return A status code indicating whether the transfer was accepted.
+ * 
+ * This function is only required when ENABLE_ASYNC_SPI is set. It must queue the transfer (e.g. on a DMA
+ * channel) and return immediately. Once the last word has been received, the implementation must call
+ * adi_imu_CompleteTransfer() exactly once with the transfer result. The descriptor and both buffers belong to
+ * the transport until then.
+ **/
+adi_imu_Status spi_TransferAsync(adi_imu_SpiXfer *xfer);
+
+/** 
+ * @brief Waits for a transport event.
+ * 
+ * This function is only required when ENABLE_ASYNC_SPI is set. The library calls it in a loop while it waits
+ * for an asynchronous transfer to complete. It may return immediately or sleep until the next interrupt
+ * (e.g. __WFI()), but it must not block past the completion of a queued transfer.
+ **/
+void spi_WaitEvent(void);
+
+/* Data-ready interrupt handler signature */
+typedef void (*adi_imu_DataReadyHandler)(void *context);
+
+/** 
+ * @brief Attaches a handler to the IMU data-ready signal.
+ * 
+ * @param csPin The chip select of the IMU, identifying which device the data-ready signal belongs to.
+ * 
+ * @param drPin The IMU GPIO configured as the data-ready output.
+ * 
+ * @param edge The signal edge which indicates that new data is available.
+ * 
+ * @param handler The function to be called on every data-ready edge.
+ * 
+ * @param context An opaque pointer passed back to the handler.
+ * 
+ * @return A status code indicating the success of the subroutine.
+ * 
+ * This function must route the host pin wired to drPin of the IMU selected by csPin to an edge-triggered interrupt (or, on a
+ * host without hardware, a software ticker) which calls handler(context) on every requested edge.
+ **/
+adi_imu_Status gpio_AttachDataReady(uint8_t csPin, adi_imu_DatRdyGPIO drPin, adi_imu_EdgeType edge, adi_imu_DataReadyHandler handler, void *context);
+
+/* Detach the data-ready handler and disable the interrupt */
+void gpio_DetachDataReady(uint8_t csPin, adi_imu_DatRdyGPIO drPin);
 
 /* Generic microsecond delay function */
 void delay_US(uint32_t microseconds);
@@ -37,4 +89,24 @@ void delay_US(uint32_t microseconds);
 /* Generic millisecond delay function */
 void delay_MS(uint32_t milliseconds);
 
+/** 
+ * @brief Reads a free-running cycle counter.
+ * 
+ * @return The current counter value. Must increase monotonically and may wrap at 2^32.
+ * 
+ * This function is only required when ENABLE_INSTRUMENTATION is set. Any tick rate works (e.g. the Cortex-M
+ * DWT_CYCCNT register); durations are reported in the same ticks.
+ **/
+uint32_t timer_GetCycles(void);
+
+/** 
+ * @brief Reads a free-running host clock.
+ * 
+ * @return The current time in nanoseconds. Must increase monotonically and must not wrap.
+ * 
+ * This function is only required when ENABLE_TIMESTAMPS is set. It is called from the data-ready handler, so
+ * it must be short and interrupt safe. Sample timestamps are reported on this clock.
+ **/
+uint64_t timer_GetNanos(void);
+
 #endif
\ No newline at end of file
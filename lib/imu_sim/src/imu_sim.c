@@ -0,0 +1,1208 @@
+/**
+  * @file		  imu_sim.c
+  * @date		  10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Host-side ADIS1647X and ADCMXL3021 simulator implementing the spi_driver.h contract.
+ **/
+
+#include "imu_sim.h"
+
+#if ADIS1647X
+    /* A single register page, PAGE_ID does not exist */
+    #define IMU_SIM_NUM_PAGES           1
+    #define IMU_SIM_DEFAULT_CFG         { 16475, 0x000C, 0x0001 }
+#elif ADCMXL3021
+    /* Page 0 holds the user registers, pages 1 to FIR_BANK_COUNT the FIR coefficient banks */
+    #define IMU_SIM_NUM_PAGES           (FIR_BANK_COUNT + 1)
+    #define IMU_SIM_DEFAULT_CFG         { 3021, 0x0000, 0x0001 }
+#else
+    #error "The IMU simulator only models the ADIS1647X and ADCMXL3021 families"
+#endif
+
+/* Register file size in 16-bit words */
+#define IMU_SIM_PAGE_REGS               64
+#define IMU_SIM_NUM_REGS                (IMU_SIM_NUM_PAGES * IMU_SIM_PAGE_REGS)
+
+/* Register file helpers. SIM_REG takes a byte address on the active page, SIM_PAGE_INDEX and SIM_PAGE_REG a
+   register location with the page in [15:8], as in the family register maps */
+#define SIM_REG(dev, addr)              ((dev)->regs[(dev)->page * IMU_SIM_PAGE_REGS + (((addr) & 0x7E) >> 1)])
+#define SIM_PAGE_INDEX(pageAddr)        ((((pageAddr) >> 8) & 0xFF) * IMU_SIM_PAGE_REGS + (((pageAddr) & 0x7E) >> 1))
+#define SIM_PAGE_REG(dev, pageAddr)     ((dev)->regs[SIM_PAGE_INDEX(pageAddr)])
+
+/* Simulated IMU state */
+typedef struct {
+    uint16_t regs[IMU_SIM_NUM_REGS];        /* Live register file */
+    uint16_t flash[IMU_SIM_NUM_REGS];       /* Register values restored on reset */
+    uint16_t response;                      /* Response to the last read command, clocked out by the next frame */
+    uint8_t page;                           /* Active register page */
+    adi_imu_Boolean selected;               /* lastCsNs holds a value */
+    uint64_t lastCsNs;                      /* Time of the last CS deassertion */
+    uint64_t busyUntilNs;                   /* End of the command being executed */
+    uint64_t nextSampleNs;                  /* Time of the next data-ready edge */
+    uint64_t sampleNs;                      /* Time the output registers were last updated */
+    uint32_t sampleIndex;
+    imu_sim_Sample sample;
+    imu_sim_SampleSource source;
+    void *sourceContext;
+    adi_imu_DataReadyHandler drHandler;
+    void *drContext;
+    uint32_t pendingEdges;                  /* Data-ready edges not yet delivered to drHandler */
+    uint16_t corruptIndex;
+    uint8_t corruptMask;
+#if SUPPORTS_CAPTURE
+    adi_imu_Boolean capturing;              /* A capture command is collecting samples */
+    uint16_t captureSamples;                /* Samples collected by the running capture */
+    uint16_t record;                        /* Record loaded in the capture buffers */
+#endif
+    uint16_t *trace;                        /* Caller buffer of imu_sim_StartTrace(), or NULL */
+    uint16_t traceCapacity;
+    uint16_t traceLength;
+    imu_sim_Stats stats;
+} imu_sim_Device;
+
+/* Transfer queued by spi_TransferAsync() in deferred mode. The data is exchanged on submission, at the time
+   the transfer gets the bus, and the completion is delivered once the virtual clock reaches doneNs */
+typedef struct {
+    adi_imu_SpiXfer *xfer;
+    adi_imu_Status status;
+    uint64_t doneNs;
+} imu_sim_AsyncXfer;
+
+static imu_sim_Device imu_sim_Devices[IMU_SIM_MAX_DEVICES];
+static imu_sim_AsyncXfer imu_sim_AsyncQueue[IMU_SIM_ASYNC_QUEUE_DEPTH];
+static uint8_t imu_sim_AsyncHead = 0;
+static uint8_t imu_sim_AsyncCount = 0;
+static adi_imu_Boolean imu_sim_AsyncDeferred = FALSE;
+static uint32_t imu_sim_AsyncLatencyNs = 0;
+static uint64_t imu_sim_BusFreeNs = 0;
+static const imu_sim_Config imu_sim_DefaultCfg = IMU_SIM_DEFAULT_CFG;
+static imu_sim_Config imu_sim_Cfg = IMU_SIM_DEFAULT_CFG;
+static uint64_t imu_sim_NowNs = 0;
+static uint32_t imu_sim_SclkHz = 1000000;
+static uint32_t imu_sim_OverheadNs = 0;
+static uint8_t imu_sim_CommandPct = 100;
+static int32_t imu_sim_HostErrorPpb = 0;
+static uint32_t imu_sim_IrqLatencyNs = 0;
+static uint32_t imu_sim_IrqSeed = 1;
+static adi_imu_Boolean imu_sim_Initialized = FALSE;
+
+/**
+ * @brief Default sample generator. Produces deterministic pseudo-random data.
+ **/
+static void imu_sim_DefaultSource(uint8_t csPin, uint32_t index, imu_sim_Sample *sample, void *context)
+{
+    uint32_t x = (index * 2654435761u) ^ ((uint32_t) csPin << 24) ^ 0x9E3779B9u;
+
+    (void) context;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        sample->gyro[i] = (int32_t) (x & 0x00FFFFFF) - 0x00800000;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        sample->accel[i] = (int32_t) (x & 0x00FFFFFF) - 0x00800000;
+        sample->deltaAngle[i] = sample->gyro[i] / 4;
+        sample->deltaVelocity[i] = sample->accel[i] / 4;
+    }
+    sample->temperature = (int16_t) (250 + (index & 0x7));
+}
+
+/**
+ * @brief Gets the simulated IMU selected by a chip select.
+ **/
+static imu_sim_Device *imu_sim_GetDevice(uint8_t csPin)
+{
+    if (!imu_sim_Initialized)
+    {
+        imu_sim_Reset(0);
+    }
+    if (csPin >= IMU_SIM_MAX_DEVICES)
+    {
+        return 0;
+    }
+
+    return &imu_sim_Devices[csPin];
+}
+
+/* Reloads the register file from flash, used by the family register models */
+static void imu_sim_Restart(imu_sim_Device *dev);
+
+#if ADIS1647X
+
+/**
+ * @brief Data-ready period for the current DEC_RATE, in nanoseconds.
+ **/
+static uint64_t imu_sim_SamplePeriod(const imu_sim_Device *dev)
+{
+    return ((uint64_t) SIM_REG(dev, DEC_RATE) + 1) * (1000000000ULL / IMU_SIM_BASE_RATE);
+}
+
+/**
+ * @brief Sync input period implied by UP_SCALE, in nanoseconds.
+ **/
+static uint64_t imu_sim_SyncPeriod(const imu_sim_Device *dev)
+{
+    uint16_t upScale = SIM_REG(dev, UP_SCALE);
+
+    return ((upScale > 0) ? upScale : 1) * (1000000000ULL / IMU_SIM_BASE_RATE);
+}
+
+/**
+ * @brief Writes a 32-bit output into its LOW/OUT register pair.
+ **/
+static void imu_sim_SetReg32(imu_sim_Device *dev, uint8_t lowAddr, int32_t val)
+{
+    SIM_REG(dev, lowAddr) = (uint16_t) ((uint32_t) val & 0xFFFF);
+    SIM_REG(dev, lowAddr + 2) = (uint16_t) ((uint32_t) val >> 16);
+}
+
+/**
+ * @brief Restores the power-on register values.
+ **/
+static void imu_sim_LoadDefaults(imu_sim_Device *dev)
+{
+    for (uint8_t i = 0; i < IMU_SIM_NUM_REGS; i++)
+    {
+        dev->flash[i] = 0;
+    }
+    dev->flash[FILT_CTRL >> 1] = 0x0000;
+    dev->flash[RANG_MDL >> 1] = imu_sim_Cfg.rangMdl;
+    dev->flash[MSC_CTRL >> 1] = 0x00C1;
+    dev->flash[UP_SCALE >> 1] = 0x07D0;
+    dev->flash[DEC_RATE >> 1] = 0x0000;
+    dev->flash[NULL_CFG >> 1] = 0x070A;
+    dev->flash[FIRM_REV >> 1] = 0x0102;
+    dev->flash[FIRM_DM >> 1] = 0x1020;
+    dev->flash[FIRM_Y >> 1] = 0x2020;
+    dev->flash[PROD_ID >> 1] = imu_sim_Cfg.prodId;
+    dev->flash[SERIAL_NUM >> 1] = imu_sim_Cfg.serialNum;
+}
+
+/**
+ * @brief Updates the output registers with a new sample.
+ **/
+static void imu_sim_NewSample(imu_sim_Device *dev, uint8_t csPin)
+{
+    dev->source(csPin, dev->sampleIndex++, &dev->sample, dev->sourceContext);
+    imu_sim_SetReg32(dev, X_GYRO_LOW, dev->sample.gyro[0]);
+    imu_sim_SetReg32(dev, Y_GYRO_LOW, dev->sample.gyro[1]);
+    imu_sim_SetReg32(dev, Z_GYRO_LOW, dev->sample.gyro[2]);
+    imu_sim_SetReg32(dev, X_ACCL_LOW, dev->sample.accel[0]);
+    imu_sim_SetReg32(dev, Y_ACCL_LOW, dev->sample.accel[1]);
+    imu_sim_SetReg32(dev, Z_ACCL_LOW, dev->sample.accel[2]);
+    imu_sim_SetReg32(dev, X_DELTANG_LOW, dev->sample.deltaAngle[0]);
+    imu_sim_SetReg32(dev, Y_DELTANG_LOW, dev->sample.deltaAngle[1]);
+    imu_sim_SetReg32(dev, Z_DELTANG_LOW, dev->sample.deltaAngle[2]);
+    imu_sim_SetReg32(dev, X_DELTVEL_LOW, dev->sample.deltaVelocity[0]);
+    imu_sim_SetReg32(dev, Y_DELTVEL_LOW, dev->sample.deltaVelocity[1]);
+    imu_sim_SetReg32(dev, Z_DELTVEL_LOW, dev->sample.deltaVelocity[2]);
+    SIM_REG(dev, TEMP_OUT) = (uint16_t) dev->sample.temperature;
+    SIM_REG(dev, DATA_CNTR)++;
+    dev->sampleNs = dev->nextSampleNs;
+    /* The sync input is modeled as pulses at whole multiples of its period since imu_sim_Reset() */
+    SIM_REG(dev, TIME_STAMP) = (uint16_t) ((dev->sampleNs % imu_sim_SyncPeriod(dev)) / TIME_STAMP_LSB_NS);
+    dev->stats.samples++;
+    if (dev->drHandler)
+    {
+        dev->pendingEdges++;
+    }
+}
+
+/**
+ * @brief Executes the command bits written to GLOB_CMD.
+ **/
+static void imu_sim_Command(imu_sim_Device *dev, uint8_t cmd)
+{
+    uint32_t busyMs = 0;
+
+    if (cmd & BITM_COMMAND_REG_SOFTWARE_RST)
+    {
+        imu_sim_Restart(dev);
+        busyMs = RESET_RECOVERY_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_FLASH_MEM_UPD)
+    {
+        for (uint8_t i = 0; i < IMU_SIM_NUM_REGS; i++)
+        {
+            dev->flash[i] = dev->regs[i];
+        }
+        dev->flash[GLOB_CMD >> 1] = 0;
+        busyMs = FLASH_MEMORY_BACKUP_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_FLASH_MEM_TEST)
+    {
+        busyMs = FLASH_MEMORY_TEST_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_SELF_TEST)
+    {
+        busyMs = SELF_TEST_TIME_MS;
+    }
+    /* Command bits clear themselves */
+    SIM_REG(dev, GLOB_CMD) = 0;
+    dev->busyUntilNs = imu_sim_NowNs + (uint64_t) busyMs * 10000ULL * imu_sim_CommandPct;
+}
+
+/**
+ * @brief Applies a single byte write.
+ **/
+static void imu_sim_WriteByte(imu_sim_Device *dev, uint8_t addr, uint8_t val)
+{
+    uint8_t wordAddr = (addr & 0x7E);
+    uint16_t *reg = &SIM_REG(dev, addr);
+
+    /* Only the user configuration registers are writable */
+    if (!(((wordAddr >= XG_BIAS_LOW) && (wordAddr <= ZA_BIAS_HIGH)) ||
+          (wordAddr == FILT_CTRL) ||
+          ((wordAddr >= MSC_CTRL) && (wordAddr <= GLOB_CMD)) ||
+          ((wordAddr >= USER_SCR1) && (wordAddr <= USER_SCR3))))
+    {
+        return;
+    }
+    if (addr & 0x01)
+    {
+        *reg = (uint16_t) ((*reg & 0x00FF) | ((uint16_t) val << 8));
+    }
+    else
+    {
+        *reg = (uint16_t) ((*reg & 0xFF00) | val);
+        if (wordAddr == GLOB_CMD)
+        {
+            imu_sim_Command(dev, val);
+        }
+    }
+    /* The ADIS16470 has neither BURST_SIZE nor BURST_SEL, those MSC_CTRL bits always read back as zero */
+    if ((wordAddr == MSC_CTRL) && (imu_sim_Cfg.prodId == 16470))
+    {
+        *reg &= (uint16_t) ~(BITM_MISC_CTRL_REG_BURST_SIZE | BITM_MISC_CTRL_REG_BURST_SEL);
+    }
+}
+
+/**
+ * @brief Serves a burst read. The first word of the CS assertion has already been clocked.
+ **/
+static void imu_sim_Burst(imu_sim_Device *dev, uint8_t *rxBuf, uint16_t len)
+{
+    uint16_t words[16];
+    uint16_t numWords = 0;
+    uint16_t mscCtrl = SIM_REG(dev, MSC_CTRL);
+    uint8_t firstOut = (mscCtrl & BITM_MISC_CTRL_REG_BURST_SEL) ? X_DELTANG_LOW : X_GYRO_LOW;
+    adi_imu_Boolean wide = ((mscCtrl & BITM_MISC_CTRL_REG_BURST_SIZE) && (imu_sim_Cfg.prodId != 16470)) ? TRUE : FALSE;
+    uint16_t checksum = 0;
+    uint64_t age = imu_sim_NowNs - dev->sampleNs;
+
+    words[numWords++] = SIM_REG(dev, DIAG_STAT);
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        uint8_t lowAddr = firstOut + 4 * i;
+
+        if (wide)
+        {
+            words[numWords++] = SIM_REG(dev, lowAddr);
+        }
+        words[numWords++] = SIM_REG(dev, lowAddr + 2);
+    }
+    words[numWords++] = SIM_REG(dev, TEMP_OUT);
+    if (((mscCtrl & BITM_MISC_CTRL_REG_SYNC_FUNCTION) >> BITP_MISC_CTRL_REG_SYNC_FUNCTION) == SYNC_SCALED)
+    {
+        words[numWords++] = SIM_REG(dev, TIME_STAMP);
+    }
+    else
+    {
+        words[numWords++] = SIM_REG(dev, DATA_CNTR);
+    }
+    for (uint16_t i = 0; i < numWords; i++)
+    {
+        checksum += (words[i] >> 8) + (words[i] & 0xFF);
+    }
+    words[numWords++] = checksum;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint16_t word = ((i / 2) < numWords) ? words[i / 2] : 0;
+
+        rxBuf[i] = (i & 1) ? (word & 0xFF) : (word >> 8);
+    }
+    if (dev->corruptMask && (dev->corruptIndex < len))
+    {
+        rxBuf[dev->corruptIndex] ^= dev->corruptMask;
+        dev->corruptMask = 0;
+    }
+
+    dev->response = IMU_SIM_NO_RESPONSE;
+    dev->stats.bursts++;
+    dev->stats.latencyNsTotal += age;
+    if (age > dev->stats.latencyNsMax)
+    {
+        dev->stats.latencyNsMax = age;
+    }
+    if (imu_sim_SclkHz > IMU_SIM_MAX_BURST_SCLK)
+    {
+        dev->stats.sclkViolations++;
+    }
+}
+
+/**
+ * @brief Serves a register read command.
+ **/
+static uint16_t imu_sim_ReadReg(imu_sim_Device *dev, uint8_t csPin, uint8_t addr)
+{
+    (void) csPin;
+
+    return SIM_REG(dev, addr);
+}
+
+#elif ADCMXL3021
+
+/**
+ * @brief Sample period for the current AVG_CNT, in nanoseconds.
+ **/
+static uint64_t imu_sim_SamplePeriod(const imu_sim_Device *dev)
+{
+    return ((uint64_t) 1 << (SIM_PAGE_REG(dev, REG_AVG_CNT) & 0x7)) * (1000000000ULL / IMU_SIM_BASE_RATE);
+}
+
+/**
+ * @brief Capture buffer entries per axis in the record mode set in REC_CTRL.
+ **/
+static uint16_t imu_sim_CaptureLength(const imu_sim_Device *dev)
+{
+    uint16_t mode = (SIM_PAGE_REG(dev, REG_REC_CTRL) & BITM_REC_CTRL_REG_MODE) >> BITP_REC_CTRL_REG_MODE;
+
+    return ((mode == REC_MODE_MANUAL_TIME) || (mode == REC_MODE_REAL_TIME)) ? CAPTURE_TIME_SAMPLES : CAPTURE_FFT_BINS;
+}
+
+/**
+ * @brief Restores the power-on register values. The FIR coefficient banks start out cleared.
+ **/
+static void imu_sim_LoadDefaults(imu_sim_Device *dev)
+{
+    for (uint16_t i = 0; i < IMU_SIM_NUM_REGS; i++)
+    {
+        dev->flash[i] = 0;
+    }
+    dev->flash[SIM_PAGE_INDEX(REG_REV_DAY)] = 0x1020;
+    dev->flash[SIM_PAGE_INDEX(REG_YEAR_MON)] = 0x2020;
+    dev->flash[SIM_PAGE_INDEX(REG_PROD_ID)] = imu_sim_Cfg.prodId;
+    dev->flash[SIM_PAGE_INDEX(REG_SERIAL_NUM)] = imu_sim_Cfg.serialNum;
+    dev->record = 0;
+}
+
+/**
+ * @brief Updates the output registers with a new sample and advances a running capture.
+ *
+ * A capture collects CAPTURE_TIME_SAMPLES samples in every record mode, then stores the record, loads it into
+ * the capture buffers and increments REC_CNTR. Automatic and real-time modes are modeled as one record per
+ * capture command.
+ **/
+static void imu_sim_NewSample(imu_sim_Device *dev, uint8_t csPin)
+{
+    dev->source(csPin, dev->sampleIndex++, &dev->sample, dev->sourceContext);
+    SIM_PAGE_REG(dev, REG_TEMP_OUT) = (uint16_t) dev->sample.temperature;
+    dev->sampleNs = dev->nextSampleNs;
+    dev->stats.samples++;
+    if (dev->capturing && (++dev->captureSamples >= CAPTURE_TIME_SAMPLES))
+    {
+        dev->capturing = FALSE;
+        dev->record = SIM_PAGE_REG(dev, REG_REC_CNTR)++;
+        SIM_PAGE_REG(dev, REG_BUF_PNTR) = 0;
+    }
+    if (dev->drHandler)
+    {
+        dev->pendingEdges++;
+    }
+}
+
+/**
+ * @brief Executes the command bits written to GLOB_CMD.
+ *
+ * The capture command does not hold the bus, so REC_CNTR can be polled while the record is collected.
+ **/
+static void imu_sim_Command(imu_sim_Device *dev, uint16_t cmd)
+{
+    uint32_t busyMs = 0;
+
+    if (cmd & BITM_COMMAND_REG_SOFTWARE_RST)
+    {
+        imu_sim_Restart(dev);
+        busyMs = RESET_RECOVERY_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_FACTORY_RESTORE)
+    {
+        imu_sim_LoadDefaults(dev);
+        imu_sim_Restart(dev);
+        busyMs = FACTORY_CAL_RESTORE_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_FLASH_MEM_UPD)
+    {
+        for (uint16_t i = 0; i < IMU_SIM_NUM_REGS; i++)
+        {
+            dev->flash[i] = dev->regs[i];
+        }
+        dev->flash[SIM_PAGE_INDEX(REG_GLOB_CMD)] = 0;
+        busyMs = FLASH_MEMORY_BACKUP_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_FLASH_MEM_TEST)
+    {
+        busyMs = FLASH_MEMORY_TEST_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_SELF_TEST)
+    {
+        busyMs = SELF_TEST_TIME_MS;
+    }
+    else if (cmd & BITM_COMMAND_REG_CAPTURE)
+    {
+        dev->capturing = TRUE;
+        dev->captureSamples = 0;
+    }
+    /* Command bits clear themselves */
+    SIM_PAGE_REG(dev, REG_GLOB_CMD) = 0;
+    dev->busyUntilNs = imu_sim_NowNs + (uint64_t) busyMs * 10000ULL * imu_sim_CommandPct;
+}
+
+/**
+ * @brief Applies a single byte write.
+ *
+ * PAGE_ID is mapped on every page. Commands and record loads act once the upper byte has been written.
+ **/
+static void imu_sim_WriteByte(imu_sim_Device *dev, uint8_t addr, uint8_t val)
+{
+    uint8_t wordAddr = (addr & 0x7E);
+    uint16_t *reg = &SIM_REG(dev, addr);
+
+    if (wordAddr == (REG_PAGE_ID & 0xFF))
+    {
+        /* Pages beyond the FIR banks are not modeled and ignore the write */
+        if (!(addr & 0x01))
+        {
+            dev->stats.pageWrites++;
+            dev->page = (val < IMU_SIM_NUM_PAGES) ? val : dev->page;
+        }
+        return;
+    }
+    /* Only the user configuration registers and the FIR coefficients are writable */
+    if ((dev->page == 0) ? !(((wordAddr >= REG_BUF_PNTR) && (wordAddr <= REG_REC_PNTR)) ||
+                             ((wordAddr >= REG_X_ANULL) && (wordAddr <= REG_AVG_CNT)) ||
+                             (wordAddr == REG_GLOB_CMD) ||
+                             (wordAddr == REG_USER_SCRATCH) ||
+                             (wordAddr == REG_MISC_CTRL))
+                         : (wordAddr > (FIR_COEF_REG(0, FIR_BANK_TAPS - 1) & 0xFF)))
+    {
+        return;
+    }
+    if (!(addr & 0x01))
+    {
+        *reg = (uint16_t) ((*reg & 0xFF00) | val);
+        return;
+    }
+    *reg = (uint16_t) ((*reg & 0x00FF) | ((uint16_t) val << 8));
+    if ((dev->page == 0) && (wordAddr == REG_GLOB_CMD))
+    {
+        imu_sim_Command(dev, *reg);
+    }
+    else if ((dev->page == 0) && (wordAddr == REG_REC_PNTR) && (*reg < SIM_PAGE_REG(dev, REG_REC_CNTR)))
+    {
+        dev->record = *reg;
+    }
+}
+
+/**
+ * @brief Gets the content of a stored capture record.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @param record The index of the record, as counted by REC_CNTR.
+ *
+ * @param axis The capture axis, 0 to CAPTURE_AXES - 1.
+ *
+ * @param index The buffer entry.
+ *
+ * @return The entry which reading the axis buffer register returns once the record is loaded.
+ *
+ * Records are deterministic pseudo-random data, so they need not be stored.
+ **/
+uint16_t imu_sim_CaptureSample(uint8_t csPin, uint16_t record, uint8_t axis, uint16_t index)
+{
+    uint32_t x = ((uint32_t) record * 2654435761u) ^ ((uint32_t) csPin << 28) ^ ((uint32_t) axis << 24) ^ index ^ 0x9E3779B9u;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return (uint16_t) (x ^ (x >> 16));
+}
+
+/**
+ * @brief Serves a register read command.
+ *
+ * Every read of an axis buffer register returns the entry at BUF_PNTR and advances it. The buffers read as
+ * zero until the first capture.
+ **/
+static uint16_t imu_sim_ReadReg(imu_sim_Device *dev, uint8_t csPin, uint8_t addr)
+{
+    uint8_t wordAddr = (addr & 0x7E);
+    uint16_t *bufPntr = &SIM_PAGE_REG(dev, REG_BUF_PNTR);
+    uint16_t val;
+
+    if (wordAddr == (REG_PAGE_ID & 0xFF))
+    {
+        return dev->page;
+    }
+    if ((dev->page != 0) || (wordAddr < REG_X_BUF) || (wordAddr >= REG_X_BUF + 2 * CAPTURE_AXES))
+    {
+        return SIM_REG(dev, addr);
+    }
+    val = (SIM_PAGE_REG(dev, REG_REC_CNTR) > 0) ? imu_sim_CaptureSample(csPin, dev->record, (wordAddr - REG_X_BUF) / 2, *bufPntr) : 0;
+    *bufPntr = (uint16_t) ((*bufPntr + 1) % imu_sim_CaptureLength(dev));
+
+    return val;
+}
+
+#endif
+
+/**
+ * @brief Reloads the register file from flash, as after a power cycle or software reset.
+ **/
+static void imu_sim_Restart(imu_sim_Device *dev)
+{
+    for (uint16_t i = 0; i < IMU_SIM_NUM_REGS; i++)
+    {
+        dev->regs[i] = dev->flash[i];
+    }
+    dev->response = IMU_SIM_NO_RESPONSE;
+    dev->page = 0;
+#if SUPPORTS_CAPTURE
+    dev->capturing = FALSE;
+#endif
+    dev->sampleIndex = 0;
+    dev->nextSampleNs = imu_sim_NowNs + imu_sim_SamplePeriod(dev);
+}
+
+/**
+ * @brief Generates every sample due at the current virtual time.
+ **/
+static void imu_sim_Tick(imu_sim_Device *dev, uint8_t csPin)
+{
+    while (dev->nextSampleNs <= imu_sim_NowNs)
+    {
+        imu_sim_NewSample(dev, csPin);
+        dev->nextSampleNs += imu_sim_SamplePeriod(dev);
+    }
+}
+
+/**
+ * @brief Checks whether a CS assertion is a burst read request.
+ **/
+static adi_imu_Boolean imu_sim_IsBurst(const uint8_t *txBuf, uint16_t len)
+{
+#if SUPPORTS_BURST
+    return ((len > 2) && (txBuf[0] == (COMMAND_REG & 0xFF)) && (txBuf[1] == 0x00)) ? TRUE : FALSE;
+#else
+    (void) txBuf;
+    (void) len;
+    return FALSE;
+#endif
+}
+
+/**
+ * @brief Clocks one CS assertion through a simulated IMU.
+ **/
+static void imu_sim_Select(imu_sim_Device *dev, uint8_t csPin, const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len)
+{
+    adi_imu_Boolean valid = TRUE;
+    adi_imu_Boolean burst = imu_sim_IsBurst(txBuf, len);
+
+    imu_sim_Tick(dev, csPin);
+    dev->stats.csAssertions++;
+    dev->stats.bytes += len;
+    if (dev->trace && (len >= 2) && (dev->traceLength < dev->traceCapacity))
+    {
+        dev->trace[dev->traceLength++] = (uint16_t) ((txBuf[0] << 8) | txBuf[1]);
+    }
+    if (dev->selected && ((imu_sim_NowNs - dev->lastCsNs) < IMU_SIM_STALL_NS))
+    {
+        dev->stats.stallViolations++;
+        valid = FALSE;
+    }
+    if (imu_sim_NowNs < dev->busyUntilNs)
+    {
+        dev->stats.busyViolations++;
+        valid = FALSE;
+    }
+
+    if (len >= 2)
+    {
+        /* Full duplex: the first word returns the response to the previous command */
+        rxBuf[0] = (dev->response >> 8);
+        rxBuf[1] = (dev->response & 0xFF);
+        if (!valid)
+        {
+            dev->response = IMU_SIM_NO_RESPONSE;
+        }
+        else if (burst)
+        {
+#if SUPPORTS_BURST
+            imu_sim_Burst(dev, &rxBuf[2], len - 2);
+#endif
+        }
+        else if (txBuf[0] & 0x80)
+        {
+            imu_sim_WriteByte(dev, txBuf[0] & 0x7F, txBuf[1]);
+            dev->response = IMU_SIM_NO_RESPONSE;
+        }
+        else
+        {
+            dev->response = imu_sim_ReadReg(dev, csPin, txBuf[0]);
+        }
+    }
+    /* Anything clocked after the first word of a register access is ignored by the IMU */
+    if (!(valid && burst))
+    {
+        for (uint16_t i = 2; i < len; i++)
+        {
+            rxBuf[i] = IMU_SIM_NO_RESPONSE & 0xFF;
+        }
+    }
+
+    imu_sim_NowNs += ((uint64_t) len * 8 * 1000000000ULL) / imu_sim_SclkHz;
+    dev->lastCsNs = imu_sim_NowNs;
+    dev->selected = TRUE;
+}
+
+/**
+ * @brief Resets every simulated IMU and the virtual clock.
+ *
+ * @param config The IMU configuration, or NULL for an ADIS16475-3 (an ADcmXL3021 in ADCMXL3021 builds).
+ *
+ * Statistics, sample sources and data-ready handlers are cleared as well. Queued asynchronous transfers are
+ * dropped without completing.
+ **/
+void imu_sim_Reset(const imu_sim_Config *config)
+{
+    imu_sim_Initialized = TRUE;
+    imu_sim_NowNs = 0;
+    imu_sim_BusFreeNs = 0;
+    imu_sim_AsyncHead = 0;
+    imu_sim_AsyncCount = 0;
+    imu_sim_Cfg = config ? *config : imu_sim_DefaultCfg;
+    for (uint8_t i = 0; i < IMU_SIM_MAX_DEVICES; i++)
+    {
+        imu_sim_Device *dev = &imu_sim_Devices[i];
+        imu_sim_Stats empty = { 0 };
+
+        dev->selected = FALSE;
+        dev->busyUntilNs = 0;
+        dev->source = imu_sim_DefaultSource;
+        dev->sourceContext = 0;
+        dev->drHandler = 0;
+        dev->drContext = 0;
+        dev->pendingEdges = 0;
+        dev->corruptMask = 0;
+        dev->trace = 0;
+        dev->stats = empty;
+        imu_sim_LoadDefaults(dev);
+        imu_sim_Restart(dev);
+    }
+}
+
+/**
+ * @brief Sets the simulated SCLK frequency.
+ *
+ * @param sclkHz The SCLK frequency in Hz. Bursts above IMU_SIM_MAX_BURST_SCLK are counted as violations.
+ **/
+void imu_sim_SetSclk(uint32_t sclkHz)
+{
+    imu_sim_SclkHz = (sclkHz > 0) ? sclkHz : 1;
+}
+
+/**
+ * @brief Sets a fixed host overhead added to every spi_Transfer call.
+ *
+ * @param overheadNs The overhead in nanoseconds, e.g. the driver setup time of the target SPI peripheral.
+ **/
+void imu_sim_SetTransferOverhead(uint32_t overheadNs)
+{
+    imu_sim_OverheadNs = overheadNs;
+}
+
+/**
+ * @brief Selects how spi_TransferAsync() completes.
+ *
+ * @param deferred FALSE completes every transfer before spi_TransferAsync() returns. TRUE queues it on the
+ * simulated bus: the caller gets control back immediately and the completion is delivered from
+ * imu_sim_Advance(), a delay call or spi_WaitEvent() once the transfer is off the wire.
+ *
+ * @param latencyNs The delay between the last word and the completion, e.g. the DMA interrupt latency.
+ * Only used in deferred mode.
+ **/
+void imu_sim_SetAsyncCompletion(adi_imu_Boolean deferred, uint32_t latencyNs)
+{
+    imu_sim_AsyncDeferred = deferred;
+    imu_sim_AsyncLatencyNs = latencyNs;
+}
+
+/**
+ * @brief Sets how long commands keep the simulated IMU busy.
+ *
+ * @param percent The execution time, in percent of the datasheet maximum. Real parts usually finish well
+ * before the limit.
+ **/
+void imu_sim_SetCommandTime(uint8_t percent)
+{
+    imu_sim_CommandPct = percent;
+}
+
+/**
+ * @brief Sets the rate error of the host clock read by timer_GetNanos().
+ *
+ * @param errorPpb The host clock error relative to the simulated IMUs, in ppb. Positive runs fast.
+ **/
+void imu_sim_SetHostClockError(int32_t errorPpb)
+{
+    imu_sim_HostErrorPpb = errorPpb;
+}
+
+/**
+ * @brief Sets the data-ready interrupt latency.
+ *
+ * @param maxNs Every data-ready handler call is delayed by a pseudo-random time between 0 and maxNs.
+ **/
+void imu_sim_SetIrqLatency(uint32_t maxNs)
+{
+    imu_sim_IrqLatencyNs = maxNs;
+    imu_sim_IrqSeed = 1;
+}
+
+/**
+ * @brief Replaces the default sample generator of one IMU.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @param source The sample generator, or NULL to restore the default pseudo-random data.
+ *
+ * @param context An opaque pointer passed back to the generator.
+ **/
+void imu_sim_SetSampleSource(uint8_t csPin, imu_sim_SampleSource source, void *context)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (dev)
+    {
+        dev->source = source ? source : imu_sim_DefaultSource;
+        dev->sourceContext = context;
+    }
+}
+
+/**
+ * @brief Flips bits in the next burst payload of one IMU, after the checksum has been computed.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @param byteIndex The payload byte to be corrupted, 0 being the first byte after the trigger word.
+ *
+ * @param xorMask The bits to be flipped.
+ **/
+void imu_sim_CorruptNextBurst(uint8_t csPin, uint16_t byteIndex, uint8_t xorMask)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (dev)
+    {
+        dev->corruptIndex = byteIndex;
+        dev->corruptMask = xorMask;
+    }
+}
+
+/**
+ * @brief Gets the virtual clock.
+ *
+ * @return The virtual time since imu_sim_Reset(), in nanoseconds.
+ **/
+uint64_t imu_sim_Now(void)
+{
+    return imu_sim_NowNs;
+}
+
+/**
+ * @brief Delivers the completion of the oldest deferred transfer.
+ **/
+static void imu_sim_AsyncComplete(void)
+{
+    imu_sim_AsyncXfer done = imu_sim_AsyncQueue[imu_sim_AsyncHead];
+
+    /* Dequeue first, the completion may submit the next transfer */
+    imu_sim_AsyncHead = (imu_sim_AsyncHead + 1) % IMU_SIM_ASYNC_QUEUE_DEPTH;
+    imu_sim_AsyncCount--;
+    if (imu_sim_NowNs < done.doneNs)
+    {
+        imu_sim_NowNs = done.doneNs;
+    }
+    adi_imu_CompleteTransfer(done.xfer, done.status);
+}
+
+/**
+ * @brief Advances the virtual clock.
+ *
+ * @param ns The time to advance by, in nanoseconds.
+ *
+ * Data-ready handlers and deferred transfer completions are called at their due times, in time order across
+ * IMUs. Handlers may issue SPI transfers, which advance the clock further. Edges which occur during a blocking
+ * transfer are delivered, coalesced, at the start of the next imu_sim_Advance() or delay call, like an
+ * interrupt held off by the transfer.
+ **/
+void imu_sim_Advance(uint64_t ns)
+{
+    uint64_t target = imu_sim_NowNs + ns;
+
+    for (;;)
+    {
+        uint64_t nextNs = UINT64_MAX;
+
+        for (uint8_t i = 0; i < IMU_SIM_MAX_DEVICES; i++)
+        {
+            imu_sim_Device *dev = &imu_sim_Devices[i];
+
+            imu_sim_Tick(dev, i);
+            /* A deferred transfer may have produced samples ahead of the clock. Their edges wait for it */
+            if (dev->pendingEdges && dev->drHandler && (dev->sampleNs <= imu_sim_NowNs))
+            {
+                dev->pendingEdges = 0;
+                dev->stats.drEdges++;
+                if (imu_sim_IrqLatencyNs > 0)
+                {
+                    imu_sim_IrqSeed = imu_sim_IrqSeed * 1103515245u + 12345u;
+                    imu_sim_NowNs += (imu_sim_IrqSeed >> 8) % (imu_sim_IrqLatencyNs + 1);
+                }
+                dev->drHandler(dev->drContext);
+            }
+            if (dev->pendingEdges && dev->drHandler && (dev->sampleNs < nextNs))
+            {
+                nextNs = dev->sampleNs;
+            }
+            if (dev->nextSampleNs < nextNs)
+            {
+                nextNs = dev->nextSampleNs;
+            }
+        }
+        if (imu_sim_AsyncCount > 0)
+        {
+            if (imu_sim_AsyncQueue[imu_sim_AsyncHead].doneNs <= imu_sim_NowNs)
+            {
+                imu_sim_AsyncComplete();
+                continue;
+            }
+            if (imu_sim_AsyncQueue[imu_sim_AsyncHead].doneNs < nextNs)
+            {
+                nextNs = imu_sim_AsyncQueue[imu_sim_AsyncHead].doneNs;
+            }
+        }
+        if (nextNs > target)
+        {
+            break;
+        }
+        if (imu_sim_NowNs < nextNs)
+        {
+            imu_sim_NowNs = nextNs;
+        }
+    }
+    if (imu_sim_NowNs < target)
+    {
+        imu_sim_NowNs = target;
+    }
+}
+
+/**
+ * @brief Gets the statistics of one IMU.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @param stats A pointer to the statistics struct to be populated.
+ **/
+void imu_sim_GetStats(uint8_t csPin, imu_sim_Stats *stats)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (dev)
+    {
+        *stats = dev->stats;
+    }
+}
+
+/**
+ * @brief Clears the statistics of every IMU.
+ **/
+void imu_sim_ClearStats(void)
+{
+    imu_sim_Stats empty = { 0 };
+
+    for (uint8_t i = 0; i < IMU_SIM_MAX_DEVICES; i++)
+    {
+        imu_sim_Devices[i].stats = empty;
+    }
+}
+
+/**
+ * @brief Reads a register of one IMU without going through SPI.
+ *
+ * @param pageIDRegAddr The register location, with the page in [15:8] on paged families.
+ **/
+uint16_t imu_sim_PeekReg(uint8_t csPin, uint16_t pageIDRegAddr)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (!dev || (((pageIDRegAddr >> 8) & 0xFF) >= IMU_SIM_NUM_PAGES))
+    {
+        return 0;
+    }
+#if SUPPORTS_PAGES
+    if ((pageIDRegAddr & 0x7E) == (PAGE_ID_REG & 0xFF))
+    {
+        return dev->page;
+    }
+#endif
+
+    return SIM_PAGE_REG(dev, pageIDRegAddr);
+}
+
+/**
+ * @brief Writes a register of one IMU without going through SPI. Read-only registers can be written too.
+ *
+ * @param pageIDRegAddr The register location, with the page in [15:8] on paged families.
+ **/
+void imu_sim_PokeReg(uint8_t csPin, uint16_t pageIDRegAddr, uint16_t val)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (!dev || (((pageIDRegAddr >> 8) & 0xFF) >= IMU_SIM_NUM_PAGES))
+    {
+        return;
+    }
+#if SUPPORTS_PAGES
+    if ((pageIDRegAddr & 0x7E) == (PAGE_ID_REG & 0xFF))
+    {
+        dev->page = (val < IMU_SIM_NUM_PAGES) ? (uint8_t) val : dev->page;
+        return;
+    }
+#endif
+    SIM_PAGE_REG(dev, pageIDRegAddr) = val;
+}
+
+/**
+ * @brief Starts recording the SPI words sent to one IMU.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @param words The buffer the first MOSI word of every CS assertion is stored in, in bus order. Must stay
+ * valid until imu_sim_StopTrace() or imu_sim_Reset().
+ *
+ * @param capacity The number of words the buffer holds. Later words are not recorded.
+ **/
+void imu_sim_StartTrace(uint8_t csPin, uint16_t *words, uint16_t capacity)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (dev)
+    {
+        dev->trace = words;
+        dev->traceCapacity = capacity;
+        dev->traceLength = 0;
+    }
+}
+
+/**
+ * @brief Stops recording the SPI words sent to one IMU.
+ *
+ * @param csPin The chip select of the IMU.
+ *
+ * @return The number of words recorded since imu_sim_StartTrace().
+ **/
+uint16_t imu_sim_StopTrace(uint8_t csPin)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (!dev || !dev->trace)
+    {
+        return 0;
+    }
+    dev->trace = 0;
+
+    return dev->traceLength;
+}
+
+/**
+ * @brief Clocks a transfer through a simulated IMU, advancing the virtual clock by its time on the wire.
+ *
+ * The virtual clock advances by the time each word spends on the wire plus stallTime after every word,
+ * including the last one, so back-to-back transfers respect the stall time as well.
+ **/
+static void imu_sim_Exchange(imu_sim_Device *dev, uint8_t csPin, uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime)
+{
+    if ((wordLen == 0) || (wordLen > xferLen))
+    {
+        wordLen = xferLen;
+    }
+
+    dev->stats.transfers++;
+    for (uint16_t offset = 0; offset < xferLen; offset += wordLen)
+    {
+        uint16_t len = ((xferLen - offset) < wordLen) ? (xferLen - offset) : wordLen;
+
+        imu_sim_Select(dev, csPin, &txBuf[offset], &rxBuf[offset], len);
+        imu_sim_NowNs += (uint64_t) stallTime * 1000;
+    }
+}
+
+/**
+ * @brief Performs a blocking SPI transfer against the simulated IMUs. See spi_driver.h.
+ *
+ * A blocking transfer first waits for any deferred transfer still on the wire.
+ **/
+adi_imu_Status spi_Transfer(uint8_t csPin, uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    if (!dev)
+    {
+        return ADI_IMU_SPIRW_FAILED;
+    }
+
+    if (imu_sim_NowNs < imu_sim_BusFreeNs)
+    {
+        imu_sim_NowNs = imu_sim_BusFreeNs;
+    }
+    imu_sim_NowNs += imu_sim_OverheadNs;
+    imu_sim_Exchange(dev, csPin, txBuf, rxBuf, xferLen, wordLen, stallTime);
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Starts a non-blocking SPI transfer. See spi_driver.h and imu_sim_SetAsyncCompletion().
+ *
+ * In deferred mode the transfer gets the bus once the transfers queued before it are off the wire. Its data
+ * is exchanged at that time, but the virtual clock of the caller only advances by the transfer overhead.
+ **/
+adi_imu_Status spi_TransferAsync(adi_imu_SpiXfer *xfer)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(xfer->csPin);
+    imu_sim_AsyncXfer *queued;
+    uint64_t hostNs;
+
+    if (!imu_sim_AsyncDeferred)
+    {
+        adi_imu_CompleteTransfer(xfer, spi_Transfer(xfer->csPin, xfer->txBuf, xfer->rxBuf, xfer->xferLen, xfer->wordLen, xfer->stallTime));
+        return ADI_IMU_SUCCESS;
+    }
+    if (!dev || (imu_sim_AsyncCount >= IMU_SIM_ASYNC_QUEUE_DEPTH))
+    {
+        return ADI_IMU_SPIRW_FAILED;
+    }
+
+    imu_sim_NowNs += imu_sim_OverheadNs;
+    hostNs = imu_sim_NowNs;
+    if (imu_sim_NowNs < imu_sim_BusFreeNs)
+    {
+        imu_sim_NowNs = imu_sim_BusFreeNs;
+    }
+    imu_sim_Exchange(dev, xfer->csPin, xfer->txBuf, xfer->rxBuf, xfer->xferLen, xfer->wordLen, xfer->stallTime);
+    imu_sim_BusFreeNs = imu_sim_NowNs;
+    imu_sim_NowNs = hostNs;
+
+    queued = &imu_sim_AsyncQueue[(imu_sim_AsyncHead + imu_sim_AsyncCount) % IMU_SIM_ASYNC_QUEUE_DEPTH];
+    queued->xfer = xfer;
+    queued->status = ADI_IMU_SUCCESS;
+    queued->doneNs = imu_sim_BusFreeNs + imu_sim_AsyncLatencyNs;
+    imu_sim_AsyncCount++;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Waits for the next deferred transfer completion. See spi_driver.h.
+ *
+ * With nothing on the wire the clock advances to the next data-ready edge instead, the only other event which
+ * can change what the caller is waiting for.
+ **/
+void spi_WaitEvent(void)
+{
+    uint64_t nextNs = UINT64_MAX;
+
+    if (imu_sim_AsyncCount > 0)
+    {
+        nextNs = imu_sim_AsyncQueue[imu_sim_AsyncHead].doneNs;
+    }
+    else
+    {
+        for (uint8_t i = 0; i < IMU_SIM_MAX_DEVICES; i++)
+        {
+            if (imu_sim_Devices[i].nextSampleNs < nextNs)
+            {
+                nextNs = imu_sim_Devices[i].nextSampleNs;
+            }
+        }
+    }
+    imu_sim_Advance((nextNs > imu_sim_NowNs) ? (nextNs - imu_sim_NowNs) : 0);
+}
+
+/**
+ * @brief Attaches a handler to the data-ready signal of a simulated IMU. See spi_driver.h.
+ *
+ * Every sample generated by the IMU is one data-ready edge; the polarity is not modeled.
+ **/
+adi_imu_Status gpio_AttachDataReady(uint8_t csPin, adi_imu_DatRdyGPIO drPin, adi_imu_EdgeType edge, adi_imu_DataReadyHandler handler, void *context)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    (void) drPin;
+    (void) edge;
+    if (!dev)
+    {
+        return ADI_IMU_SPIRW_FAILED;
+    }
+    dev->drHandler = handler;
+    dev->drContext = context;
+    dev->pendingEdges = 0;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/* Detach the data-ready handler of a simulated IMU */
+void gpio_DetachDataReady(uint8_t csPin, adi_imu_DatRdyGPIO drPin)
+{
+    imu_sim_Device *dev = imu_sim_GetDevice(csPin);
+
+    (void) drPin;
+    if (dev)
+    {
+        dev->drHandler = 0;
+        dev->pendingEdges = 0;
+    }
+}
+
+/* Advance the virtual clock by a number of microseconds */
+void delay_US(uint32_t microseconds)
+{
+    imu_sim_Advance((uint64_t) microseconds * 1000);
+}
+
+/* Advance the virtual clock by a number of milliseconds */
+void delay_MS(uint32_t milliseconds)
+{
+    imu_sim_Advance((uint64_t) milliseconds * 1000000);
+}
+
+/* Read the virtual clock as a cycle counter, one tick per nanosecond */
+uint32_t timer_GetCycles(void)
+{
+    return (uint32_t) imu_sim_Now();
+}
+
+/* Read the virtual clock through the host clock error set by imu_sim_SetHostClockError() */
+uint64_t timer_GetNanos(void)
+{
+    uint64_t now = imu_sim_Now();
+
+    return now + (uint64_t) (((int64_t) now * imu_sim_HostErrorPpb) / 1000000000LL);
+}
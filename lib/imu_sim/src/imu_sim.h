@@ -0,0 +1,128 @@
+/**
+  * @file		  imu_sim.h
+  * @date		  10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Host-side ADIS1647X and ADCMXL3021 simulator implementing the spi_driver.h contract.
+ **/
+
+#ifndef __IMU_SIM_H_
+#define __IMU_SIM_H_
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "spi_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of simulated IMUs. Each one is selected by the csPin equal to its index */
+#define IMU_SIM_MAX_DEVICES             4
+
+/* Shortest gap between two CS assertions the simulated IMU accepts, in nanoseconds (tSTALL) */
+#define IMU_SIM_STALL_NS                16000
+
+/* Fastest SCLK the simulated IMU accepts for burst reads, in Hz */
+#define IMU_SIM_MAX_BURST_SCLK          1000000
+
+/* Internal sample rate before decimation, in Hz */
+#define IMU_SIM_BASE_RATE               MAX_DATA_RATE
+
+/* Value clocked out when the IMU has no valid response to return */
+#define IMU_SIM_NO_RESPONSE             0x0000
+
+/* Transfers spi_TransferAsync() can queue in deferred mode, like the descriptors of a DMA channel */
+#define IMU_SIM_ASYNC_QUEUE_DEPTH       8
+
+/* Simulated IMU configuration, applied on imu_sim_Reset() */
+typedef struct {
+    uint16_t prodId;                        /* PROD_ID, e.g. 16470, 16475, 16477 or 3021 */
+    uint16_t rangMdl;                       /* RANG_MDL, unused on families without it */
+    uint16_t serialNum;                     /* SERIAL_NUM */
+} imu_sim_Config;
+
+/* One internal sample. Every inertial value is the full 32-bit output */
+typedef struct {
+    int32_t gyro[3];
+    int32_t accel[3];
+    int32_t deltaAngle[3];
+    int32_t deltaVelocity[3];
+    int16_t temperature;
+} imu_sim_Sample;
+
+/* Sample generator, called once per data-ready period with the sample index since reset */
+typedef void (*imu_sim_SampleSource)(uint8_t csPin, uint32_t index, imu_sim_Sample *sample, void *context);
+
+/* Simulated bus and IMU statistics */
+typedef struct {
+    uint32_t csAssertions;                  /* CS assertion/deassertion cycles */
+    uint32_t bytes;                         /* Bytes clocked in each direction */
+    uint32_t transfers;                     /* spi_Transfer calls */
+    uint32_t bursts;                        /* Burst reads served */
+    uint32_t samples;                       /* Samples generated (data-ready periods elapsed) */
+    uint32_t drEdges;                       /* Data-ready handler calls */
+    uint32_t stallViolations;               /* CS assertions issued less than IMU_SIM_STALL_NS after the previous one */
+    uint32_t sclkViolations;                /* Burst reads issued above IMU_SIM_MAX_BURST_SCLK */
+    uint32_t busyViolations;                /* CS assertions issued while the IMU was executing a command */
+    uint32_t pageWrites;                    /* PAGE_ID writes, paged families only */
+    uint64_t latencyNsTotal;                /* Sum of sample age at burst read, for the average latency */
+    uint64_t latencyNsMax;                  /* Largest sample age at burst read */
+} imu_sim_Stats;
+
+/* Reset every simulated IMU and the virtual clock */
+void imu_sim_Reset(const imu_sim_Config *config);
+
+/* Set the simulated SCLK frequency */
+void imu_sim_SetSclk(uint32_t sclkHz);
+
+/* Set a fixed host overhead added to every spi_Transfer call */
+void imu_sim_SetTransferOverhead(uint32_t overheadNs);
+
+/* Select whether spi_TransferAsync() completes immediately or in the background, and the completion latency */
+void imu_sim_SetAsyncCompletion(adi_imu_Boolean deferred, uint32_t latencyNs);
+
+/* Set the command execution time, in percent of the datasheet maximum */
+void imu_sim_SetCommandTime(uint8_t percent);
+
+/* Set the rate error of the host clock read by timer_GetNanos() */
+void imu_sim_SetHostClockError(int32_t errorPpb);
+
+/* Set the largest delay between a data-ready edge and its handler call */
+void imu_sim_SetIrqLatency(uint32_t maxNs);
+
+/* Replace the default sample generator of one IMU */
+void imu_sim_SetSampleSource(uint8_t csPin, imu_sim_SampleSource source, void *context);
+
+/* Flip bits in the next burst payload of one IMU */
+void imu_sim_CorruptNextBurst(uint8_t csPin, uint16_t byteIndex, uint8_t xorMask);
+
+/* Get the virtual clock, in nanoseconds */
+uint64_t imu_sim_Now(void);
+
+/* Advance the virtual clock, firing data-ready handlers on the way */
+void imu_sim_Advance(uint64_t ns);
+
+/* Get the statistics of one IMU */
+void imu_sim_GetStats(uint8_t csPin, imu_sim_Stats *stats);
+
+/* Clear the statistics of every IMU */
+void imu_sim_ClearStats(void);
+
+/* Direct access to the register file of one IMU, bypassing SPI. [15:8] = page id, [7:0] = reg addr */
+uint16_t imu_sim_PeekReg(uint8_t csPin, uint16_t pageIDRegAddr);
+void imu_sim_PokeReg(uint8_t csPin, uint16_t pageIDRegAddr, uint16_t val);
+
+/* Record the first SPI word of every CS assertion of one IMU */
+void imu_sim_StartTrace(uint8_t csPin, uint16_t *words, uint16_t capacity);
+uint16_t imu_sim_StopTrace(uint8_t csPin);
+
+#if SUPPORTS_CAPTURE
+/* Get an entry of a stored capture record */
+uint16_t imu_sim_CaptureSample(uint8_t csPin, uint16_t record, uint8_t axis, uint16_t index);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,31 +9,527 @@
 #include "adi_imu_conf.h"
 #include "spi_driver.h"
 
-extern adi_imu_Status spi_Transfer(uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime);
+extern adi_imu_Status spi_Transfer(uint8_t csPin, uint8_t *txBuf, uint8_t *rxBuf, uint16_t xferLen, uint16_t wordLen, uint16_t stallTime);
+#if ENABLE_ASYNC_SPI
+extern adi_imu_Status spi_TransferAsync(adi_imu_SpiXfer *xfer);
+extern void spi_WaitEvent(void);
+#endif
 extern void delay_US(uint32_t microseconds);
 extern void delay_MS(uint32_t milliseconds);
 
-static uint8_t txBuf[SPI_BUFF_SIZE];
-static uint8_t rxBuf[SPI_BUFF_SIZE];
-static adi_imu_Status status = ADI_IMU_SUCCESS;
-static uint16_t tempRegA, tempRegB;
+#if SUPPORTS_RANGE_REG
+static adi_imu_Status adi_imu_GetSensorRange(adi_imu_Device *imu, adi_imu_RangeReg *range_data);
+#endif
+
+/** 
+ * @brief Submits a transfer to the SPI transport.
+ * 
+ * @param xfer A pointer to the transfer descriptor. Must remain valid until the transfer completes
+ * 
+ * @return A status code indicating the success of the submission.
+ * 
+ * When ENABLE_ASYNC_SPI is set the transfer is handed to spi_TransferAsync() and this function returns
+ * while the data is still on the wire. Otherwise the synchronous spi_Transfer() is used as a fallback and the
+ * transfer is completed (and the callback invoked) before this function returns.
+ **/
+adi_imu_Status adi_imu_SubmitTransfer(adi_imu_SpiXfer *xfer)
+{
+    adi_imu_Status xferStatus;
+
+    xfer->done = FALSE;
+    xfer->status = ADI_IMU_SUCCESS;
+#if ENABLE_INSTRUMENTATION
+    xfer->startCycles = timer_GetCycles();
+#endif
+#if ENABLE_ASYNC_SPI
+    xferStatus = spi_TransferAsync(xfer);
+    if (xferStatus != ADI_IMU_SUCCESS)
+    {
+        /* The transport rejected the request, so no completion will ever be signaled */
+        xfer->status = xferStatus;
+        xfer->done = TRUE;
+    }
+    return xferStatus;
+#else
+    xferStatus = spi_Transfer(xfer->csPin, xfer->txBuf, xfer->rxBuf, xfer->xferLen, xfer->wordLen, xfer->stallTime);
+    adi_imu_CompleteTransfer(xfer, xferStatus);
+    return ADI_IMU_SUCCESS;
+#endif
+}
+
+/** 
+ * @brief Signals the completion of a submitted transfer.
+ * 
+ * @param xfer A pointer to the completed transfer descriptor
+ * 
+ * @param xferStatus The result of the transfer
+ * 
+ * This function must be called by the transport (typically from the DMA or SPI completion interrupt) exactly
+ * once per transfer accepted by spi_TransferAsync(). The callback, if any, runs in the caller's context.
+ **/
+void adi_imu_CompleteTransfer(adi_imu_SpiXfer *xfer, adi_imu_Status xferStatus)
+{
+    /* Read before done is set, the descriptor may be reused (or its stack frame gone) as soon as it is */
+    adi_imu_SpiCallback callback = xfer->callback;
+
+#if ENABLE_INSTRUMENTATION
+    adi_imu_InstrTransfer(xfer);
+#endif
+    xfer->status = xferStatus;
+    __atomic_store_n(&xfer->done, TRUE, __ATOMIC_RELEASE);
+    if (callback)
+    {
+        callback(xfer);
+    }
+}
+
+/** 
+ * @brief Polls a submitted transfer for completion.
+ * 
+ * @param xfer A pointer to the transfer descriptor
+ * 
+ * @return TRUE once the transfer has completed and its buffers belong to the caller again.
+ **/
+adi_imu_Boolean adi_imu_TransferDone(const adi_imu_SpiXfer *xfer)
+{
+    return __atomic_load_n(&xfer->done, __ATOMIC_ACQUIRE);
+}
+
+/** 
+ * @brief Waits for a submitted transfer to complete.
+ * 
+ * @param xfer A pointer to the transfer descriptor
+ * 
+ * @return The imu->status reported by the transport for this transfer.
+ **/
+adi_imu_Status adi_imu_WaitTransfer(adi_imu_SpiXfer *xfer)
+{
+    while (!adi_imu_TransferDone(xfer))
+    {
+#if ENABLE_ASYNC_SPI
+        spi_WaitEvent();
+#endif
+    }
+
+    return xfer->status;
+}
+
+/** 
+ * @brief Performs a blocking transfer of the device tx buffer using the register access word format.
+ * 
+ * @return A status code indicating the success of the SPI transaction.
+ * 
+ * Every register transaction in this file funnels through here so that the transport selection happens in a
+ * single place.
+ **/
+static adi_imu_Status adi_imu_Transfer(adi_imu_Device *imu, uint16_t xferLen)
+{
+    adi_imu_Status xferStatus;
+    adi_imu_SpiXfer xfer;
+
+    xfer.csPin = imu->csPin;
+    xfer.txBuf = imu->txBuf;
+    xfer.rxBuf = imu->rxBuf;
+    xfer.xferLen = xferLen;
+    xfer.wordLen = REG_XFER_WORD_LENGTH;
+    xfer.stallTime = imu->model->stallTimeUs;
+    xfer.callback = 0;
+    xfer.context = 0;
+
+    xferStatus = adi_imu_SubmitTransfer(&xfer);
+    if (xferStatus != ADI_IMU_SUCCESS)
+    {
+        return xferStatus;
+    }
+
+    return adi_imu_WaitTransfer(&xfer);
+}
+
+/** 
+ * @brief Loads the scale factors matching the connected model into the device context.
+ * 
+ * @return A status code indicating the success of the subroutine.
+ * 
+ * The accelerometer scale factors come from the model description selected by adi_imu_DetectModel() and the
+ * gyroscope scale factors from RANG_MDL.
+ **/
+#if ENABLE_SCALED_DATA | ENABLE_FIXED_POINT_DATA
+static adi_imu_Status adi_imu_UpdateScaleFactors(adi_imu_Device *imu)
+{
+    adi_imu_RangeReg range = RANGE_2000DPS;
+
+#if SUPPORTS_RANGE_REG
+    imu->status = adi_imu_GetSensorRange(imu, &range);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+#endif
+
+#if ENABLE_SCALED_DATA
+    /* Scale factors are stored as units per LSB so the hot path never divides */
+#if ENABLE_DELTA_DATA
+    /* The gyroscope and accelerometer fields carry delta angles and delta velocities */
+    imu->scale16.gyro16Scale = 1.0f / DELTANG_16BIT_SCALE_FOR_RANGE(range);
+    imu->scale16.accel16Scale = imu->model->accel16Scale;
+#else
+    imu->scale16.gyro16Scale = 1.0f / GYRO_16BIT_SCALE_FOR_RANGE(range);
+    imu->scale16.accel16Scale = imu->model->accel16Scale;
+#endif
+    imu->scale16.tempScale = 1.0f / TEMPERATURE_SCALE;
+#if SENSOR_DATA_32BIT
+#if ENABLE_DELTA_DATA
+    imu->scale32.gyro32Scale = 1.0f / DELTANG_32BIT_SCALE_FOR_RANGE(range);
+    imu->scale32.accel32Scale = imu->model->accel32Scale;
+#else
+    imu->scale32.gyro32Scale = 1.0f / GYRO_32BIT_SCALE_FOR_RANGE(range);
+    imu->scale32.accel32Scale = imu->model->accel32Scale;
+#endif
+    imu->scale32.tempScale = 1.0f / TEMPERATURE_SCALE;
+#endif
+#endif
+
+#if ENABLE_FIXED_POINT_DATA
+    /* Integer constants only, so no floating-point code is linked in */
+#if ENABLE_DELTA_DATA & SENSOR_DATA_32BIT
+    imu->fixedScale.gyroScale = DELTANG_32BIT_FIXED_FOR_RANGE(range);
+    imu->fixedScale.accelScale = imu->model->accelFixedScale;
+#elif ENABLE_DELTA_DATA
+    imu->fixedScale.gyroScale = DELTANG_16BIT_FIXED_FOR_RANGE(range);
+    imu->fixedScale.accelScale = imu->model->accelFixedScale;
+#elif SENSOR_DATA_32BIT
+    imu->fixedScale.gyroScale = GYRO_32BIT_FIXED_FOR_RANGE(range);
+    imu->fixedScale.accelScale = imu->model->accelFixedScale;
+#else
+    imu->fixedScale.gyroScale = GYRO_16BIT_FIXED_FOR_RANGE(range);
+    imu->fixedScale.accelScale = imu->model->accelFixedScale;
+#endif
+    imu->fixedScale.tempScale = TEMPERATURE_FIXED_SCALE;
+#endif
+
+    return imu->status;
+}
+#endif
+
+/** 
+ * @brief Configures the burst message format in MSC_CTRL.
+ * 
+ * @return A status code indicating the success of the subroutine.
+ * 
+ * This function selects the 16-bit or 32-bit burst payload of the detected model and selects
+ * gyroscope/accelerometer output, or delta angle/velocity output with ENABLE_DELTA_DATA. The register is only
+ * written if it differs, and the write is read back so a rejected format is reported instead of silently
+ * producing corrupt samples. Delta output on a member without BURST_SEL (ADIS16470) returns
+ * ADI_IMU_BURST_NOT_SUPPORTED without touching the IMU.
+ **/
+#if ENABLE_BURST_MODE & SUPPORTS_32BIT_BURST
+static adi_imu_Status adi_imu_ConfigureBurst(adi_imu_Device *imu)
+{
+    uint16_t miscCtrl = 0;
+    uint16_t burstCtrl = 0;
+
+    imu->status = adi_imu_ReadReg(imu, MISC_CTRL_REG, &miscCtrl);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    burstCtrl = imu->model->burstCtrl;
+#if ENABLE_DELTA_DATA
+    /* Members without BURST_SEL only burst the gyroscope and accelerometer outputs */
+    if (!imu->model->hasBurstSel)
+    {
+        imu->status = ADI_IMU_BURST_NOT_SUPPORTED;
+        return imu->status;
+    }
+    burstCtrl |= BITM_MISC_CTRL_REG_BURST_SEL;
+#endif
+    if ((miscCtrl & (BITM_MISC_CTRL_REG_BURST_SIZE | BITM_MISC_CTRL_REG_BURST_SEL)) == burstCtrl)
+    {
+        return imu->status;
+    }
+
+    miscCtrl = (miscCtrl & ~(BITM_MISC_CTRL_REG_BURST_SIZE | BITM_MISC_CTRL_REG_BURST_SEL)) | burstCtrl;
+    imu->status = adi_imu_WriteReg(imu, MISC_CTRL_REG, miscCtrl);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+#if ENABLE_REG_CACHE
+    /* Read back from the IMU rather than the write-through shadow copy */
+    adi_imu_CacheInvalidate(imu);
+#endif
+    imu->status = adi_imu_ReadReg(imu, MISC_CTRL_REG, &miscCtrl);
+    if ((imu->status == ADI_IMU_SUCCESS) && ((miscCtrl & (BITM_MISC_CTRL_REG_BURST_SIZE | BITM_MISC_CTRL_REG_BURST_SEL)) != burstCtrl))
+    {
+        imu->status = ADI_IMU_BURST_CONFIG_FAILED;
+    }
+
+    return imu->status;
+}
+#endif
+
+/** 
+ * @brief Binds a device context to its chip select and clears every piece of tracked IMU state.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param csPin The chip select passed to the SPI transport for every transaction with this device
+ **/
+static void adi_imu_ResetContext(adi_imu_Device *imu, uint8_t csPin)
+{
+    imu->csPin = csPin;
+    imu->model = adi_imu_FindModel(ADI_IMU_MODEL_DEFAULT);
+    imu->status = ADI_IMU_SUCCESS;
+#if SUPPORTS_PAGES
+    /* The IMU may have been left on any page by a previous session */
+    imu->activePage = ADI_IMU_PAGE_UNKNOWN;
+#endif
+#if VERIFY_BURST_CHECKSUM
+    imu->checksumErrors = 0;
+#endif
+#if ENABLE_REG_CACHE
+    adi_imu_CacheReset(imu);
+#endif
+#if ENABLE_FIR_BANK_CACHE
+    imu->firCacheValid = 0;
+    imu->firDirty = FALSE;
+#endif
+#if SUPPORTS_EXTERNAL_SYNC
+    imu->syncHz = 0;
+#endif
+#if ENABLE_STREAMING
+    imu->streaming = FALSE;
+    imu->bus = 0;
+#endif
+}
+
+/** 
+ * @brief Verifies and configures a responsive IMU.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param config A pointer to register writes applied after the communication check. May be NULL
+ * 
+ * @param numConfig The number of register writes
+ * 
+ * @return A status code indicating the success of the subroutine.
+ **/
+static adi_imu_Status adi_imu_BringUp(adi_imu_Device *imu, const adi_imu_RegWrite *config, uint16_t numConfig)
+{
+    imu->status = adi_imu_CheckComs(imu);
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->status = adi_imu_DetectModel(imu);
+    }
+    if ((imu->status == ADI_IMU_SUCCESS) && (numConfig > 0))
+    {
+        imu->status = adi_imu_WriteRegBatch(imu, config, numConfig);
+    }
+#if ENABLE_BURST_MODE & SUPPORTS_32BIT_BURST
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->status = adi_imu_ConfigureBurst(imu);
+    }
+#endif
+#if ENABLE_SCALED_DATA | ENABLE_FIXED_POINT_DATA
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->status = adi_imu_UpdateScaleFactors(imu);
+    }
+#endif
+
+    return imu->status;
+}
 
 /** 
  * @brief IMU initialization routine.
  * 
+ * @param imu A pointer to the device context to be initialized
+ * 
+ * @param csPin The chip select passed to the SPI transport for every transaction with this device
+ * 
  * @return A status code indicating the success of the subroutine.
  * 
- * This function performs IMU initialization tasks.
+ * This function binds the device context to its chip select, verifies communication, identifies the model
+ * from PROD_ID, configures the burst format and loads the scale factors for that model. Every other function
+ * in the library operates on an initialized context, so several IMUs can be driven side by side without
+ * sharing any state.
  **/
-adi_imu_Status adi_imu_Init() 
+adi_imu_Status adi_imu_Init(adi_imu_Device *imu, uint8_t csPin)
 {
-    status = adi_imu_CheckComs();
+    adi_imu_ResetContext(imu, csPin);
+
+    return adi_imu_BringUp(imu, 0, 0);
+}
+
+/** 
+ * @brief Starts up, verifies and configures several IMUs with a single shared wait.
+ * 
+ * @param imus A pointer to an array of numImus device contexts to be initialized
+ * 
+ * @param csPins A pointer to the chip select of each device
+ * 
+ * @param numImus The number of devices
+ * 
+ * @param mode BOOT_POWER_ON when called right after power is applied, BOOT_SOFTWARE_RESET to reset every
+ * IMU first
+ * 
+ * @param config A pointer to register writes applied to every IMU once it is up, e.g. the stored sample rate
+ * and filter settings. May be NULL
+ * 
+ * @param numConfig The number of register writes
+ * 
+ * @return ADI_IMU_SUCCESS if every IMU is ready, otherwise the status of the first one which is not.
+ * 
+ * The reset commands are issued to every IMU back to back, and the start-up time is then waited for once
+ * instead of once per device. With ENABLE_READY_POLL each IMU still waiting is polled for a valid product ID
+ * with the same backoff as adi_imu_SoftwareReset(), and the wait ends as soon as every IMU has answered. The
+ * datasheet start-up time is the hard limit, so the time to bring the whole set up does not grow with the
+ * number of IMUs beyond the per-device SPI traffic. Each IMU is then verified and configured as
+ * adi_imu_Init() does, with config sent through adi_imu_WriteRegBatch() before the burst format is set.
+ * 
+ * The readiness of each device is left in its status field: ADI_IMU_COMMAND_TIMEOUT if it never answered,
+ * ADI_IMU_PRODID_VERIFY_FAILED if it answered with a product ID outside the compiled family. Devices which
+ * are not ready are skipped and the others are fully usable.
+ **/
+adi_imu_Status adi_imu_InitGroup(adi_imu_Device *imus, const uint8_t *csPins, uint8_t numImus, adi_imu_BootMode mode, const adi_imu_RegWrite *config, uint16_t numConfig)
+{
+    uint32_t timeoutMs = (mode == BOOT_SOFTWARE_RESET) ? RESET_RECOVERY_TIME_MS : POWER_ON_TIME_MS;
+    adi_imu_Status status = ADI_IMU_SUCCESS;
+#if ENABLE_READY_POLL
+    const uint16_t prodIdReg = PRODUCT_ID_REG;
+    uint32_t remainingUs = timeoutMs * 1000;
+    uint32_t intervalUs = READY_POLL_MIN_INTERVAL_US;
+    uint8_t waiting = 0;
+    uint16_t val;
+#endif
+
+    /* Issue the commands to every IMU before waiting */
+    for (uint8_t i = 0; i < numImus; i++)
+    {
+        adi_imu_ResetContext(&imus[i], csPins[i]);
+        if (mode == BOOT_SOFTWARE_RESET)
+        {
+            imus[i].status = adi_imu_WriteReg(&imus[i], COMMAND_REG, BITM_COMMAND_REG_SOFTWARE_RST);
+        }
+#if ENABLE_READY_POLL
+        if (imus[i].status == ADI_IMU_SUCCESS)
+        {
+            /* Marks the devices still waiting for a product ID */
+            imus[i].status = ADI_IMU_COMMAND_TIMEOUT;
+            waiting++;
+        }
+#endif
+    }
+
+    /* Wait once for the whole set */
+#if ENABLE_READY_POLL
+    while ((waiting > 0) && (remainingUs > 0))
+    {
+        if (intervalUs > remainingUs)
+        {
+            intervalUs = remainingUs;
+        }
+        delay_US(intervalUs);
+        remainingUs -= intervalUs;
+
+        for (uint8_t i = 0; i < numImus; i++)
+        {
+            if ((imus[i].status != ADI_IMU_COMMAND_TIMEOUT) && (imus[i].status != ADI_IMU_PRODID_VERIFY_FAILED))
+            {
+                continue;
+            }
+#if SUPPORTS_PAGES
+            /* A booting IMU ignores page writes and starts on page 0 */
+            imus[i].activePage = ADI_IMU_PAGE_UNKNOWN;
+#endif
+            imus[i].status = adi_imu_ReadRegArray(&imus[i], &prodIdReg, &val, 1, 1);
+            if ((imus[i].status == ADI_IMU_SUCCESS) && ((val == 0x0000) || (adi_imu_FindModel(val) == 0)))
+            {
+                /* A booting IMU returns 0x0000 (or 0xFFFF with a pull-up on MISO) */
+                imus[i].status = ((val == 0x0000) || (val == 0xFFFF)) ? ADI_IMU_COMMAND_TIMEOUT : ADI_IMU_PRODID_VERIFY_FAILED;
+                continue;
+            }
+            waiting--;
+        }
+        if (intervalUs < READY_POLL_MAX_INTERVAL_US)
+        {
+            intervalUs *= 2;
+        }
+    }
+#else
+    delay_MS(timeoutMs);
+#endif
+
+    /* Verify and configure every IMU which came up */
+    for (uint8_t i = 0; i < numImus; i++)
+    {
+        if (imus[i].status == ADI_IMU_SUCCESS)
+        {
+            adi_imu_BringUp(&imus[i], config, numConfig);
+        }
+        if ((status == ADI_IMU_SUCCESS) && (imus[i].status != ADI_IMU_SUCCESS))
+        {
+            status = imus[i].status;
+        }
+    }
 
     return status;
 }
 
 /** 
- * @brief Read a single register from the IMU
+ * @brief Queues a PAGE_ID write unless the register's page is already active.
+ * 
+ * @param offset The tx buffer offset the page write is placed at
+ * 
+ * @param pageIDRegAddr The register about to be accessed
+ * 
+ * @return The number of bytes queued, 0 or 2.
+ * 
+ * PAGE_ID itself is mapped on every page and never needs a page write.
+ **/
+#if SUPPORTS_PAGES
+static uint16_t adi_imu_QueuePageSelect(adi_imu_Device *imu, uint16_t offset, uint16_t pageIDRegAddr)
+{
+    uint16_t page = ((pageIDRegAddr >> 8) & 0xFF);
+
+    if (((pageIDRegAddr & 0xFF) == (PAGE_ID_REG & 0xFF)) || (page == imu->activePage))
+    {
+        return 0;
+    }
+    imu->txBuf[offset] = (0x80 | (PAGE_ID_REG & 0xFF));
+    imu->txBuf[offset + 1] = page;
+    imu->activePage = page;
+
+    return 2;
+}
+
+/** 
+ * @brief Updates the page tracker after a register transaction.
+ * 
+ * @param pageIDRegAddr The register which was accessed
+ * 
+ * @param val The value written to or read from the register
+ * 
+ * A failed transaction leaves the IMU page unknown, which forces a page write on the next access.
+ **/
+static void adi_imu_TrackPage(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val)
+{
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        imu->activePage = ADI_IMU_PAGE_UNKNOWN;
+    }
+    else if ((pageIDRegAddr & 0xFF) == (PAGE_ID_REG & 0xFF))
+    {
+        imu->activePage = (val & 0xFF);
+    }
+}
+#endif
+
+/** 
+ * @brief Write a single register to the IMU
+ * 
+ * @param imu A pointer to the device context
  * 
  * @param pageIDRegAddr The register location to be written to
  * 
@@ -43,39 +539,42 @@ adi_imu_Status adi_imu_Init()
  * 
  * This function writes a 16-bit word (split into two 8-bit bytes) into the requested register
  * location and the adjacent location. If support for paged IMUs is compiled, a write 
- * to PAGE_ID is automatically appended to the transaction. 
+ * to PAGE_ID is prepended to the transaction when the register is not on the active page. 
  **/
-adi_imu_Status adi_imu_WriteReg(uint16_t pageIDRegAddr, uint16_t val)
+adi_imu_Status adi_imu_WriteReg(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val)
 {
+    uint16_t len = 0;
 
 #if SUPPORTS_PAGES
-    /* Append page write to message */
-    txBuf[0] = (0x80 | PAGE_ID_REG & 0xFF);
-    txBuf[1] = ((pageIDRegAddr >> 8) & 0xFF);
-    /* Prepare the tx buffer */
-    txBuf[2] = (0x80 | (pageIDRegAddr & 0xFF));
-    txBuf[3] = (val & 0xFF);
-    txBuf[4] = (0x80 | ((pageIDRegAddr & 0xFF) + 1));
-    txBuf[5] = ((val >> 8) & 0xFF);
-    /* Transmit tx buffer */
-    status = spi_Transfer(txBuf, rxBuf, 6, 16, STALL_TIME_US);
-#else
+    /* Select the page only if it is not already active */
+    len = adi_imu_QueuePageSelect(imu, len, pageIDRegAddr);
+#endif
     /* Prepare the tx buffer */
-    txBuf[0] = (0x80 | (pageIDRegAddr & 0xFF));
-    txBuf[1] = (val & 0xFF);
-    txBuf[2] = (0x80 | ((pageIDRegAddr & 0xFF) + 1));
-    txBuf[3] = ((val >> 8) & 0xFF);
+    imu->txBuf[len] = (0x80 | (pageIDRegAddr & 0xFF));
+    imu->txBuf[len + 1] = (val & 0xFF);
+    imu->txBuf[len + 2] = (0x80 | ((pageIDRegAddr & 0xFF) + 1));
+    imu->txBuf[len + 3] = ((val >> 8) & 0xFF);
     /* Transmit tx buffer */
-    status = spi_Transfer(txBuf, rxBuf, 4, 16, STALL_TIME_US);
+    imu->status = adi_imu_Transfer(imu, len + 4);
+#if SUPPORTS_PAGES
+    adi_imu_TrackPage(imu, pageIDRegAddr, val);
+#endif
+#if ENABLE_REG_CACHE
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        adi_imu_CacheWrite(imu, pageIDRegAddr, val);
+    }
 #endif
 
-    return status;
+    return INSTR_RETURN(WRITE_REG, imu->status);
 }
 
 
 /** 
  * @brief Read a single register from the IMU
  * 
+ * @param imu A pointer to the device context
+ * 
  * @param pageIDRegAddr The register localtion to be read from
  * 
  * @param val A pointer to the data read back from the sensor
@@ -83,47 +582,170 @@ adi_imu_Status adi_imu_WriteReg(uint16_t pageIDRegAddr, uint16_t val)
  * @return A status code indicating the success of the SPI transaction
  * 
  * This function reads a register location and places the resultant data in the location
- * provided. If support for paged IMUs is compiled, a write to PAGE_ID is automatically appended
- * to the transaction. 
+ * provided. If support for paged IMUs is compiled, a write to PAGE_ID is prepended to the
+ * transaction when the register is not on the active page. Registers listed in the family REG_CACHE_TABLE are served from the shadow
+ * cache once their value is known.
  **/
-adi_imu_Status adi_imu_ReadReg(uint16_t pageIDRegAddr, uint16_t *val)
+adi_imu_Status adi_imu_ReadReg(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t *val)
 {
+    uint16_t len = 0;
+
+#if ENABLE_REG_CACHE
+    /* Identification and configuration registers cost no bus time once known */
+    if (adi_imu_CacheRead(imu, pageIDRegAddr, val))
+    {
+        imu->status = ADI_IMU_SUCCESS;
+        return INSTR_RETURN(READ_REG, imu->status);
+    }
+#endif
 
 #if SUPPORTS_PAGES
-    /* Append page write to message */
-    txBuf[0] = (0x80 | PAGE_ID_REG & 0xFF);
-    txBuf[1] = ((pageIDRegAddr >> 8) & 0xFF);
-    /* Prepare the tx buffer */
-    txBuf[2] = (pageIDRegAddr & 0xFF);
-    txBuf[3] = 0x00;
-    txBuf[4] = 0x00;
-    txBuf[5] = 0x00;
-    /* Transmit tx buffer */
-    status = spi_Transfer(txBuf, rxBuf, 6, 16, STALL_TIME_US);
-#else
+    /* Select the page only if it is not already active */
+    len = adi_imu_QueuePageSelect(imu, len, pageIDRegAddr);
+#endif
     /* Prepare the tx buffer */
-    txBuf[0] = (pageIDRegAddr & 0xFF);
-    txBuf[1] = 0x00;
-    txBuf[2] = 0x00;
-    txBuf[3] = 0x00;
+    imu->txBuf[len] = (pageIDRegAddr & 0xFF);
+    imu->txBuf[len + 1] = 0x00;
+    imu->txBuf[len + 2] = 0x00;
+    imu->txBuf[len + 3] = 0x00;
     /* Transmit tx buffer */
-    status = spi_Transfer(txBuf, rxBuf, 4, 16, STALL_TIME_US);
+    imu->status = adi_imu_Transfer(imu, len + 4);
+
+    /* Combine bytes into word response. The response to the read is clocked out by the following word */
+    *val = ((imu->rxBuf[len + 2] << 8) | imu->rxBuf[len + 3]);
+#if SUPPORTS_PAGES
+    adi_imu_TrackPage(imu, pageIDRegAddr, *val);
+#endif
+#if ENABLE_REG_CACHE
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        adi_imu_CacheFill(imu, pageIDRegAddr, *val);
+    }
 #endif
 
-    /* Combine bytes into word response */
-    *val = ((rxBuf[2] << 8) | rxBuf[3]);
+    return INSTR_RETURN(READ_REG, imu->status);
 
-    return status;
+}
+
+
+/* Marks a frame whose response carries no register data */
+#define READ_BATCH_NO_DEST          0xFFFFFFFFUL
+
+/* Frames which fit in one register transaction */
+#define READ_BATCH_FRAMES           (SPI_BUFF_SIZE / 2)
+
+/* State of a chunked register array read */
+typedef struct {
+    uint16_t *outData;                      /* Caller buffer the responses are streamed into */
+    uint16_t frames;                        /* Frames queued in the device tx buffer */
+    uint32_t dest[READ_BATCH_FRAMES];       /* Output index of the response clocked out by each queued frame */
+    uint32_t pendingDest;                   /* Output index of the read issued by the last queued frame */
+} adi_imu_ReadBatch;
+
+/** 
+ * @brief Transmits the queued frames and scatters the responses into the output buffer.
+ * 
+ * @return A status code indicating the success of the SPI transaction
+ **/
+static adi_imu_Status adi_imu_ReadBatchFlush(adi_imu_Device *imu, adi_imu_ReadBatch *batch)
+{
+    if (batch->frames == 0)
+    {
+        return ADI_IMU_SUCCESS;
+    }
+    imu->status = adi_imu_Transfer(imu, batch->frames * 2);
+#if SUPPORTS_PAGES
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        imu->activePage = ADI_IMU_PAGE_UNKNOWN;
+    }
+#endif
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        for (uint16_t i = 0; i < batch->frames; i++)
+        {
+            if (batch->dest[i] != READ_BATCH_NO_DEST)
+            {
+                batch->outData[batch->dest[i]] = (imu->rxBuf[i * 2] << 8) | imu->rxBuf[i * 2 + 1];
+            }
+        }
+    }
+    batch->frames = 0;
+
+    return imu->status;
+}
+
+/** 
+ * @brief Queues one frame of a register array read, transmitting the queue when it is full.
+ * 
+ * @param cmd The command word clocked out by the frame
+ * 
+ * @param dest The output index of the register read by this frame, or READ_BATCH_NO_DEST for a write
+ * 
+ * @return A status code indicating the success of the SPI transaction
+ * 
+ * Each frame clocks out the response to the previous frame, so the response is tagged with the output index
+ * of the read issued one frame earlier. This also holds across transactions, since the IMU keeps the last
+ * response while chip select is high.
+ **/
+static adi_imu_Status adi_imu_ReadBatchPush(adi_imu_Device *imu, adi_imu_ReadBatch *batch, uint16_t cmd, uint32_t dest)
+{
+    imu->txBuf[batch->frames * 2] = ((cmd >> 8) & 0xFF);
+    imu->txBuf[batch->frames * 2 + 1] = (cmd & 0xFF);
+    batch->dest[batch->frames] = batch->pendingDest;
+    batch->pendingDest = dest;
+    batch->frames++;
+    if (batch->frames == READ_BATCH_FRAMES)
+    {
+        return adi_imu_ReadBatchFlush(imu, batch);
+    }
 
+    return ADI_IMU_SUCCESS;
 }
 
+/** 
+ * @brief Queues the reads of every listed register located on one page.
+ * 
+ * @param first The index of the first register in regList located on the page
+ * 
+ * @param page The page to read from
+ * 
+ * @param base The output index of regList[0] for the current capture
+ * 
+ * @param selectPage Queue a PAGE_ID write ahead of the reads
+ * 
+ * @return A status code indicating the success of the SPI transaction
+ **/
+#if SUPPORTS_PAGES
+static adi_imu_Status adi_imu_ReadBatchPage(adi_imu_Device *imu, adi_imu_ReadBatch *batch, const uint16_t *regList, uint16_t numRegs, uint16_t first, uint8_t page, uint32_t base, adi_imu_Boolean selectPage)
+{
+    adi_imu_Status status = ADI_IMU_SUCCESS;
+
+    if (selectPage)
+    {
+        status = adi_imu_ReadBatchPush(imu, batch, ((0x80 | (PAGE_ID_REG & 0xFF)) << 8) | page, READ_BATCH_NO_DEST);
+        imu->activePage = page;
+    }
+    for (uint16_t i = first; (i < numRegs) && (status == ADI_IMU_SUCCESS); i++)
+    {
+        if (((regList[i] >> 8) & 0xFF) == page)
+        {
+            status = adi_imu_ReadBatchPush(imu, batch, (regList[i] & 0xFF) << 8, base + i);
+        }
+    }
+
+    return status;
+}
+#endif
 
 /** 
  * @brief Read an array of registers in full-duplex mode.
  * 
+ * @param imu A pointer to the device context
+ * 
  * @param regList A pointer to an array of registers to be read
  * 
- * @param outData A pointer to an array of data read back from the sensor corresponding to the requested register list
+ * @param outData A pointer to an array of data read back from the sensor. Must hold numRegs * timesToRead words
  * 
  * @param numRegs The number of registers contained in the array of registers
  * 
@@ -131,107 +753,242 @@ adi_imu_Status adi_imu_ReadReg(uint16_t pageIDRegAddr, uint16_t *val)
  * 
  * @return A status code indicating the success of the SPI transaction
  * 
- * This function reads an arbitrary array of registers and returns an array of data corresponding to the 
- * requested register list. The list is processed in the order the registers are stored within the array. 
- * If support for paged IMUs is compiled and the register list contains registers located on
- * different pages, writes to the PAGE_ID register are automatically inserted in the SPI transaction. 
- * A page write is always inserted at the beginning of the array read. Any extra SPI writes are automatically 
- * parsed out of the resultant data array.
+ * This function reads an arbitrary array of registers timesToRead times back to back. Capture n of register
+ * i is stored in outData[n * numRegs + i]. The reads are pipelined: every frame clocks out the response to the
+ * previous one, long lists are split into SPI_BUFF_SIZE transactions without breaking the pipeline, and only
+ * a single dummy frame is added at the very end. If support for paged IMUs is compiled, the registers of each
+ * capture are grouped by page, starting with the active page, so each page is selected at most once per
+ * capture. The output order always matches regList. The register shadow cache is bypassed.
  **/
-adi_imu_Status adi_imu_ReadRegArray(const uint16_t *regList, uint16_t *outData, uint16_t numRegs, uint16_t timesToRead)
+adi_imu_Status adi_imu_ReadRegArray(adi_imu_Device *imu, const uint16_t *regList, uint16_t *outData, uint16_t numRegs, uint16_t timesToRead)
 {
+    adi_imu_ReadBatch batch;
+    uint32_t base = 0;
 
-#if SUPPORTS_PAGES
-    uint8_t prevPageId = 0;
-    uint16_t txBufCnt = 0;
-    uint32_t regTracker = 0;
+    imu->status = ADI_IMU_SUCCESS;
+    batch.outData = outData;
+    batch.frames = 0;
+    batch.pendingDest = READ_BATCH_NO_DEST;
 
-    /* Iterate through each register in the list and insert page writes as needed */
-    for (uint16_t i = 0; i < numRegs; i++)
+    for (uint16_t n = 0; n < timesToRead; n++)
     {
-        /* Insert page write at the beginning of the tx buffer */
-        if (i == 0)
+#if SUPPORTS_PAGES
+        /* Registers on the active page need no page write */
+        uint16_t startPage = imu->activePage;
+
+        if (startPage != ADI_IMU_PAGE_UNKNOWN)
         {
-            txBuf[0] = (0x80 | PAGE_ID_REG & 0xFF);
-            txBuf[1] = ((regList[0] >> 8) & 0xFF);
-            /* Store the page ID */
-            prevPageId = txBuf[1];
-            /* Increment the buffer size counter */
-            txBufCnt = txBufCnt + 2;
-            /* Set the nth bit in regTracker to indicate this word had a write appended */
-            regTracker |= 1 << i;
+            imu->status = adi_imu_ReadBatchPage(imu, &batch, regList, numRegs, 0, (uint8_t) startPage, base, FALSE);
         }
-        else
+        /* Then visit every other page once, in order of first appearance */
+        for (uint16_t g = 0; (g < numRegs) && (imu->status == ADI_IMU_SUCCESS); g++)
         {
-            if (((regList[i] >> 8) & 0xFF) != prevPageId)
+            uint8_t page = ((regList[g] >> 8) & 0xFF);
+            adi_imu_Boolean visited = (page == startPage) ? TRUE : FALSE;
+
+            for (uint16_t i = 0; (i < g) && !visited; i++)
+            {
+                visited = (((regList[i] >> 8) & 0xFF) == page) ? TRUE : FALSE;
+            }
+            if (!visited)
             {
-                txBuf[txBufCnt] = (0x80 | PAGE_ID_REG & 0xFF);
-                txBuf[txBufCnt + 1] = ((regList[0] >> 8) & 0xFF);
-                /* Store the page ID */
-                prevPageId = txBuf[txBufCnt + 1];
-                /* Increment the buffer size counter */
-                txBufCnt = txBufCnt + 2;
-                /* Set the nth bit in regTracker to indicate this word had a write appended */
-                regTracker |= 1 << i;
+                imu->status = adi_imu_ReadBatchPage(imu, &batch, regList, numRegs, g, page, base, TRUE);
             }
         }
-        /* Insert data into the tx buffer */
-        txBuf[txBufCnt] = (regList[i] & 0xFF);
-        txBuf[txBufCnt + 1] = 0x00;
-        /* Increment the buffer size counter */
-        txBufCnt = txBufCnt + 2;
-    }
-    /* Append a dummy read request to the end of the array */
-    txBuf[txBufCnt] = 0x00;
-    txBuf[txBufCnt + 1] = 0x00;
-    txBufCnt = txBufCnt + 2;
-    /* Transmit the buffer */
-    status = spi_Transfer(txBuf, rxBuf, txBufCnt, 16, STALL_TIME_US);
-    /* Clear the local count variable for reuse and offset by two bytes */
-    txBufCnt = 2;
-    /* Parse and trim the rx buffer by stepping through the regTracker variable */
-    for (uint16_t i = 0; i < numRegs; i++)
-    {
-        /* If the bit is set, skip the next two bytes */
-        if (regTracker & (1<<i))
+        if (imu->status != ADI_IMU_SUCCESS)
+        {
+            return INSTR_RETURN(READ_REG_ARRAY, imu->status);
+        }
+#else
+        for (uint16_t i = 0; i < numRegs; i++)
         {
-            txBufCnt = txBufCnt + 2;
+            imu->status = adi_imu_ReadBatchPush(imu, &batch, (regList[i] & 0xFF) << 8, base + i);
+            if (imu->status != ADI_IMU_SUCCESS)
+            {
+                return INSTR_RETURN(READ_REG_ARRAY, imu->status);
+            }
         }
-        /* We know every extra transfer also included data, so pull that data into the output array */
-        outData[i] = (rxBuf[txBufCnt] << 8) | rxBuf[txBufCnt + 1]);
-        /* Increment txBufCnt */
-        txBufCnt = txBufCnt + 2;
+#endif
+        base += numRegs;
     }
 
-    return status;
+    /* Append a dummy read to clock out the final response */
+    if (batch.pendingDest != READ_BATCH_NO_DEST)
+    {
+        imu->status = adi_imu_ReadBatchPush(imu, &batch, 0x0000, READ_BATCH_NO_DEST);
+        if (imu->status != ADI_IMU_SUCCESS)
+        {
+            return INSTR_RETURN(READ_REG_ARRAY, imu->status);
+        }
+    }
 
-#else
+    return INSTR_RETURN(READ_REG_ARRAY, adi_imu_ReadBatchFlush(imu, &batch));
+}
+
+
+/** 
+ * @brief Write a list of registers in as few SPI transactions as possible.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param writes A pointer to an array of register/value pairs, written in order
+ * 
+ * @param numWrites The number of pairs in the array
+ * 
+ * @return A status code indicating the success of the SPI transaction
+ * 
+ * This function merges the writes into a single transaction, split only when SPI_BUFF_SIZE is full. If
+ * support for paged IMUs is compiled, a write to PAGE_ID is only inserted when consecutive registers are
+ * on different pages, so sorting the list by page keeps the page writes to a minimum. Register shadow
+ * cache entries are updated as the writes are sent.
+ **/
+adi_imu_Status adi_imu_WriteRegBatch(adi_imu_Device *imu, const adi_imu_RegWrite *writes, uint16_t numWrites)
+{
+    uint16_t len = 0;
 
-    /* Copy the register list to the preallocated tx buffer */
-    for (uint16_t i = 0; i < numRegs; i++)
+    imu->status = ADI_IMU_SUCCESS;
+    for (uint16_t i = 0; i < numWrites; i++)
     {
-        txBuf[i * 2] = (regList[i] & 0xFF);
-        txBuf[i * 2 + 1] = 0x00;
+        /* Flush when the next write, including a possible page write, might not fit */
+        if (len + 6 > SPI_BUFF_SIZE)
+        {
+            imu->status = adi_imu_Transfer(imu, len);
+            if (imu->status != ADI_IMU_SUCCESS)
+            {
+                break;
+            }
+            len = 0;
+        }
+#if SUPPORTS_PAGES
+        len += adi_imu_QueuePageSelect(imu, len, writes[i].pageIDRegAddr);
+#endif
+        imu->txBuf[len] = (0x80 | (writes[i].pageIDRegAddr & 0xFF));
+        imu->txBuf[len + 1] = (writes[i].val & 0xFF);
+        imu->txBuf[len + 2] = (0x80 | ((writes[i].pageIDRegAddr & 0xFF) + 1));
+        imu->txBuf[len + 3] = ((writes[i].val >> 8) & 0xFF);
+        len += 4;
+#if SUPPORTS_PAGES
+        if ((writes[i].pageIDRegAddr & 0xFF) == (PAGE_ID_REG & 0xFF))
+        {
+            imu->activePage = (writes[i].val & 0xFF);
+        }
+#endif
+#if ENABLE_REG_CACHE
+        adi_imu_CacheWrite(imu, writes[i].pageIDRegAddr, writes[i].val);
+#endif
+    }
+    if ((imu->status == ADI_IMU_SUCCESS) && (len > 0))
+    {
+        imu->status = adi_imu_Transfer(imu, len);
     }
-    /* Append an extra, dummy word to the end of the list */
-    txBuf[numRegs * 2 + 1] = 0x00;
-    txBuf[numRegs * 2 + 2] = 0x00;
-
-    /* Transmit the buffer */
-    status = spi_Transfer(txBuf, rxBuf, (numRegs * 2 + 2), 16, STALL_TIME_US);
 
-    /* Copy the rx buffer contents to the target buffer, skipping the first, garbage response */
-    for (uint16_t i = 0; i < numRegs; i++)
+    if (imu->status != ADI_IMU_SUCCESS)
     {
-        outData[i] = (rxBuf[i * 2 + 2] << 8) | rxBuf[i * 2 + 3];
+#if SUPPORTS_PAGES
+        imu->activePage = ADI_IMU_PAGE_UNKNOWN;
+#endif
+#if ENABLE_REG_CACHE
+        /* Some of the queued writes may not have reached the IMU */
+        adi_imu_CacheInvalidate(imu);
+#endif
     }
+    return INSTR_RETURN(WRITE_REG_BATCH, imu->status);
+}
 
-    return status;
+#if ENABLE_READY_POLL
+/** 
+ * @brief Waits for the IMU to finish executing a command.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param prodId The product ID the IMU returns once it is ready
+ * 
+ * @param timeoutMs The datasheet execution time of the command, in milliseconds
+ * 
+ * @return ADI_IMU_COMMAND_TIMEOUT if the IMU did not respond within timeoutMs, otherwise a status code
+ * indicating the success of the SPI transactions.
+ * 
+ * PROD_ID is read past the register shadow cache with an exponentially growing interval, starting at
+ * READY_POLL_MIN_INTERVAL_US. A busy IMU ignores the bus, so the first read which returns the product ID also
+ * proves that communication is restored. The last read is issued at timeoutMs.
+ **/
+static adi_imu_Status adi_imu_WaitReady(adi_imu_Device *imu, uint16_t prodId, uint32_t timeoutMs)
+{
+    const uint16_t prodIdReg = PRODUCT_ID_REG;
+    uint32_t remainingUs = timeoutMs * 1000;
+    uint32_t intervalUs = READY_POLL_MIN_INTERVAL_US;
+    uint16_t val;
 
-#endif
+    for (;;)
+    {
+        if (intervalUs > remainingUs)
+        {
+            intervalUs = remainingUs;
+        }
+        delay_US(intervalUs);
+        remainingUs -= intervalUs;
 
+#if SUPPORTS_PAGES
+        /* A busy IMU ignores page writes and a reset returns it to page 0 */
+        imu->activePage = ADI_IMU_PAGE_UNKNOWN;
+#endif
+        imu->status = adi_imu_ReadRegArray(imu, &prodIdReg, &val, 1, 1);
+        if ((imu->status != ADI_IMU_SUCCESS) || (val == prodId))
+        {
+            return imu->status;
+        }
+        if (remainingUs == 0)
+        {
+            imu->status = ADI_IMU_COMMAND_TIMEOUT;
+            return imu->status;
+        }
+        if (intervalUs < READY_POLL_MAX_INTERVAL_US)
+        {
+            intervalUs *= 2;
+        }
+    }
 }
+#endif
 
+/** 
+ * @brief Executes a command and waits for the IMU to complete it.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param command The command bits to be written to the command register
+ * 
+ * @param timeoutMs The datasheet execution time of the command, in milliseconds
+ * 
+ * @return A status code indicating the success of the subroutine
+ * 
+ * With ENABLE_READY_POLL the function returns as soon as the IMU responds again, and fails with
+ * ADI_IMU_COMMAND_TIMEOUT if it does not within timeoutMs. Otherwise it always waits timeoutMs.
+ **/
+static adi_imu_Status adi_imu_ExecuteCommand(adi_imu_Device *imu, uint16_t command, uint32_t timeoutMs)
+{
+#if ENABLE_READY_POLL
+    uint16_t prodId = 0;
+
+    /* Served from the register shadow cache once known */
+    imu->status = adi_imu_ReadReg(imu, PRODUCT_ID_REG, &prodId);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+#endif
+    imu->status = adi_imu_WriteReg(imu, COMMAND_REG, command);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+#if ENABLE_READY_POLL
+    return adi_imu_WaitReady(imu, prodId, timeoutMs);
+#else
+    /* Wait for the execution time specified in the datasheet */
+    delay_MS(timeoutMs);
+    return imu->status;
+#endif
+}
 
 /** 
  * @brief Executes the IMU flash memory backup routine.
@@ -240,22 +997,26 @@ adi_imu_Status adi_imu_ReadRegArray(const uint16_t *regList, uint16_t *outData,
  * 
  * This function writes the correct bit into the IMU command register to execute the flash memory backup routine.
  * This routine stores the settings located in the IMU's volatile memory into non-volatile memory to be recalled
- * next time the device is restarted.   
+ * next time the device is restarted. With ENABLE_READY_POLL the function returns as soon as the backup is
+ * complete instead of after FLASH_MEMORY_BACKUP_TIME_MS.
  **/
-adi_imu_Status adi_imu_FlashUpdate()
+adi_imu_Status adi_imu_FlashUpdate(adi_imu_Device *imu)
 {
-    /* Clear status flag */
-    status = ADI_IMU_SUCCESS;
     /* Set the flash update bit in the command register */
-    status = adi_imu_WriteReg(COMMAND_REG, BITM_COMMAND_REG_FLASH_MEM_UPD);
-    /* Wait for the execution time specified in the datasheet */
-    delay_MS(FLASH_MEMORY_BACKUP_TIME_MS);
+    imu->status = adi_imu_ExecuteCommand(imu, BITM_COMMAND_REG_FLASH_MEM_UPD, imu->model->flashBackupTimeMs);
+#if ENABLE_FIR_BANK_CACHE
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        /* The FIR coefficient banks in flash now match the shadow copies */
+        imu->firDirty = FALSE;
+    }
+#endif
 
-#if CHECK_COMS_AFTER_COMMAND
-    adi_imu_CheckComs();
+#if CHECK_COMS_AFTER_COMMAND & !ENABLE_READY_POLL
+    adi_imu_CheckComs(imu);
 #endif
 
-    return status;
+    return imu->status;
 }
 
 /** 
@@ -263,41 +1024,81 @@ adi_imu_Status adi_imu_FlashUpdate()
  * 
  * @return A status code indicating the success of the SPI transaction.
  * 
- * This function writes the correct bit into the IMU command register to trigger a software reset. 
+ * This function writes the correct bit into the IMU command register to trigger a software reset. With
+ * ENABLE_READY_POLL the function returns as soon as the IMU is back up instead of after RESET_RECOVERY_TIME_MS.
  **/
-adi_imu_Status adi_imu_SoftwareReset()
+adi_imu_Status adi_imu_SoftwareReset(adi_imu_Device *imu)
 {
-    /* Clear status flag */
-    status = ADI_IMU_SUCCESS;
     /* Set the software reset bit in the command register */
-    status = adi_imu_WriteReg(COMMAND_REG, BITM_COMMAND_REG_SOFTWARE_RST);
-    /* Wait for the execution time specified in the datasheet */
-    delay_MS(RESET_RECOVERY_TIME_MS);
+    imu->status = adi_imu_ExecuteCommand(imu, BITM_COMMAND_REG_SOFTWARE_RST, imu->model->resetRecoveryTimeMs);
+#if ENABLE_REG_CACHE
+    /* The configuration is reloaded from flash */
+    adi_imu_CacheInvalidate(imu);
+#endif
+#if SUPPORTS_PAGES
+    /* The IMU restarts on page 0, but only a completed reset says it did */
+    imu->activePage = (imu->status == ADI_IMU_SUCCESS) ? 0 : ADI_IMU_PAGE_UNKNOWN;
+#endif
+#if ENABLE_FIR_BANK_CACHE
+    if (imu->firDirty)
+    {
+        /* Uncommitted FIR coefficients were replaced by the banks stored in flash */
+        imu->firCacheValid = 0;
+        imu->firDirty = FALSE;
+    }
+#endif
 
-#if CHECK_COMS_AFTER_COMMAND
-    adi_imu_CheckComs();
+#if CHECK_COMS_AFTER_COMMAND & !ENABLE_READY_POLL
+    adi_imu_CheckComs(imu);
 #endif
 
-    return status;
+    return imu->status;
 }
 
 /** 
  * @brief Sets the IMU data output rate.
  * 
- * @return A status code indicating the success of the SPI transaction.
+ * @return ADI_IMU_INVALID_DATA_RATE if the part cannot produce the rate, otherwise a status code indicating
+ * the success of the SPI transaction.
  * 
  * This function performs the necessary calculations and writes the value to the decimation register.
+ * Parts with arbitrary decimation round the rate down to the nearest one they support. Parts which only
+ * decimate by powers of two must be given an exact rate; use adi_imu_PlanDecimation() to reach the others.
  **/
-adi_imu_Status adi_imu_SetDataRate(uint16_t dataRate)
+adi_imu_Status adi_imu_SetDataRate(adi_imu_Device *imu, uint16_t dataRate)
 {
-    status = ADI_IMU_SUCCESS;
-    /* Write the decimation setting to the part if it supports arbitrary rates */
+    uint32_t factor;
+    uint16_t regVal;
+
+    if (dataRate == 0)
+    {
+        imu->status = ADI_IMU_INVALID_DATA_RATE;
+        return imu->status;
+    }
+    factor = MAX_DATA_RATE / dataRate;
+    if ((factor == 0) || (factor > DECIMATE_MAX))
+    {
+        imu->status = ADI_IMU_INVALID_DATA_RATE;
+        return imu->status;
+    }
+
 #if SUPPORTS_ARBITRARY_DEC_RATE
-    status = adi_imu_WriteReg(DECIMATE_REG, ((MAX_DATA_RATE / dataRate) - 1));
+    regVal = (uint16_t) (factor - 1);
 #else
-    //TODO: Figure out what to do  with 2^n
+    /* The decimation register holds log2 of the factor */
+    if (((MAX_DATA_RATE % dataRate) != 0) || ((factor & (factor - 1)) != 0))
+    {
+        imu->status = ADI_IMU_INVALID_DATA_RATE;
+        return imu->status;
+    }
+    for (regVal = 0; (1UL << regVal) < factor; regVal++)
+    {
+    }
 #endif
-    return status;
+
+    /* Write the decimation setting to the part */
+    imu->status = adi_imu_WriteReg(imu, DECIMATE_REG, regVal);
+    return imu->status;
 }
 
 /** 
@@ -309,31 +1110,34 @@ adi_imu_Status adi_imu_SetDataRate(uint16_t dataRate)
  * writes a known value to the scratch register, reads that value back, and if successful, re-writes the
  * original value into the scratch register. 
  **/
-adi_imu_Status adi_imu_CheckComs()
+adi_imu_Status adi_imu_CheckComs(adi_imu_Device *imu)
 {
-    status = ADI_IMU_SUCCESS;
-    status = adi_imu_ReadReg(SCRATCH_REG, &tempRegA);
-    if (status != ADI_IMU_SUCCESS)
+    uint16_t tempRegA = 0;
+    uint16_t tempRegB = 0;
+
+    imu->status = ADI_IMU_SUCCESS;
+    imu->status = adi_imu_ReadReg(imu, SCRATCH_REG, &tempRegA);
+    if (imu->status != ADI_IMU_SUCCESS)
     {
-        return status;
+        return INSTR_RETURN(CHECK_COMS, imu->status);
     }
-    status = adi_imu_WriteReg(SCRATCH_REG, 0xA5A5);
-    if (status != ADI_IMU_SUCCESS)
+    imu->status = adi_imu_WriteReg(imu, SCRATCH_REG, 0xA5A5);
+    if (imu->status != ADI_IMU_SUCCESS)
     {
-        return status;
+        return INSTR_RETURN(CHECK_COMS, imu->status);
     }
-    status = adi_imu_ReadReg(SCRATCH_REG, &tempRegB);
-    if (status != ADI_IMU_SUCCESS)
+    imu->status = adi_imu_ReadReg(imu, SCRATCH_REG, &tempRegB);
+    if (imu->status != ADI_IMU_SUCCESS)
     {
-        return status;
+        return INSTR_RETURN(CHECK_COMS, imu->status);
     }
     if (tempRegB != 0xA5A5)
     {
-        return ADI_IMU_CHECK_SPI_COMS_FAILED;
+        return INSTR_RETURN(CHECK_COMS, ADI_IMU_CHECK_SPI_COMS_FAILED);
     }
-    status = adi_imu_WriteReg(SCRATCH_REG, tempRegA);
+    imu->status = adi_imu_WriteReg(imu, SCRATCH_REG, tempRegA);
 
-    return status;
+    return INSTR_RETURN(CHECK_COMS, imu->status);
 }
 
 /** 
@@ -344,14 +1148,16 @@ adi_imu_Status adi_imu_CheckComs()
  * This function reads the range register if the IMU supports it.
  **/
 #if SUPPORTS_RANGE_REG
-static adi_imu_Status adi_imu_GetSensorRange(adi_imu_RangeReg *range_data)
+static adi_imu_Status adi_imu_GetSensorRange(adi_imu_Device *imu, adi_imu_RangeReg *range_data)
 {
-    status = ADI_IMU_SUCCESS;
-    status = adi_imu_ReadReg(RANGE_REG, &tempRegA);
+    uint16_t tempRegA = 0;
+
+    imu->status = ADI_IMU_SUCCESS;
+    imu->status = adi_imu_ReadReg(imu, RANGE_REG, &tempRegA);
     tempRegA = tempRegA & 0x000C;
-    *range_data = tempRegA;
+    *range_data = (adi_imu_RangeReg) tempRegA;
 
-    return status;
+    return imu->status;
 }
 #endif
 
@@ -362,23 +1168,23 @@ static adi_imu_Status adi_imu_GetSensorRange(adi_imu_RangeReg *range_data)
  * 
  * This function reads the contents of several IMU registers and compiles them in a single enum.
  **/
-adi_imu_Status adi_imu_GetDeviceInfo(adi_imu_DeviceInfo *data_info)
+adi_imu_Status adi_imu_GetDeviceInfo(adi_imu_Device *imu, adi_imu_DeviceInfo *data_info)
 {
-    status = ADI_IMU_SUCCESS;
-    status = adi_imu_ReadReg(PRODUCT_ID_REG, &data_info->prodId);
-    status = adi_imu_ReadReg(FIRMWARE_REV_REG, &data_info->fwRev);
-    status = adi_imu_ReadReg(FIRMWARE_DATE_MONTH_REG, &data_info->fwDayMonth);
-    status = adi_imu_ReadReg(FIRMWARE_YEAR_REG, &data_info->fwYear);
-    status = adi_imu_ReadReg(SERIAL_NUMBER_REG, &data_info->serialNumber);
-    status = adi_imu_ReadReg(DECIMATE_REG, &data_info->decRate);
+    imu->status = ADI_IMU_SUCCESS;
+    imu->status = adi_imu_ReadReg(imu, PRODUCT_ID_REG, &data_info->prodId);
+    imu->status = adi_imu_ReadReg(imu, FIRMWARE_REV_REG, &data_info->fwRev);
+    imu->status = adi_imu_ReadReg(imu, FIRMWARE_DATE_MONTH_REG, &data_info->fwDayMonth);
+    imu->status = adi_imu_ReadReg(imu, FIRMWARE_YEAR_REG, &data_info->fwYear);
+    imu->status = adi_imu_ReadReg(imu, SERIAL_NUMBER_REG, &data_info->serialNumber);
+    imu->status = adi_imu_ReadReg(imu, DECIMATE_REG, &data_info->decRate);
 #if SUPPORTS_PAGES
-    status = adi_imu_ReadReg(PAGE_ID_REG, &data_info->activePageId);
+    imu->status = adi_imu_ReadReg(imu, PAGE_ID_REG, &data_info->activePageId);
 #endif
 #if SUPPORTS_RANGE_REG
-    status = adi_imu_GetSensorRange(&data_info->range);
+    imu->status = adi_imu_GetSensorRange(imu, &data_info->range);
 #endif
 
-    return status;
+    return imu->status;
 }
 
 /** 
@@ -389,11 +1195,11 @@ adi_imu_Status adi_imu_GetDeviceInfo(adi_imu_DeviceInfo *data_info)
  * This function sets the active IMU page.
  **/
 #if SUPPORTS_PAGES
-adi_imu_Status adi_imu_SetActivePage(uint16_t page)
+adi_imu_Status adi_imu_SetActivePage(adi_imu_Device *imu, uint16_t page)
 {
-    status = ADI_IMU_SUCCESS;
-    status = adi_imu_WriteReg(PAGE_ID_REG, page);
-    return status;
+    imu->status = ADI_IMU_SUCCESS;
+    imu->status = adi_imu_WriteReg(imu, PAGE_ID_REG, page);
+    return imu->status;
 }
 #endif
 
@@ -405,117 +1211,187 @@ adi_imu_Status adi_imu_SetActivePage(uint16_t page)
  * This function gets the active IMU page.
  **/
 #if SUPPORTS_PAGES
-adi_imu_Status adi_imu_GetActivePage(uint16_t *active_page)
+adi_imu_Status adi_imu_GetActivePage(adi_imu_Device *imu, uint16_t *active_page)
 {
-    status = ADI_IMU_SUCCESS;
-    status = adi_imu_ReadReg(PAGE_ID_REG, active_page);
-    return status;
+    imu->status = ADI_IMU_SUCCESS;
+    imu->status = adi_imu_ReadReg(imu, PAGE_ID_REG, active_page);
+    return imu->status;
 }
 #endif
 
-#if ENABLE_SCALED_DATA
-adi_imu_Status adi_imu_GetScaledSensorData(adi_imu_ScaledData *data_struct)
+/** 
+ * @brief Decodes a raw burst response into the unscaled data struct.
+ * 
+ * @param imu A pointer to the device context the burst was read from
+ * 
+ * @param burstRx A pointer to the received burst buffer, including the leading trigger response word
+ * 
+ * @param data_struct A pointer to the unscaled data struct to be populated
+ * 
+ * @return A status code indicating the success of the subroutine.
+ * 
+ * This function only parses memory and never touches the SPI bus, so it can run while the next burst
+ * is already being clocked out by an asynchronous transport. The burst is unpacked by the decoder of the model
+ * detected by adi_imu_Init(), a single indirect call. With VERIFY_BURST_CHECKSUM the checksum is
+ * accumulated while the fields are unpacked and ADI_IMU_BURST_CHECKSUM_FAILED is returned on a mismatch. The
+ * data struct is still written in that case and must be discarded by the caller.
+ **/
+adi_imu_Status adi_imu_DecodeBurst(const adi_imu_Device *imu, const uint8_t *burstRx, adi_imu_UnscaledData *data_struct)
 {
-    status = ADI_IMU_SUCCESS;
-    adi_imu_UnscaledData data;
-    status = adi_imu_GetSensorData(&data);
-    #if SUPPORTS_32BIT & ENABLE_32BIT_DATA
-        // use 32-bit scale factors
-
-    #else
-        // use 16-bit scale factors
+#if ENABLE_BURST_MODE
+    adi_imu_Status status;
 
-    #endif
+    INSTR_TIMESTAMP(decodeStart);
+    status = imu->model->decodeBurst(burstRx, data_struct);
+    INSTR_DECODE_DONE(decodeStart);
 
     return status;
-}
+#else
+    (void) imu;
+    (void) burstRx;
+    (void) data_struct;
+    return ADI_IMU_BURST_NOT_SUPPORTED;
 #endif
+}
 
-adi_imu_Status adi_imu_GetSensorData(adi_imu_UnscaledData *data_struct)
+/** 
+ * @brief Starts a burst read without waiting for it to complete.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param xfer A pointer to the transfer descriptor. txBuf and rxBuf must hold at least BURST_XFER_LENGTH bytes
+ * 
+ * @param callback The function to be called once the burst has been received. May be NULL
+ * 
+ * @param context An opaque pointer stored in the descriptor for use by the callback
+ * 
+ * @return A status code indicating the success of the submission.
+ * 
+ * This function builds the burst trigger in xfer->txBuf and submits it to the transport. The transfer is as long
+ * as the burst of the detected model, which may be shorter than BURST_XFER_LENGTH. On a paged family the page
+ * of the burst trigger is selected first, with a blocking register write, unless it is already active. The
+ * caller owns both buffers again once the callback runs or adi_imu_TransferDone() reports completion, at which
+ * point the response can be parsed with adi_imu_DecodeBurst().
+ **/
+adi_imu_Status adi_imu_SubmitBurst(adi_imu_Device *imu, adi_imu_SpiXfer *xfer, adi_imu_SpiCallback callback, void *context)
 {
-    status = ADI_IMU_SUCCESS;
 #if ENABLE_BURST_MODE
-    #if ENABLE_32_BIT_BURST_MODE & SUPPORTS_32BIT_BURST
-        // TODO: Do I need to write the page ID here?
-        /* Build the tx array */
-        txBuf[0] = (BURST_TRIGGER_REG & 0xFF);
-        txBuf[1] = 0x00;
-        for (uint16_t i = 0; i < BURST_BYTE_LENGTH; i++)
-        {
-            txBuf[i + 2] = 0x00;
-        }
-        /* Transmit txBuf and store the response in rxBuf */
-        status = spi_Transfer(txBuf, rxBuf, (BURST_BYTE_LENGTH + 2), (BURST_BYTE_LENGTH + 2), STALL_TIME_US);
-        /* Push the rxBuf data into the data output struct */
-        #if SUPPORTS_BURST_STATUS
-            data_struct->status = (uint32_t) (IMU_GET_16BITS(rxBuf, STATUS_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if SUPPORTS_BURST_CNT
-            data_struct->count = (uint32_t) (IMU_GET_16BITS(rxBuf, COUNT_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        data_struct->xg = (int32_t) (IMU_GET_32BITS(rxBuf, XG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->yg = (int32_t) (IMU_GET_32BITS(rxBuf, YG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->zg = (int32_t) (IMU_GET_32BITS(rxBuf, ZG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->xa = (int32_t) (IMU_GET_32BITS(rxBuf, XA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->ya = (int32_t) (IMU_GET_32BITS(rxBuf, YA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->za = (int32_t) (IMU_GET_32BITS(rxBuf, ZA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->temperature = (int32_t) (IMU_GET_16BITS(rxBuf, TEMP_OUT_INDEX + BURST_PAYLOAD_OFFSET));
-        #if ENABLE_MAGNETOMETER
-            data_struct->xm = (int32_t) (IMU_GET_16BITS(rxBuf, XM_INDEX + BURST_PAYLOAD_OFFSET));
-            data_struct->ym = (int32_t) (IMU_GET_16BITS(rxBuf, YM_INDEX + BURST_PAYLOAD_OFFSET));
-            data_struct->zm = (int32_t) (IMU_GET_16BITS(rxBuf, ZM_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if ENABLE_BAROMETER
-            data_struct->baro = (int32_t) (IMU_GET_16BITS(rxBuf, BARO_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if SUPPORTS_BURST_CHECKSUM_CRC
-            data_struct->chksm_crc = (uint32_t) (IMU_GET_32BITS(rxBuf, CHECKSUM_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-
-    #else
-        // TODO: Do I need to write the page ID here?
-        /* Build the tx array */
-        txBuf[0] = (BURST_TRIGGER_REG & 0xFF);
-        txBuf[1] = 0x00;
-        for (uint16_t i = 0; i < BURST_BYTE_LENGTH; i++)
+#if SUPPORTS_PAGES
+    /* The burst trigger is only decoded on its own page. Select it through the page tracker */
+    if (imu->activePage != ((BURST_TRIGGER_REG >> 8) & 0xFF))
+    {
+        imu->status = adi_imu_WriteReg(imu, PAGE_ID_REG, (BURST_TRIGGER_REG >> 8) & 0xFF);
+        if (imu->status != ADI_IMU_SUCCESS)
         {
-            txBuf[i + 2] = 0x00;
+            return imu->status;
         }
-        /* Transmit txBuf and store the response in rxBuf */
-        status = spi_Transfer(txBuf, rxBuf, (BURST_BYTE_LENGTH + 2), (BURST_BYTE_LENGTH + 2), STALL_TIME_US);
-        /* Push the rxBuf data into the data output struct */
-        #if SUPPORTS_BURST_STATUS
-            data_struct->status = (uint32_t) (IMU_GET_16BITS(rxBuf, STATUS_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if SUPPORTS_BURST_CNT
-            data_struct->count = (uint32_t) (IMU_GET_16BITS(rxBuf, COUNT_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        data_struct->xg = (int32_t) (IMU_GET_16BITS(rxBuf, XG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->yg = (int32_t) (IMU_GET_16BITS(rxBuf, YG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->zg = (int32_t) (IMU_GET_16BITS(rxBuf, ZG_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->xa = (int32_t) (IMU_GET_16BITS(rxBuf, XA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->ya = (int32_t) (IMU_GET_16BITS(rxBuf, YA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->za = (int32_t) (IMU_GET_16BITS(rxBuf, ZA_INDEX + BURST_PAYLOAD_OFFSET));
-        data_struct->temperature = (int16_t) (IMU_GET_16BITS(rxBuf, TEMP_OUT_INDEX + BURST_PAYLOAD_OFFSET));
-        #if ENABLE_MAGNETOMETER
-            data_struct->xm = (int32_t) (IMU_GET_16BITS(rxBuf, XM_INDEX + BURST_PAYLOAD_OFFSET));
-            data_struct->ym = (int32_t) (IMU_GET_16BITS(rxBuf, YM_INDEX + BURST_PAYLOAD_OFFSET));
-            data_struct->zm = (int32_t) (IMU_GET_16BITS(rxBuf, ZM_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if ENABLE_BAROMETER
-            data_struct->baro = (int32_t) (IMU_GET_16BITS(rxBuf, BARO_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-        #if SUPPORTS_BURST_CHECKSUM_CRC
-            data_struct->chksm_crc = (uint32_t) (IMU_GET_16BITS(rxBuf, CHECKSUM_INDEX + BURST_PAYLOAD_OFFSET));
-        #endif
-    #endif
+    }
+#endif
+    /* Build the tx array */
+    xfer->txBuf[0] = (BURST_TRIGGER_REG & 0xFF);
+    xfer->txBuf[1] = 0x00;
+    for (uint16_t i = 2; i < imu->model->burstXferLength; i++)
+    {
+        xfer->txBuf[i] = 0x00;
+    }
+    xfer->csPin = imu->csPin;
+    xfer->xferLen = imu->model->burstXferLength;
+    xfer->wordLen = imu->model->burstXferLength;
+    xfer->stallTime = imu->model->stallTimeUs;
+    xfer->callback = callback;
+    xfer->context = context;
+
+    return adi_imu_SubmitTransfer(xfer);
 #else
-    #if ENABLE_32BIT_DATA & SUPPORTS_32BIT_REGS
-        //32-bit regular reads
-    #else
-        // 16-bit regular reads
-    #endif
+    (void) imu;
+    (void) xfer;
+    (void) callback;
+    (void) context;
+    return ADI_IMU_BURST_NOT_SUPPORTED;
 #endif
+}
 
-    return status;
+#if !ENABLE_BURST_MODE & SUPPORTS_INERTIAL_DATA
+/* Word index of each field in the register-read response. REG_S32 fields take two words */
+#define REG_U16_SLOTS(field)        REGREAD_IDX_##field,
+#define REG_S16_SLOTS(field)        REGREAD_IDX_##field,
+#define REG_S32_SLOTS(field)        REGREAD_IDX_##field, REGREAD_IDX_##field##_OUT,
+#define REGREAD_SLOTS(field, reg, decode)   decode##_SLOTS(field)
+enum {
+    REGREAD_LAYOUT(REGREAD_SLOTS)
+    REGREAD_WORDS
+};
+#undef REGREAD_SLOTS
+
+/* Registers read per sample, in response order */
+#define REG_U16_REGS(reg)           reg,
+#define REG_S16_REGS(reg)           reg,
+#define REG_S32_REGS(reg)           reg, (reg) + 2,
+#define REGREAD_REGS(field, reg, decode)    decode##_REGS(reg)
+static const uint16_t adi_imu_RegReadList[REGREAD_WORDS] = {
+    REGREAD_LAYOUT(REGREAD_REGS)
+};
+#undef REGREAD_REGS
+#endif
+
+/** 
+ * @brief Reads one sample of every sensor output.
+ * 
+ * @param imu A pointer to the device context
+ * 
+ * @param data_struct A pointer to the sample to be populated
+ * 
+ * @return A status code indicating the success of the subroutine.
+ * 
+ * With ENABLE_BURST_MODE the sample is read with a single burst. Otherwise every register of the family
+ * REGREAD_LAYOUT table is read in one pipelined adi_imu_ReadRegArray() transaction, so the response to each
+ * read is clocked out by the next one and the only extra frame is the final dummy read. 32-bit outputs are
+ * assembled from their *_LOW and *_OUT words. Call it right after data ready: the registers are read one by one,
+ * so a transaction which straddles an output update mixes two samples.
+ **/
+adi_imu_Status adi_imu_GetSensorData(adi_imu_Device *imu, adi_imu_UnscaledData *data_struct)
+{
+    imu->status = ADI_IMU_SUCCESS;
+#if ENABLE_BURST_MODE
+    /* Private burst buffers so concurrent pipelines or register accesses are never corrupted */
+    uint8_t burstTx[BURST_XFER_LENGTH];
+    uint8_t burstRx[BURST_XFER_LENGTH];
+    adi_imu_SpiXfer xfer;
+
+    xfer.txBuf = burstTx;
+    xfer.rxBuf = burstRx;
+    /* Transmit txBuf and store the response in rxBuf */
+    imu->status = adi_imu_SubmitBurst(imu, &xfer, 0, 0);
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->status = adi_imu_WaitTransfer(&xfer);
+    }
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return INSTR_RETURN(GET_SENSOR_DATA, imu->status);
+    }
+    imu->status = adi_imu_DecodeBurst(imu, burstRx, data_struct);
+#if VERIFY_BURST_CHECKSUM
+    if (imu->status == ADI_IMU_BURST_CHECKSUM_FAILED)
+    {
+        imu->checksumErrors++;
+    }
+#endif
+#elif SUPPORTS_INERTIAL_DATA
+    /* One pipelined transaction over every output register, decoded through the family layout table */
+    uint16_t words[REGREAD_WORDS];
+
+    imu->status = adi_imu_ReadRegArray(imu, adi_imu_RegReadList, words, REGREAD_WORDS, 1);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return INSTR_RETURN(GET_SENSOR_DATA, imu->status);
+    }
+    #define REGREAD_DECODE_FIELD(field, reg, decode)    data_struct->field = decode(words, REGREAD_IDX_##field);
+    REGREAD_LAYOUT(REGREAD_DECODE_FIELD)
+    #undef REGREAD_DECODE_FIELD
+#else
+    (void) data_struct;
+#endif
+
+    return INSTR_RETURN(GET_SENSOR_DATA, imu->status);
 }
@@ -0,0 +1,170 @@
+/**
+  * @file	    adi_imu_cache.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Register shadow cache for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if ENABLE_REG_CACHE
+
+/* regCacheValid holds one bit per entry */
+typedef char adi_imu_RegCacheSizeCheck[(REG_CACHE_ENTRIES <= 32) ? 1 : -1];
+
+/* Per-entry policies, in REG_CACHE_TABLE order */
+#define REG_CACHE_POLICY(reg, policy)       policy,
+static const adi_imu_CachePolicy adi_imu_RegCachePolicy[REG_CACHE_ENTRIES] = {
+    REG_CACHE_TABLE(REG_CACHE_POLICY)
+};
+#undef REG_CACHE_POLICY
+
+/**
+ * @brief Maps a register address to its shadow cache entry.
+ *
+ * @param pageIDRegAddr The page/address encoded register location.
+ *
+ * @return The cache entry index, or REG_CACHE_ENTRIES if the register is volatile.
+ **/
+static uint8_t adi_imu_CacheIndex(uint16_t pageIDRegAddr)
+{
+    switch (pageIDRegAddr)
+    {
+    #define REG_CACHE_CASE(reg, policy)     case reg: return REG_CACHE_IDX_##reg;
+        REG_CACHE_TABLE(REG_CACHE_CASE)
+    #undef REG_CACHE_CASE
+    default:
+        return REG_CACHE_ENTRIES;
+    }
+}
+
+/**
+ * @brief Drops every shadow register and clears the cache statistics.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_CacheReset(adi_imu_Device *imu)
+{
+    imu->regCacheValid = 0;
+    imu->cacheStats.hits = 0;
+    imu->cacheStats.misses = 0;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Drops every shadow register which may have changed on the IMU.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * Immutable entries are kept. Call this after anything that changes the IMU configuration behind the
+ * driver's back, such as a reset, a factory calibration restore or a write through another interface.
+ **/
+adi_imu_Status adi_imu_CacheInvalidate(adi_imu_Device *imu)
+{
+    for (uint8_t i = 0; i < REG_CACHE_ENTRIES; i++)
+    {
+        if (adi_imu_RegCachePolicy[i] != CACHE_IMMUTABLE)
+        {
+            imu->regCacheValid &= ~(1UL << i);
+        }
+    }
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Looks up a register in the shadow cache.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param pageIDRegAddr The page/address encoded register location.
+ *
+ * @param val A pointer set to the cached value on a hit.
+ *
+ * @return TRUE if the value was served from the cache.
+ **/
+adi_imu_Boolean adi_imu_CacheRead(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t *val)
+{
+    uint8_t idx = adi_imu_CacheIndex(pageIDRegAddr);
+
+    if (idx == REG_CACHE_ENTRIES)
+    {
+        return FALSE;
+    }
+    if (!(imu->regCacheValid & (1UL << idx)))
+    {
+        imu->cacheStats.misses++;
+        return FALSE;
+    }
+    imu->cacheStats.hits++;
+    *val = imu->regCache[idx];
+
+    return TRUE;
+}
+
+/**
+ * @brief Records a value read from the IMU in the shadow cache.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param pageIDRegAddr The page/address encoded register location.
+ *
+ * @param val The value read from the IMU.
+ **/
+void adi_imu_CacheFill(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val)
+{
+    uint8_t idx = adi_imu_CacheIndex(pageIDRegAddr);
+
+    if (idx != REG_CACHE_ENTRIES)
+    {
+        imu->regCache[idx] = val;
+        imu->regCacheValid |= (1UL << idx);
+    }
+}
+
+/**
+ * @brief Records a value written to the IMU in the shadow cache.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param pageIDRegAddr The page/address encoded register location.
+ *
+ * @param val The value written to the IMU.
+ *
+ * Only write-through entries are updated. Immutable registers are read-only on the IMU, so a write to one
+ * leaves its shadow copy untouched.
+ **/
+void adi_imu_CacheWrite(adi_imu_Device *imu, uint16_t pageIDRegAddr, uint16_t val)
+{
+    uint8_t idx = adi_imu_CacheIndex(pageIDRegAddr);
+
+    if ((idx != REG_CACHE_ENTRIES) && (adi_imu_RegCachePolicy[idx] == CACHE_WRITE_THROUGH))
+    {
+        imu->regCache[idx] = val;
+        imu->regCacheValid |= (1UL << idx);
+    }
+}
+
+/**
+ * @brief Gets the shadow cache hit and miss counters.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param stats A pointer to the statistics struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_GetCacheStats(adi_imu_Device *imu, adi_imu_CacheStats *stats)
+{
+    *stats = imu->cacheStats;
+
+    return ADI_IMU_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,190 @@
+/**
+  * @file	    adi_imu_capture.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Capture buffer and record download engine for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "spi_driver.h"
+
+#if SUPPORTS_CAPTURE
+
+/**
+ * @brief Selects the record mode used by the next capture.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param mode The record mode. FFT modes fill the buffers with CAPTURE_FFT_BINS magnitudes per axis, the
+ * manual time mode with CAPTURE_TIME_SAMPLES samples per axis.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * Only the mode field of REC_CTRL is changed.
+ **/
+adi_imu_Status adi_imu_SetRecordMode(adi_imu_Device *imu, adi_imu_RecordMode mode)
+{
+    uint16_t recCtrl;
+
+    imu->status = adi_imu_ReadReg(imu, REG_REC_CTRL, &recCtrl);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    recCtrl = (recCtrl & ~BITM_REC_CTRL_REG_MODE) | ((mode << BITP_REC_CTRL_REG_MODE) & BITM_REC_CTRL_REG_MODE);
+
+    return adi_imu_WriteReg(imu, REG_REC_CTRL, recCtrl);
+}
+
+/**
+ * @brief Starts a capture.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function latches the record counter and sets the capture bit in the command register, then returns
+ * immediately. Use adi_imu_WaitCapture() to wait for the record to complete.
+ **/
+adi_imu_Status adi_imu_StartCapture(adi_imu_Device *imu)
+{
+    imu->status = adi_imu_ReadReg(imu, REG_REC_CNTR, &imu->recordCount);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    return adi_imu_WriteReg(imu, COMMAND_REG, BITM_COMMAND_REG_CAPTURE);
+}
+
+/**
+ * @brief Waits for the capture started by adi_imu_StartCapture() to complete.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param timeoutMs The maximum time to wait, in milliseconds.
+ *
+ * @return ADI_IMU_CAPTURE_TIMEOUT if the record counter did not advance in time, otherwise a status code
+ * indicating the success of the subroutine.
+ *
+ * The record counter is polled every CAPTURE_POLL_INTERVAL_MS. A capture is complete as soon as the counter
+ * differs from the value latched when it was started.
+ **/
+adi_imu_Status adi_imu_WaitCapture(adi_imu_Device *imu, uint32_t timeoutMs)
+{
+    uint16_t recCntr;
+
+    for (uint32_t waited = 0; waited <= timeoutMs; waited += CAPTURE_POLL_INTERVAL_MS)
+    {
+        imu->status = adi_imu_ReadReg(imu, REG_REC_CNTR, &recCntr);
+        if (imu->status != ADI_IMU_SUCCESS)
+        {
+            return imu->status;
+        }
+        if (recCntr != imu->recordCount)
+        {
+            return imu->status;
+        }
+        delay_MS(CAPTURE_POLL_INTERVAL_MS);
+    }
+
+    imu->status = ADI_IMU_CAPTURE_TIMEOUT;
+    return imu->status;
+}
+
+/**
+ * @brief Loads a stored record into the capture buffers.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param record The index of the stored record.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_LoadRecord(adi_imu_Device *imu, uint16_t record)
+{
+    return adi_imu_WriteReg(imu, REG_REC_PNTR, record);
+}
+
+/**
+ * @brief Downloads part of one axis of the capture buffers.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param axis The axis to be read.
+ *
+ * @param start The index of the first buffer entry to be read.
+ *
+ * @param count The number of buffer entries to be read. outData must hold at least this many words.
+ *
+ * @param outData A pointer to the array of buffer entries to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function points BUF_PNTR at start and then reads the axis buffer register count times through
+ * adi_imu_ReadRegArray(). Every frame carries a read, the pipeline runs unbroken across transactions and only
+ * one dummy frame is added at the end, so the download runs at close to one entry per SPI frame. The number
+ * of frames per transaction is set by SPI_BUFF_SIZE; increase it to cut the per-transaction overhead further.
+ **/
+adi_imu_Status adi_imu_ReadCaptureBuffer(adi_imu_Device *imu, adi_imu_CaptureAxis axis, uint16_t start, uint16_t count, uint16_t *outData)
+{
+    uint16_t bufReg = CAPTURE_BUF_REG(axis);
+
+    if (count == 0)
+    {
+        imu->status = ADI_IMU_SUCCESS;
+        return imu->status;
+    }
+
+    imu->status = adi_imu_WriteReg(imu, REG_BUF_PNTR, start);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    return adi_imu_ReadRegArray(imu, &bufReg, outData, 1, count);
+}
+
+/**
+ * @brief Captures a record and downloads every axis.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param timeoutMs The maximum time to wait for the capture, in milliseconds.
+ *
+ * @param samplesPerAxis The number of buffer entries to download per axis.
+ *
+ * @param outData A pointer to an array of CAPTURE_AXES * samplesPerAxis words. Entry i of axis a is stored
+ * in outData[a * samplesPerAxis + i].
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * The capture uses the record mode currently set in REC_CTRL. See adi_imu_SetRecordMode().
+ **/
+adi_imu_Status adi_imu_CaptureRecord(adi_imu_Device *imu, uint32_t timeoutMs, uint16_t samplesPerAxis, uint16_t *outData)
+{
+    imu->status = adi_imu_StartCapture(imu);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    imu->status = adi_imu_WaitCapture(imu, timeoutMs);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    for (uint8_t axis = 0; axis < CAPTURE_AXES; axis++)
+    {
+        imu->status = adi_imu_ReadCaptureBuffer(imu, (adi_imu_CaptureAxis) axis, 0, samplesPerAxis, &outData[(uint32_t) axis * samplesPerAxis]);
+        if (imu->status != ADI_IMU_SUCCESS)
+        {
+            return imu->status;
+        }
+    }
+
+    return imu->status;
+}
+
+#endif
@@ -0,0 +1,370 @@
+/**
+  * @file	    adi_imu_decim.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Output rate planning and host-side CIC decimation for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if ENABLE_DECIMATION
+
+/* Largest gain a decimator may carry, so a full-scale 32-bit input cannot overflow the 64-bit stages */
+#define DECIM_MAX_GAIN              (1ULL << 32)
+
+/**
+ * @brief Returns the greatest common divisor of a and b.
+ **/
+static uint16_t adi_imu_DecimGcd(uint16_t a, uint16_t b)
+{
+    uint16_t t;
+
+    while (b != 0)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+#if !SUPPORTS_ARBITRARY_DEC_RATE | SUPPORTS_BARTLETT_FILTER
+/**
+ * @brief Returns floor(log2(val)) for a non-zero val.
+ **/
+static uint16_t adi_imu_DecimLog2(uint32_t val)
+{
+    uint16_t n = 0;
+
+    while (val > 1)
+    {
+        val >>= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/**
+ * @brief Splits the decimation for a set of output rates between the IMU and the host.
+ *
+ * @param rates A pointer to the requested output rates, in Hz. Each must divide MAX_DATA_RATE.
+ *
+ * @param numRates The number of requested rates, up to DECIM_MAX_OUTPUTS.
+ *
+ * @param plan A pointer to the plan to be populated.
+ *
+ * @return ADI_IMU_INVALID_DATA_RATE if a rate cannot be produced, ADI_IMU_SUCCESS otherwise.
+ *
+ * The IMU does as much of the decimation as it can, which keeps the SPI traffic and the host filtering to
+ * the minimum: the on-chip factor is the largest one the part supports which divides every requested
+ * decimation, and the host decimators make up the rest. A single rate the part can produce natively needs
+ * no host stage (host factor 1). The Bartlett filter is sized so its first null lands at or above the
+ * fastest requested rate, attenuating what would alias onto it without narrowing any output further.
+ **/
+adi_imu_Status adi_imu_PlanDecimation(const uint16_t *rates, uint8_t numRates, adi_imu_DecimationPlan *plan)
+{
+    uint16_t ratios[DECIM_MAX_OUTPUTS];
+    uint16_t common = 0;
+    uint16_t factor;
+
+    if ((numRates == 0) || (numRates > DECIM_MAX_OUTPUTS))
+    {
+        return ADI_IMU_INVALID_DATA_RATE;
+    }
+    for (uint8_t i = 0; i < numRates; i++)
+    {
+        if ((rates[i] == 0) || (rates[i] > MAX_DATA_RATE) || ((MAX_DATA_RATE % rates[i]) != 0))
+        {
+            return ADI_IMU_INVALID_DATA_RATE;
+        }
+        ratios[i] = (uint16_t) (MAX_DATA_RATE / rates[i]);
+        common = adi_imu_DecimGcd(common, ratios[i]);
+    }
+
+    /* Largest supported on-chip factor dividing every ratio. 1 always qualifies */
+#if SUPPORTS_ARBITRARY_DEC_RATE
+    factor = (common < DECIMATE_MAX) ? common : DECIMATE_MAX;
+    while ((common % factor) != 0)
+    {
+        factor--;
+    }
+#else
+    factor = common & (uint16_t) -common;
+    while (factor > DECIMATE_MAX)
+    {
+        factor >>= 1;
+    }
+#endif
+
+    for (uint8_t i = 0; i < numRates; i++)
+    {
+        adi_imu_Decimator probe;
+
+        plan->hostFactor[i] = ratios[i] / factor;
+        if (adi_imu_DecimatorInit(&probe, plan->hostFactor[i]) != ADI_IMU_SUCCESS)
+        {
+            return ADI_IMU_INVALID_DATA_RATE;
+        }
+    }
+    plan->numOutputs = numRates;
+    plan->deviceFactor = factor;
+#if SUPPORTS_ARBITRARY_DEC_RATE
+    plan->decimate = factor - 1;
+#else
+    plan->decimate = adi_imu_DecimLog2(factor);
+#endif
+#if SUPPORTS_BARTLETT_FILTER
+    plan->filter = FILTER_SIZE_MAX;
+    for (uint8_t i = 0; i < numRates; i++)
+    {
+        if (adi_imu_DecimLog2(ratios[i]) < plan->filter)
+        {
+            plan->filter = adi_imu_DecimLog2(ratios[i]);
+        }
+    }
+#endif
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Configures the IMU for a decimation plan and resets one host decimator per output.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param plan A pointer to a plan from adi_imu_PlanDecimation().
+ *
+ * @param decimators A pointer to plan->numOutputs decimators, one per requested rate in request order.
+ *
+ * @return A status code indicating the success of the SPI transaction.
+ **/
+adi_imu_Status adi_imu_ApplyDecimationPlan(adi_imu_Device *imu, const adi_imu_DecimationPlan *plan, adi_imu_Decimator *decimators)
+{
+    const adi_imu_RegWrite writes[] = {
+        { DECIMATE_REG, plan->decimate },
+#if SUPPORTS_BARTLETT_FILTER
+        { FILTER_REG, plan->filter },
+#endif
+    };
+    adi_imu_Status status;
+
+    status = adi_imu_WriteRegBatch(imu, writes, sizeof(writes) / sizeof(writes[0]));
+    if (status != ADI_IMU_SUCCESS)
+    {
+        return status;
+    }
+    for (uint8_t i = 0; i < plan->numOutputs; i++)
+    {
+        adi_imu_DecimatorInit(&decimators[i], plan->hostFactor[i]);
+    }
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Resets a host decimator.
+ *
+ * @param dec A pointer to the decimator state.
+ *
+ * @param factor The number of input samples per output sample. 1 passes every sample through.
+ *
+ * @return ADI_IMU_INVALID_DATA_RATE if the factor is 0 or its gain exceeds 2^32, ADI_IMU_SUCCESS otherwise.
+ **/
+adi_imu_Status adi_imu_DecimatorInit(adi_imu_Decimator *dec, uint16_t factor)
+{
+    adi_imu_Decimator cleared = { 0 };
+    uint64_t gain = 1;
+
+    if (factor == 0)
+    {
+        return ADI_IMU_INVALID_DATA_RATE;
+    }
+    for (uint8_t k = 0; k < DECIM_CIC_ORDER; k++)
+    {
+        gain *= factor;
+        if (gain > DECIM_MAX_GAIN)
+        {
+            return ADI_IMU_INVALID_DATA_RATE;
+        }
+    }
+    *dec = cleared;
+    dec->factor = factor;
+    dec->gain = gain;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Feeds one sample to a host decimator.
+ *
+ * @param dec A pointer to the decimator state.
+ *
+ * @param raw A pointer to the input sample, at the IMU data rate.
+ *
+ * @param out A pointer to the output sample populated every factor inputs.
+ *
+ * @return TRUE if out was populated, FALSE otherwise.
+ *
+ * The inertial channels and the temperature go through a DECIM_CIC_ORDER stage CIC filter, with the gain
+ * divided out so the output keeps the LSB weight, and therefore the scale factors, of the input. The
+ * status of every input is OR'd into the output and the remaining fields are those of the last input.
+ * The integrators run on wrapping integer math and are exact, so no error builds up over time. Delta
+ * samples come out as the filtered delta per IMU sample period; use adi_imu_DeltaAdd() to sum them instead.
+ **/
+adi_imu_Boolean adi_imu_Decimate(adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_UnscaledData *out)
+{
+    uint64_t x[DECIM_CHANNELS];
+    int64_t y;
+    int64_t half;
+
+    x[0] = (uint64_t) (int64_t) raw->xg;
+    x[1] = (uint64_t) (int64_t) raw->yg;
+    x[2] = (uint64_t) (int64_t) raw->zg;
+    x[3] = (uint64_t) (int64_t) raw->xa;
+    x[4] = (uint64_t) (int64_t) raw->ya;
+    x[5] = (uint64_t) (int64_t) raw->za;
+    x[6] = (uint64_t) (int64_t) raw->temperature;
+    for (uint8_t k = 0; k < DECIM_CIC_ORDER; k++)
+    {
+        for (uint8_t ch = 0; ch < DECIM_CHANNELS; ch++)
+        {
+            dec->integ[k][ch] += x[ch];
+            x[ch] = dec->integ[k][ch];
+        }
+    }
+#if SUPPORTS_BURST_STATUS
+    dec->status |= raw->status;
+#endif
+    if (++dec->phase < dec->factor)
+    {
+        return FALSE;
+    }
+    dec->phase = 0;
+
+    for (uint8_t k = 0; k < DECIM_CIC_ORDER; k++)
+    {
+        for (uint8_t ch = 0; ch < DECIM_CHANNELS; ch++)
+        {
+            uint64_t in = x[ch];
+
+            x[ch] = in - dec->delay[k][ch];
+            dec->delay[k][ch] = in;
+        }
+    }
+
+    *out = *raw;
+    half = (int64_t) (dec->gain >> 1);
+    for (uint8_t ch = 0; ch < DECIM_CHANNELS; ch++)
+    {
+        /* Round half away from zero */
+        y = (int64_t) x[ch];
+        y = ((y < 0) ? (y - half) : (y + half)) / (int64_t) dec->gain;
+        x[ch] = (uint64_t) y;
+    }
+    out->xg = (int32_t) x[0];
+    out->yg = (int32_t) x[1];
+    out->zg = (int32_t) x[2];
+    out->xa = (int32_t) x[3];
+    out->ya = (int32_t) x[4];
+    out->za = (int32_t) x[5];
+    out->temperature = (int32_t) x[6];
+#if SUPPORTS_BURST_STATUS
+    out->status = dec->status;
+    dec->status = 0;
+#endif
+
+    return TRUE;
+}
+
+/**
+ * @brief Feeds a block of samples to a host decimator.
+ *
+ * @param dec A pointer to the decimator state, carried over between blocks.
+ *
+ * @param raw A pointer to the input samples, e.g. a batch drained with adi_imu_StreamRead().
+ *
+ * @param numSamples The number of input samples.
+ *
+ * @param out A pointer to the output samples. Must hold numSamples / factor + 1 entries.
+ *
+ * @return The number of output samples written.
+ *
+ * Run one decimator per output rate over the same block to produce several rates concurrently.
+ **/
+uint16_t adi_imu_DecimateBlock(adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, uint16_t numSamples, adi_imu_UnscaledData *out)
+{
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < numSamples; i++)
+    {
+        if (adi_imu_Decimate(dec, &raw[i], &out[count]))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+#if ENABLE_SCALED_DATA
+/**
+ * @brief Feeds one sample to a host decimator and scales the output.
+ *
+ * @param imu A pointer to the device context the sample was read from.
+ *
+ * @param dec A pointer to the decimator state.
+ *
+ * @param raw A pointer to the input sample.
+ *
+ * @param out A pointer to the scaled output sample populated every factor inputs.
+ *
+ * @return TRUE if out was populated, FALSE otherwise.
+ *
+ * Filtering stays in the integer domain and only the outputs are scaled, which costs one scaling per
+ * output instead of per input and avoids the drift of floating-point CIC integrators.
+ **/
+adi_imu_Boolean adi_imu_DecimateScaled(const adi_imu_Device *imu, adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_ScaledData *out)
+{
+    adi_imu_UnscaledData decimated;
+
+    if (!adi_imu_Decimate(dec, raw, &decimated))
+    {
+        return FALSE;
+    }
+    adi_imu_ScaleSensorData(imu, &decimated, out);
+
+    return TRUE;
+}
+#endif
+
+#if ENABLE_FIXED_POINT_DATA
+/**
+ * @brief Feeds one sample to a host decimator and scales the output using integer math only.
+ *
+ * @param imu A pointer to the device context the sample was read from.
+ *
+ * @param dec A pointer to the decimator state.
+ *
+ * @param raw A pointer to the input sample.
+ *
+ * @param out A pointer to the Q16.16 output sample populated every factor inputs.
+ *
+ * @return TRUE if out was populated, FALSE otherwise.
+ **/
+adi_imu_Boolean adi_imu_DecimateFixed(const adi_imu_Device *imu, adi_imu_Decimator *dec, const adi_imu_UnscaledData *raw, adi_imu_FixedData *out)
+{
+    adi_imu_UnscaledData decimated;
+
+    if (!adi_imu_Decimate(dec, raw, &decimated))
+    {
+        return FALSE;
+    }
+    adi_imu_FixedScaleSensorData(imu, &decimated, out);
+
+    return TRUE;
+}
+#endif
+
+#endif
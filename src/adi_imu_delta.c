@@ -0,0 +1,178 @@
+/**
+  * @file	    adi_imu_delta.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Delta angle/velocity window integration for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if ENABLE_DELTA_INTEGRATION
+
+#define DELTA_DEG_TO_RAD            (float) 0.017453292519943295
+#define DELTA_RAD_TO_DEG            (float) 57.29577951308232
+
+/* Samples drained from the ring buffer per adi_imu_StreamRead() call */
+#define DELTA_STREAM_CHUNK          32
+
+/**
+ * @brief Adds half the cross product of a and b to acc.
+ **/
+static void adi_imu_DeltaAddHalfCross(float *acc, const float *a, const float *b)
+{
+    acc[0] += 0.5f * (a[1] * b[2] - a[2] * b[1]);
+    acc[1] += 0.5f * (a[2] * b[0] - a[0] * b[2]);
+    acc[2] += 0.5f * (a[0] * b[1] - a[1] * b[0]);
+}
+
+/**
+ * @brief Starts integrating delta samples into windows of a fixed number of samples.
+ *
+ * @param integ A pointer to the integration state.
+ *
+ * @param window The number of IMU samples per summary, e.g. 20 to turn a 2000 Hz input into 100 Hz summaries.
+ *
+ * @return ADI_IMU_INVALID_DATA_RATE if the window is empty, ADI_IMU_SUCCESS otherwise.
+ **/
+adi_imu_Status adi_imu_DeltaInit(adi_imu_DeltaIntegrator *integ, uint16_t window)
+{
+    adi_imu_DeltaIntegrator cleared = { 0 };
+
+    if (window == 0)
+    {
+        return ADI_IMU_INVALID_DATA_RATE;
+    }
+    *integ = cleared;
+    integ->window = window;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Adds one delta sample to the current window.
+ *
+ * @param imu A pointer to the device context the sample was read from.
+ *
+ * @param integ A pointer to the integration state.
+ *
+ * @param raw A pointer to an unscaled sample read with ENABLE_DELTA_DATA.
+ *
+ * @param summary A pointer to the summary populated when the sample completes a window.
+ *
+ * @return TRUE if the sample completed a window and summary was populated, FALSE otherwise.
+ *
+ * The delta angles are summed with the first-order coning correction, 1/2 sum(alpha x dtheta), where alpha
+ * is the rotation accumulated so far in the window. The delta velocities are summed with the rotation
+ * correction, 1/2 (alpha x v), and the sculling correction, 1/2 sum(alpha x dv + v x dtheta). The IMU already
+ * compensates within each of its own samples, so this keeps the motion between samples which a plain sum of
+ * the outputs would lose. The window total must stay within the delta range of a single output.
+ **/
+adi_imu_Boolean adi_imu_DeltaAdd(const adi_imu_Device *imu, adi_imu_DeltaIntegrator *integ, const adi_imu_UnscaledData *raw, adi_imu_DeltaSummary *summary)
+{
+    adi_imu_ScaledData scaled;
+    float dAngle[3];
+    float dVelocity[3];
+
+    adi_imu_ScaleSensorData(imu, raw, &scaled);
+    dAngle[0] = scaled.xg * DELTA_DEG_TO_RAD;
+    dAngle[1] = scaled.yg * DELTA_DEG_TO_RAD;
+    dAngle[2] = scaled.zg * DELTA_DEG_TO_RAD;
+    dVelocity[0] = scaled.xa;
+    dVelocity[1] = scaled.ya;
+    dVelocity[2] = scaled.za;
+
+    /* Both corrections use the sums before this sample */
+    adi_imu_DeltaAddHalfCross(integ->coning, integ->angle, dAngle);
+    adi_imu_DeltaAddHalfCross(integ->sculling, integ->angle, dVelocity);
+    adi_imu_DeltaAddHalfCross(integ->sculling, integ->velocity, dAngle);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        integ->angle[i] += dAngle[i];
+        integ->velocity[i] += dVelocity[i];
+    }
+#if SUPPORTS_BURST_STATUS
+    integ->status |= (uint16_t) raw->status;
+#endif
+    integ->samples++;
+    if (integ->samples < integ->window)
+    {
+        return FALSE;
+    }
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        summary->dAngle[i] = (integ->angle[i] + integ->coning[i]) * DELTA_RAD_TO_DEG;
+        summary->dVelocity[i] = integ->velocity[i] + integ->sculling[i];
+    }
+    adi_imu_DeltaAddHalfCross(summary->dVelocity, integ->angle, integ->velocity);
+    summary->samples = integ->samples;
+#if SUPPORTS_BURST_STATUS
+    summary->status = integ->status;
+#endif
+#if SUPPORTS_BURST_CNT
+    summary->count = (uint16_t) raw->count;
+#endif
+
+    adi_imu_DeltaInit(integ, integ->window);
+    return TRUE;
+}
+
+#if ENABLE_STREAMING
+/**
+ * @brief Drains the streaming ring buffer through a delta integrator.
+ *
+ * @param imu A pointer to the streaming device context.
+ *
+ * @param integ A pointer to the integration state, carried over between calls.
+ *
+ * @param summaries A pointer to an array receiving the completed windows, oldest first.
+ *
+ * @param maxSummaries The capacity of summaries.
+ *
+ * @param numRead A pointer to the number of summaries written.
+ *
+ * @return ADI_IMU_STREAM_OVERRUN if samples were dropped since the previous call, ADI_IMU_SUCCESS otherwise.
+ *
+ * Only the samples needed to fill the free summary slots are taken from the ring, so nothing is lost when
+ * summaries is full; the rest stays queued for the next call. A window which spans an overrun is still
+ * emitted but covers fewer than window sample periods of motion.
+ **/
+adi_imu_Status adi_imu_DeltaStreamRead(adi_imu_Device *imu, adi_imu_DeltaIntegrator *integ, adi_imu_DeltaSummary *summaries, uint16_t maxSummaries, uint16_t *numRead)
+{
+    adi_imu_UnscaledData chunk[DELTA_STREAM_CHUNK];
+    adi_imu_Status status = ADI_IMU_SUCCESS;
+    uint16_t count = 0;
+    uint16_t numSamples;
+    uint32_t wanted;
+
+    while (count < maxSummaries)
+    {
+        wanted = (uint32_t) (maxSummaries - count) * integ->window - integ->samples;
+        if (wanted > DELTA_STREAM_CHUNK)
+        {
+            wanted = DELTA_STREAM_CHUNK;
+        }
+        if (adi_imu_StreamRead(imu, chunk, (uint16_t) wanted, &numSamples) == ADI_IMU_STREAM_OVERRUN)
+        {
+            status = ADI_IMU_STREAM_OVERRUN;
+        }
+        for (uint16_t i = 0; i < numSamples; i++)
+        {
+            if (adi_imu_DeltaAdd(imu, integ, &chunk[i], &summaries[count]))
+            {
+                count++;
+            }
+        }
+        if (numSamples < wanted)
+        {
+            break;
+        }
+    }
+    *numRead = count;
+
+    return status;
+}
+#endif
+
+#endif
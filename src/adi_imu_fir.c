@@ -0,0 +1,150 @@
+/**
+  * @file	    adi_imu_fir.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		FIR coefficient bank access for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if SUPPORTS_FIR_BANKS
+
+/**
+ * @brief Uploads a complete FIR coefficient bank.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param bank The bank to be written, 0 (bank A) to FIR_BANK_COUNT - 1.
+ *
+ * @param coeffs A pointer to FIR_BANK_TAPS coefficients, tap 0 first.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * The taps are sent with adi_imu_WriteRegBatch(), so the bank page is selected once and the writes are packed
+ * into as few SPI transactions as SPI_BUFF_SIZE allows. If the FIR bank cache is enabled and holds the bank,
+ * only the taps which differ from the shadow copy are written, and an unchanged bank costs no SPI traffic at
+ * all. The new coefficients are volatile until adi_imu_CommitFirBanks() is called. Writes to the coefficient
+ * registers through adi_imu_WriteReg() bypass the shadow copy; call adi_imu_ReadFirBank() afterwards to resync.
+ **/
+adi_imu_Status adi_imu_WriteFirBank(adi_imu_Device *imu, uint8_t bank, const int16_t *coeffs)
+{
+    adi_imu_RegWrite writes[FIR_BANK_TAPS];
+    uint16_t numWrites = 0;
+
+    if (bank >= FIR_BANK_COUNT)
+    {
+        return ADI_IMU_INVALID_FIR_BANK;
+    }
+
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+#if ENABLE_FIR_BANK_CACHE
+        if ((imu->firCacheValid & (1 << bank)) && (imu->firCache[bank][tap] == coeffs[tap]))
+        {
+            continue;
+        }
+#endif
+        writes[numWrites].pageIDRegAddr = FIR_COEF_REG(bank, tap);
+        writes[numWrites].val = (uint16_t) coeffs[tap];
+        numWrites++;
+    }
+    if (numWrites == 0)
+    {
+        imu->status = ADI_IMU_SUCCESS;
+        return imu->status;
+    }
+
+    imu->status = adi_imu_WriteRegBatch(imu, writes, numWrites);
+#if ENABLE_FIR_BANK_CACHE
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+        {
+            imu->firCache[bank][tap] = coeffs[tap];
+        }
+        imu->firCacheValid |= (1 << bank);
+        imu->firDirty = TRUE;
+    }
+    else
+    {
+        /* Some of the taps may not have reached the IMU */
+        imu->firCacheValid &= ~(1 << bank);
+    }
+#endif
+
+    return imu->status;
+}
+
+/**
+ * @brief Reads back a complete FIR coefficient bank.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param bank The bank to be read, 0 (bank A) to FIR_BANK_COUNT - 1.
+ *
+ * @param coeffs A pointer to an array of FIR_BANK_TAPS coefficients to be populated, tap 0 first.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * The bank is always read from the IMU, with a single page select and pipelined reads through
+ * adi_imu_ReadRegArray(). If the FIR bank cache is enabled, the shadow copy is refreshed from the result.
+ **/
+adi_imu_Status adi_imu_ReadFirBank(adi_imu_Device *imu, uint8_t bank, int16_t *coeffs)
+{
+    uint16_t regList[FIR_BANK_TAPS];
+    uint16_t vals[FIR_BANK_TAPS];
+
+    if (bank >= FIR_BANK_COUNT)
+    {
+        return ADI_IMU_INVALID_FIR_BANK;
+    }
+
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+        regList[tap] = FIR_COEF_REG(bank, tap);
+    }
+    imu->status = adi_imu_ReadRegArray(imu, regList, vals, FIR_BANK_TAPS, 1);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+        coeffs[tap] = (int16_t) vals[tap];
+#if ENABLE_FIR_BANK_CACHE
+        imu->firCache[bank][tap] = coeffs[tap];
+#endif
+    }
+#if ENABLE_FIR_BANK_CACHE
+    imu->firCacheValid |= (1 << bank);
+#endif
+
+    return imu->status;
+}
+
+/**
+ * @brief Stores every uploaded FIR coefficient bank in flash.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * Upload every bank first and commit once: each flash update takes FLASH_MEMORY_BACKUP_TIME_MS. If the FIR
+ * bank cache is enabled and no tap was written since the last flash update, no flash update is issued.
+ **/
+adi_imu_Status adi_imu_CommitFirBanks(adi_imu_Device *imu)
+{
+#if ENABLE_FIR_BANK_CACHE
+    if (!imu->firDirty)
+    {
+        imu->status = ADI_IMU_SUCCESS;
+        return imu->status;
+    }
+#endif
+
+    return adi_imu_FlashUpdate(imu);
+}
+
+#endif
@@ -0,0 +1,146 @@
+/**
+  * @file	    adi_imu_instr.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Hot-path instrumentation counters for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "spi_driver.h"
+
+#if ENABLE_INSTRUMENTATION
+
+/* Shared by every device, updated from both the caller and the transfer completion contexts */
+static adi_imu_InstrStats adi_imu_Instr = {
+    .transferTime.min = UINT32_MAX,
+    .decodeTime.min = UINT32_MAX,
+};
+
+/**
+ * @brief Adds one duration to a timing record.
+ *
+ * @param timing A pointer to the timing record.
+ *
+ * @param cycles The duration, in timer_GetCycles() ticks.
+ **/
+static void adi_imu_InstrTimingAdd(adi_imu_InstrTiming *timing, uint32_t cycles)
+{
+    uint32_t scaled = cycles >> INSTR_HIST_SHIFT;
+    uint32_t bin = 0;
+    uint32_t seen;
+
+    while ((scaled > 1) && (bin < INSTR_HIST_BINS - 1))
+    {
+        scaled >>= 1;
+        bin++;
+    }
+
+    __atomic_fetch_add(&timing->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&timing->total, cycles, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&timing->hist[bin], 1, __ATOMIC_RELAXED);
+
+    seen = __atomic_load_n(&timing->min, __ATOMIC_RELAXED);
+    while ((cycles < seen) && !__atomic_compare_exchange_n(&timing->min, &seen, cycles, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    seen = __atomic_load_n(&timing->max, __ATOMIC_RELAXED);
+    while ((cycles > seen) && !__atomic_compare_exchange_n(&timing->max, &seen, cycles, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/**
+ * @brief Records the status returned by an instrumented entry point.
+ *
+ * @param api The entry point.
+ *
+ * @param status The status it returns.
+ *
+ * @return status, unchanged, so the call can wrap a return statement. See INSTR_RETURN().
+ **/
+adi_imu_Status adi_imu_InstrRecord(adi_imu_InstrApi api, adi_imu_Status status)
+{
+    __atomic_fetch_add(&adi_imu_Instr.calls[api], 1, __ATOMIC_RELAXED);
+    if (status != ADI_IMU_SUCCESS)
+    {
+        __atomic_fetch_add(&adi_imu_Instr.apiErrors[api], 1, __ATOMIC_RELAXED);
+    }
+    if ((uint32_t) status < ADI_IMU_STATUS_COUNT)
+    {
+        __atomic_fetch_add(&adi_imu_Instr.errors[status], 1, __ATOMIC_RELAXED);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Records a duration.
+ *
+ * @param timing The timing record to be updated.
+ *
+ * @param cycles The duration, in timer_GetCycles() ticks.
+ **/
+void adi_imu_InstrTime(adi_imu_InstrTimingId timing, uint32_t cycles)
+{
+    adi_imu_InstrTimingAdd((timing == INSTR_TIMING_DECODE) ? &adi_imu_Instr.decodeTime : &adi_imu_Instr.transferTime, cycles);
+}
+
+/**
+ * @brief Records a completed SPI transfer.
+ *
+ * @param xfer A pointer to the transfer descriptor, stamped by adi_imu_SubmitTransfer().
+ *
+ * Called from the completion context, so the transfer time includes any queueing in an asynchronous
+ * transport.
+ **/
+void adi_imu_InstrTransfer(const adi_imu_SpiXfer *xfer)
+{
+    uint16_t wordLen = (xfer->wordLen > 0) ? xfer->wordLen : xfer->xferLen;
+
+    __atomic_fetch_add(&adi_imu_Instr.transfers, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&adi_imu_Instr.bytes, xfer->xferLen, __ATOMIC_RELAXED);
+    if (wordLen > 0)
+    {
+        __atomic_fetch_add(&adi_imu_Instr.csAssertions, (xfer->xferLen + wordLen - 1) / wordLen, __ATOMIC_RELAXED);
+    }
+    adi_imu_InstrTimingAdd(&adi_imu_Instr.transferTime, timer_GetCycles() - xfer->startCycles);
+}
+
+/**
+ * @brief Clears every instrumentation counter.
+ *
+ * Must not race with a transfer in flight or the counters may be left partially cleared.
+ **/
+void adi_imu_InstrReset(void)
+{
+    adi_imu_InstrStats cleared = {
+        .transferTime.min = UINT32_MAX,
+        .decodeTime.min = UINT32_MAX,
+    };
+
+    adi_imu_Instr = cleared;
+}
+
+/**
+ * @brief Copies the instrumentation counters.
+ *
+ * @param stats A pointer to the snapshot to be populated.
+ *
+ * The copy is not atomic: counters updated from an interrupt while it runs may be one event apart. Timings
+ * which saw no event report a min of 0.
+ **/
+void adi_imu_InstrSnapshot(adi_imu_InstrStats *stats)
+{
+    *stats = adi_imu_Instr;
+    if (stats->transferTime.count == 0)
+    {
+        stats->transferTime.min = 0;
+    }
+    if (stats->decodeTime.count == 0)
+    {
+        stats->decodeTime.min = 0;
+    }
+}
+
+#endif
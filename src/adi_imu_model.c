@@ -0,0 +1,192 @@
+/**
+  * @file	    adi_imu_model.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Model detection and per-model burst decoders for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if ENABLE_BURST_MODE
+#if VERIFY_BURST_CHECKSUM
+/* Expand a family layout table into one assignment per field, summing the bytes in the same pass */
+#define BURST_DECODE_FIELD(field, index, decode)    data_struct->field = decode(burstRx, (index) + BURST_PAYLOAD_OFFSET); \
+                                                    checksum += decode##_SUM(burstRx, (index) + BURST_PAYLOAD_OFFSET);
+#else
+/* Expand a family layout table into one assignment per field */
+#define BURST_DECODE_FIELD(field, index, decode)    data_struct->field = decode(burstRx, (index) + BURST_PAYLOAD_OFFSET);
+#endif
+
+/**
+ * @brief Decodes a burst in the format selected for the build, BURST_LAYOUT.
+ *
+ * @return ADI_IMU_BURST_CHECKSUM_FAILED on a checksum mismatch with VERIFY_BURST_CHECKSUM, ADI_IMU_SUCCESS otherwise.
+ **/
+static adi_imu_Status adi_imu_DecodeBurstFull(const uint8_t *burstRx, adi_imu_UnscaledData *data_struct)
+{
+#if VERIFY_BURST_CHECKSUM
+    uint16_t checksum = 0;
+#endif
+
+    BURST_LAYOUT(BURST_DECODE_FIELD)
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    data_struct->chksm_crc = BURST_U16(burstRx, CHECKSUM_INDEX + BURST_PAYLOAD_OFFSET);
+#endif
+#if VERIFY_BURST_CHECKSUM
+    if (checksum != data_struct->chksm_crc)
+    {
+        return ADI_IMU_BURST_CHECKSUM_FAILED;
+    }
+#endif
+
+    return ADI_IMU_SUCCESS;
+}
+
+#ifdef BURST_LAYOUT_NARROW
+/**
+ * @brief Decodes the 16-bit burst of a member without a 32-bit burst, BURST_LAYOUT_NARROW.
+ *
+ * @return ADI_IMU_BURST_CHECKSUM_FAILED on a checksum mismatch with VERIFY_BURST_CHECKSUM, ADI_IMU_SUCCESS otherwise.
+ **/
+static adi_imu_Status adi_imu_DecodeBurstNarrow(const uint8_t *burstRx, adi_imu_UnscaledData *data_struct)
+{
+#if VERIFY_BURST_CHECKSUM
+    uint16_t checksum = 0;
+#endif
+
+    BURST_LAYOUT_NARROW(BURST_DECODE_FIELD)
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    data_struct->chksm_crc = BURST_U16(burstRx, BURST_NARROW_CHECKSUM_INDEX + BURST_PAYLOAD_OFFSET);
+#endif
+#if VERIFY_BURST_CHECKSUM
+    if (checksum != data_struct->chksm_crc)
+    {
+        return ADI_IMU_BURST_CHECKSUM_FAILED;
+    }
+#endif
+
+    return ADI_IMU_SUCCESS;
+}
+#endif
+
+#undef BURST_DECODE_FIELD
+#endif
+
+/* Burst format of each member. Members without a 32-bit burst keep the 16-bit one in a 32-bit build */
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT
+    #define MODEL_BURST(has32BitBurst, burstSel) \
+                                        .decodeBurst = (has32BitBurst) ? adi_imu_DecodeBurstFull : adi_imu_DecodeBurstNarrow, \
+                                        .burstXferLength = (has32BitBurst) ? BURST_XFER_LENGTH : (BURST_NARROW_BYTE_LENGTH + 2), \
+                                        .burstCtrl = (has32BitBurst) ? BITM_MISC_CTRL_REG_BURST_SIZE : 0, \
+                                        .hasBurstSel = (burstSel) ? TRUE : FALSE,
+#elif ENABLE_BURST_MODE
+    #define MODEL_BURST(has32BitBurst, burstSel) \
+                                        .decodeBurst = adi_imu_DecodeBurstFull, \
+                                        .burstXferLength = BURST_XFER_LENGTH, \
+                                        .burstCtrl = 0, \
+                                        .hasBurstSel = (burstSel) ? TRUE : FALSE,
+#else
+    #define MODEL_BURST(has32BitBurst, burstSel)
+#endif
+
+/* Accelerometer scale factors of each member. The gyroscope range is read from RANG_MDL instead */
+#if ENABLE_SCALED_DATA & ENABLE_DELTA_DATA
+    #define MODEL_SCALE16(id)           .accel16Scale = 1.0f / DELTVEL_16BIT_SCALE_FOR_PROD_ID(id),
+    #define MODEL_SCALE32(id)           .accel32Scale = 1.0f / DELTVEL_32BIT_SCALE_FOR_PROD_ID(id),
+#elif ENABLE_SCALED_DATA
+    #define MODEL_SCALE16(id)           .accel16Scale = STANDARD_GRAVITY / ACCEL_16BIT_SCALE_FOR_PROD_ID(id),
+    #define MODEL_SCALE32(id)           .accel32Scale = STANDARD_GRAVITY / ACCEL_32BIT_SCALE_FOR_PROD_ID(id),
+#endif
+#if ENABLE_SCALED_DATA & SENSOR_DATA_32BIT
+    #define MODEL_SCALE(id)             MODEL_SCALE16(id) MODEL_SCALE32(id)
+#elif ENABLE_SCALED_DATA
+    #define MODEL_SCALE(id)             MODEL_SCALE16(id)
+#else
+    #define MODEL_SCALE(id)
+#endif
+
+#if ENABLE_FIXED_POINT_DATA & ENABLE_DELTA_DATA & SENSOR_DATA_32BIT
+    #define MODEL_FIXED(id)             .accelFixedScale = DELTVEL_32BIT_FIXED_FOR_PROD_ID(id),
+#elif ENABLE_FIXED_POINT_DATA & ENABLE_DELTA_DATA
+    #define MODEL_FIXED(id)             .accelFixedScale = DELTVEL_16BIT_FIXED_FOR_PROD_ID(id),
+#elif ENABLE_FIXED_POINT_DATA & SENSOR_DATA_32BIT
+    #define MODEL_FIXED(id)             .accelFixedScale = ACCEL_32BIT_FIXED_FOR_PROD_ID(id),
+#elif ENABLE_FIXED_POINT_DATA
+    #define MODEL_FIXED(id)             .accelFixedScale = ACCEL_16BIT_FIXED_FOR_PROD_ID(id),
+#else
+    #define MODEL_FIXED(id)
+#endif
+
+/* Model descriptions, in MODEL_TABLE order. Every member shares the family timing */
+#define MODEL_ENTRY(id, has32BitBurst, burstSel) \
+                                        { .prodId = (id), \
+                                          .stallTimeUs = STALL_TIME_US, \
+                                          .resetRecoveryTimeMs = RESET_RECOVERY_TIME_MS, \
+                                          .flashBackupTimeMs = FLASH_MEMORY_BACKUP_TIME_MS, \
+                                          MODEL_BURST(has32BitBurst, burstSel) \
+                                          MODEL_SCALE(id) \
+                                          MODEL_FIXED(id) },
+static const adi_imu_Model adi_imu_Models[] = {
+    MODEL_TABLE(MODEL_ENTRY)
+};
+#undef MODEL_ENTRY
+
+#define MODEL_COUNT                     (sizeof(adi_imu_Models) / sizeof(adi_imu_Models[0]))
+
+/**
+ * @brief Looks up the description of a member of the compiled family.
+ *
+ * @param prodId The PROD_ID reported by the part, or ADI_IMU_MODEL_DEFAULT for the first MODEL_TABLE entry.
+ *
+ * @return A pointer to the model description, or NULL if the part is not a member of the compiled family.
+ **/
+const adi_imu_Model *adi_imu_FindModel(uint16_t prodId)
+{
+    if (prodId == ADI_IMU_MODEL_DEFAULT)
+    {
+        return &adi_imu_Models[0];
+    }
+    for (uint8_t i = 0; i < MODEL_COUNT; i++)
+    {
+        if (adi_imu_Models[i].prodId == prodId)
+        {
+            return &adi_imu_Models[i];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Identifies the connected model from PROD_ID and selects its description.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return ADI_IMU_PRODID_VERIFY_FAILED if the part is not a member of the compiled family, otherwise a status
+ * code indicating the success of the SPI transaction.
+ *
+ * The description holds the burst decoder, burst length, burst format and scale factors of the model, so the
+ * hot path dispatches through a single pointer loaded from the device context. adi_imu_Init() calls this
+ * before configuring the burst and the scale factors. The previous description is kept on failure.
+ **/
+adi_imu_Status adi_imu_DetectModel(adi_imu_Device *imu)
+{
+    const adi_imu_Model *model;
+    uint16_t prodId = 0;
+
+    imu->status = adi_imu_ReadReg(imu, PRODUCT_ID_REG, &prodId);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    model = adi_imu_FindModel(prodId);
+    if ((prodId == ADI_IMU_MODEL_DEFAULT) || (model == 0))
+    {
+        imu->status = ADI_IMU_PRODID_VERIFY_FAILED;
+        return imu->status;
+    }
+    imu->model = model;
+
+    return imu->status;
+}
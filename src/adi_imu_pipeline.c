@@ -0,0 +1,225 @@
+/**
+  * @file	    adi_imu_pipeline.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Multi-buffered burst pipeline for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "spi_driver.h"
+
+#if ENABLE_BURST_MODE
+
+#if BURST_PIPELINE_DEPTH < 2
+    #error "BURST_PIPELINE_DEPTH must be at least 2"
+#endif
+
+/**
+ * @brief Burst completion handler.
+ *
+ * @param xfer The completed burst transfer.
+ *
+ * This function hands the slot from the transport to the decoder. A failed transfer is still marked ready so
+ * that FIFO order is preserved; the error is reported when the slot is acquired.
+ **/
+static void adi_imu_PipelineBurstComplete(adi_imu_SpiXfer *xfer)
+{
+    adi_imu_BurstSlot *slot = (adi_imu_BurstSlot *) xfer->context;
+
+    __atomic_store_n(&slot->state, BURST_SLOT_READY, __ATOMIC_RELEASE);
+    if (slot->pipe->onComplete)
+    {
+        slot->pipe->onComplete(slot->pipe);
+    }
+}
+
+/**
+ * @brief Resets a burst pipeline.
+ *
+ * @param imu A pointer to the device context the bursts are read from.
+ *
+ * @param pipe A pointer to the pipeline to be reset.
+ *
+ * @param onComplete Optional function called from the completion context whenever a slot becomes ready.
+ *
+ * @param context An opaque pointer stored in the pipeline for use by onComplete.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function must not be called while any slot is in flight.
+ **/
+adi_imu_Status adi_imu_PipelineInit(adi_imu_Device *imu, adi_imu_BurstPipeline *pipe, adi_imu_PipelineCallback onComplete, void *context)
+{
+    pipe->imu = imu;
+    pipe->onComplete = onComplete;
+    pipe->context = context;
+    for (uint8_t i = 0; i < BURST_PIPELINE_DEPTH; i++)
+    {
+        pipe->slots[i].pipe = pipe;
+        pipe->slots[i].xfer.txBuf = pipe->slots[i].txBuf;
+        pipe->slots[i].xfer.rxBuf = pipe->slots[i].rxBuf;
+        pipe->slots[i].state = BURST_SLOT_FREE;
+    }
+    pipe->submitIdx = 0;
+    pipe->decodeIdx = 0;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Puts the next burst on the wire.
+ *
+ * @param pipe A pointer to the pipeline.
+ *
+ * @return ADI_IMU_PIPELINE_FULL if no slot is free, otherwise the transport submission status.
+ *
+ * This function transfers ownership of the next free slot to the SPI transport and returns immediately when
+ * an asynchronous transport is in use.
+ **/
+adi_imu_Status adi_imu_PipelineSubmit(adi_imu_BurstPipeline *pipe)
+{
+    adi_imu_Status status;
+    adi_imu_BurstSlot *slot = &pipe->slots[pipe->submitIdx];
+
+    if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) != BURST_SLOT_FREE)
+    {
+        return ADI_IMU_PIPELINE_FULL;
+    }
+
+    slot->state = BURST_SLOT_IN_FLIGHT;
+    pipe->submitIdx = (pipe->submitIdx + 1) % BURST_PIPELINE_DEPTH;
+    status = adi_imu_SubmitBurst(pipe->imu, &slot->xfer, adi_imu_PipelineBurstComplete, slot);
+    if ((status != ADI_IMU_SUCCESS) && (slot->state == BURST_SLOT_IN_FLIGHT))
+    {
+        /* Rejected by the transport. Keep FIFO order and report the error on acquire */
+        slot->state = BURST_SLOT_READY;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Checks whether the oldest submitted burst has completed.
+ *
+ * @param pipe A pointer to the pipeline.
+ *
+ * @return TRUE if adi_imu_PipelineAcquire() would return without waiting for the transport.
+ **/
+adi_imu_Boolean adi_imu_PipelineReady(const adi_imu_BurstPipeline *pipe)
+{
+    return (__atomic_load_n(&pipe->slots[pipe->decodeIdx].state, __ATOMIC_ACQUIRE) == BURST_SLOT_READY) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Takes ownership of the oldest completed burst buffer.
+ *
+ * @param pipe A pointer to the pipeline.
+ *
+ * @param burstRx A pointer set to the received burst buffer, suitable for adi_imu_DecodeBurst().
+ *
+ * @return ADI_IMU_PIPELINE_EMPTY if nothing was submitted, otherwise the status of the completed transfer.
+ *
+ * This function waits for the oldest submitted burst to complete. The buffer belongs to the caller until
+ * adi_imu_PipelineRelease() is called, even if the transfer failed.
+ **/
+adi_imu_Status adi_imu_PipelineAcquire(adi_imu_BurstPipeline *pipe, const uint8_t **burstRx)
+{
+    adi_imu_BurstSlot *slot = &pipe->slots[pipe->decodeIdx];
+    adi_imu_BurstSlotState state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+
+    if ((state == BURST_SLOT_FREE) || (state == BURST_SLOT_DECODING))
+    {
+        return ADI_IMU_PIPELINE_EMPTY;
+    }
+    while (state != BURST_SLOT_READY)
+    {
+#if ENABLE_ASYNC_SPI
+        spi_WaitEvent();
+#endif
+        state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+    }
+
+    slot->state = BURST_SLOT_DECODING;
+    *burstRx = slot->rxBuf;
+
+    return slot->xfer.status;
+}
+
+/**
+ * @brief Hands the acquired burst buffer back to the pipeline.
+ *
+ * @param pipe A pointer to the pipeline.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_PipelineRelease(adi_imu_BurstPipeline *pipe)
+{
+    adi_imu_BurstSlot *slot = &pipe->slots[pipe->decodeIdx];
+
+    if (slot->state != BURST_SLOT_DECODING)
+    {
+        return ADI_IMU_PIPELINE_EMPTY;
+    }
+    pipe->decodeIdx = (pipe->decodeIdx + 1) % BURST_PIPELINE_DEPTH;
+    __atomic_store_n(&slot->state, BURST_SLOT_FREE, __ATOMIC_RELEASE);
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Reads sensor data while keeping the next burst in flight.
+ *
+ * @param pipe A pointer to the pipeline.
+ *
+ * @param data_struct A pointer to the unscaled data struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function waits for burst N, puts burst N+1 on the wire and then decodes burst N, so with an
+ * asynchronous transport the decode and the work done by the caller until the next call overlap the transfer
+ * of the following burst. Each call therefore returns the burst submitted by the previous call. The first call
+ * primes the pipeline and waits for the burst it just submitted. Call it once per data-ready period to keep
+ * exactly one burst on the wire.
+ **/
+adi_imu_Status adi_imu_PipelineGetSensorData(adi_imu_BurstPipeline *pipe, adi_imu_UnscaledData *data_struct)
+{
+    adi_imu_Status status;
+    adi_imu_Status xferStatus;
+    const uint8_t *burstRx;
+
+    /* Prime an idle pipeline. A rejected submission is queued as a failed slot and reported in FIFO order */
+    if (__atomic_load_n(&pipe->slots[pipe->decodeIdx].state, __ATOMIC_ACQUIRE) == BURST_SLOT_FREE)
+    {
+        adi_imu_PipelineSubmit(pipe);
+    }
+
+    xferStatus = adi_imu_PipelineAcquire(pipe, &burstRx);
+    if (xferStatus == ADI_IMU_PIPELINE_EMPTY)
+    {
+        return INSTR_RETURN(PIPELINE_GET_SENSOR_DATA, xferStatus);
+    }
+
+    /* Put the replacement on the wire before decoding, the slot being decoded is not reused until released */
+    adi_imu_PipelineSubmit(pipe);
+
+    if (xferStatus == ADI_IMU_SUCCESS)
+    {
+        status = adi_imu_DecodeBurst(pipe->imu, burstRx, data_struct);
+#if VERIFY_BURST_CHECKSUM
+        if (status == ADI_IMU_BURST_CHECKSUM_FAILED)
+        {
+            pipe->imu->checksumErrors++;
+        }
+#endif
+    }
+    else
+    {
+        status = xferStatus;
+    }
+    adi_imu_PipelineRelease(pipe);
+
+    return INSTR_RETURN(PIPELINE_GET_SENSOR_DATA, status);
+}
+
+#endif
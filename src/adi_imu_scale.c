@@ -0,0 +1,276 @@
+/**
+  * @file	    adi_imu_scale.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Scaled sensor data conversion for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if ENABLE_SCALED_DATA
+
+/* Select the scale factor set matching the width of the unscaled data */
+#if SENSOR_DATA_32BIT
+    #define GYRO_SCALE(imu)         ((imu)->scale32.gyro32Scale)
+    #define ACCEL_SCALE(imu)        ((imu)->scale32.accel32Scale)
+    #define TEMP_SCALE(imu)         ((imu)->scale32.tempScale)
+    #define MAG_SCALE(imu)          ((imu)->scale32.magScale)
+    #define BARO_SCALE(imu)         ((imu)->scale32.baroScale)
+#else
+    #define GYRO_SCALE(imu)         ((imu)->scale16.gyro16Scale)
+    #define ACCEL_SCALE(imu)        ((imu)->scale16.accel16Scale)
+    #define TEMP_SCALE(imu)         ((imu)->scale16.tempScale)
+    #define MAG_SCALE(imu)          ((imu)->scale16.magScale)
+    #define BARO_SCALE(imu)         ((imu)->scale16.baroScale)
+#endif
+
+/**
+ * @brief Applies the device scale factors to a single unscaled sample.
+ *
+ * @param imu A pointer to the device context the sample was read from.
+ *
+ * @param raw A pointer to the unscaled sample.
+ *
+ * @param data_struct A pointer to the scaled data struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_ScaleSensorData(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, adi_imu_ScaledData *data_struct)
+{
+    const float gyroScale = GYRO_SCALE(imu);
+    const float accelScale = ACCEL_SCALE(imu);
+
+#if SUPPORTS_BURST_STATUS
+    data_struct->status = raw->status;
+#endif
+#if SUPPORTS_BURST_CNT
+    data_struct->count = raw->count;
+#endif
+    data_struct->xg = (float) raw->xg * gyroScale;
+    data_struct->yg = (float) raw->yg * gyroScale;
+    data_struct->zg = (float) raw->zg * gyroScale;
+    data_struct->xa = (float) raw->xa * accelScale;
+    data_struct->ya = (float) raw->ya * accelScale;
+    data_struct->za = (float) raw->za * accelScale;
+    data_struct->temperature = (float) raw->temperature * TEMP_SCALE(imu) + TEMPERATURE_OFFSET;
+#if ENABLE_MAGNETOMETER
+    data_struct->xm = (float) raw->xm * MAG_SCALE(imu);
+    data_struct->ym = (float) raw->ym * MAG_SCALE(imu);
+    data_struct->zm = (float) raw->zm * MAG_SCALE(imu);
+#endif
+#if ENABLE_BAROMETER
+    data_struct->baro = (float) raw->baro * BARO_SCALE(imu);
+#endif
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    data_struct->chksm_crc = raw->chksm_crc;
+#endif
+
+    return ADI_IMU_SUCCESS;
+}
+
+/* Samples converted per group. Matches the four single-precision lanes of SSE and NEON */
+#define SCALE_GROUP_SIZE            4
+
+/* Converts one field of a group of samples. The four stores are adjacent, so GCC combines the group into one
+   vector convert, multiply and store (SLP vectorization, enabled at -O2 since GCC 12) */
+#define SCALE_GROUP(dst, src, field, scale) \
+    (dst)[0] = (float) (src)[0].field * (scale); \
+    (dst)[1] = (float) (src)[1].field * (scale); \
+    (dst)[2] = (float) (src)[2].field * (scale); \
+    (dst)[3] = (float) (src)[3].field * (scale);
+
+/**
+ * @brief Applies the device scale factors to a batch of unscaled samples.
+ *
+ * @param imu A pointer to the device context the samples were read from.
+ *
+ * @param raw A pointer to an array of unscaled samples.
+ *
+ * @param numSamples The number of samples in raw. Every output array must hold at least this many entries.
+ *
+ * @param out A pointer to the structure-of-arrays output buffers.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function converts the batch in groups of four samples. Each field of a group is gathered from the four
+ * samples and written as four adjacent outputs, which GCC turns into one vector operation on hosts with SSE or
+ * NEON. The interleaved loads defeat loop vectorization of a plain per-sample loop, so the grouping is explicit.
+ * On the Cortex-M4 the groups reduce to one multiply per value. Status, counter and checksum words are not
+ * copied; read them from raw if needed.
+ **/
+adi_imu_Status adi_imu_ScaleBatch(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, uint16_t numSamples, adi_imu_ScaledBatch *out)
+{
+    const float gyroScale = GYRO_SCALE(imu);
+    const float accelScale = ACCEL_SCALE(imu);
+    const float tempScale = TEMP_SCALE(imu);
+    float *restrict xg = out->xg;
+    float *restrict yg = out->yg;
+    float *restrict zg = out->zg;
+    float *restrict xa = out->xa;
+    float *restrict ya = out->ya;
+    float *restrict za = out->za;
+    float *restrict temperature = out->temperature;
+#if ENABLE_MAGNETOMETER
+    const float magScale = MAG_SCALE(imu);
+    float *restrict xm = out->xm;
+    float *restrict ym = out->ym;
+    float *restrict zm = out->zm;
+#endif
+#if ENABLE_BAROMETER
+    const float baroScale = BARO_SCALE(imu);
+    float *restrict baro = out->baro;
+#endif
+    uint16_t i = 0;
+
+    for (; (numSamples - i) >= SCALE_GROUP_SIZE; i += SCALE_GROUP_SIZE)
+    {
+        const adi_imu_UnscaledData *in = &raw[i];
+
+        SCALE_GROUP(&xg[i], in, xg, gyroScale);
+        SCALE_GROUP(&yg[i], in, yg, gyroScale);
+        SCALE_GROUP(&zg[i], in, zg, gyroScale);
+        SCALE_GROUP(&xa[i], in, xa, accelScale);
+        SCALE_GROUP(&ya[i], in, ya, accelScale);
+        SCALE_GROUP(&za[i], in, za, accelScale);
+        temperature[i] = (float) in[0].temperature * tempScale + TEMPERATURE_OFFSET;
+        temperature[i + 1] = (float) in[1].temperature * tempScale + TEMPERATURE_OFFSET;
+        temperature[i + 2] = (float) in[2].temperature * tempScale + TEMPERATURE_OFFSET;
+        temperature[i + 3] = (float) in[3].temperature * tempScale + TEMPERATURE_OFFSET;
+#if ENABLE_MAGNETOMETER
+        SCALE_GROUP(&xm[i], in, xm, magScale);
+        SCALE_GROUP(&ym[i], in, ym, magScale);
+        SCALE_GROUP(&zm[i], in, zm, magScale);
+#endif
+#if ENABLE_BAROMETER
+        SCALE_GROUP(&baro[i], in, baro, baroScale);
+#endif
+    }
+    /* Remaining samples one at a time */
+    for (; i < numSamples; i++)
+    {
+        xg[i] = (float) raw[i].xg * gyroScale;
+        yg[i] = (float) raw[i].yg * gyroScale;
+        zg[i] = (float) raw[i].zg * gyroScale;
+        xa[i] = (float) raw[i].xa * accelScale;
+        ya[i] = (float) raw[i].ya * accelScale;
+        za[i] = (float) raw[i].za * accelScale;
+        temperature[i] = (float) raw[i].temperature * tempScale + TEMPERATURE_OFFSET;
+#if ENABLE_MAGNETOMETER
+        xm[i] = (float) raw[i].xm * magScale;
+        ym[i] = (float) raw[i].ym * magScale;
+        zm[i] = (float) raw[i].zm * magScale;
+#endif
+#if ENABLE_BAROMETER
+        baro[i] = (float) raw[i].baro * baroScale;
+#endif
+    }
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Triggers a read of the inertial data and populates the scaled data struct.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param data_struct A pointer to the scaled data struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_GetScaledSensorData(adi_imu_Device *imu, adi_imu_ScaledData *data_struct)
+{
+    adi_imu_UnscaledData data;
+
+    imu->status = adi_imu_GetSensorData(imu, &data);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    return adi_imu_ScaleSensorData(imu, &data, data_struct);
+}
+
+#endif
+
+#if ENABLE_FIXED_POINT_DATA
+
+/* Gyro and accelerometer factors carry the extra fraction bits matching the sensor data word width */
+#if SENSOR_DATA_32BIT
+    #define FIXED_DATA_SHIFT        FIXED_SCALE_32BIT_SHIFT
+#else
+    #define FIXED_DATA_SHIFT        FIXED_SCALE_16BIT_SHIFT
+#endif
+
+/**
+ * @brief Applies the device scale factors to a single unscaled sample using integer math only.
+ *
+ * @param imu A pointer to the device context the sample was read from.
+ *
+ * @param raw A pointer to the unscaled sample.
+ *
+ * @param data_struct A pointer to the fixed-point data struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * Each value costs one 32x32->64 bit multiply and a shift, so no soft-float calls are made on targets without
+ * an FPU. The result is rounded to the nearest Q16.16 LSB and scale factor rounding adds at most a quarter LSB
+ * over the full sensor range, so the output stays within 0.75 Q16.16 LSB of the exact value. The floating-point
+ * path is less accurate near full scale, where single precision rounding alone exceeds 10 Q16.16 LSBs.
+ **/
+adi_imu_Status adi_imu_FixedScaleSensorData(const adi_imu_Device *imu, const adi_imu_UnscaledData *raw, adi_imu_FixedData *data_struct)
+{
+    const int32_t gyroScale = imu->fixedScale.gyroScale;
+    const int32_t accelScale = imu->fixedScale.accelScale;
+
+#if SUPPORTS_BURST_STATUS
+    data_struct->status = raw->status;
+#endif
+#if SUPPORTS_BURST_CNT
+    data_struct->count = raw->count;
+#endif
+    data_struct->xg = FIXED_MUL(raw->xg, gyroScale, FIXED_DATA_SHIFT);
+    data_struct->yg = FIXED_MUL(raw->yg, gyroScale, FIXED_DATA_SHIFT);
+    data_struct->zg = FIXED_MUL(raw->zg, gyroScale, FIXED_DATA_SHIFT);
+    data_struct->xa = FIXED_MUL(raw->xa, accelScale, FIXED_DATA_SHIFT);
+    data_struct->ya = FIXED_MUL(raw->ya, accelScale, FIXED_DATA_SHIFT);
+    data_struct->za = FIXED_MUL(raw->za, accelScale, FIXED_DATA_SHIFT);
+    data_struct->temperature = FIXED_MUL(raw->temperature, imu->fixedScale.tempScale, FIXED_SCALE_16BIT_SHIFT) + TEMPERATURE_FIXED_OFFSET;
+#if ENABLE_MAGNETOMETER
+    data_struct->xm = FIXED_MUL(raw->xm, imu->fixedScale.magScale, FIXED_DATA_SHIFT);
+    data_struct->ym = FIXED_MUL(raw->ym, imu->fixedScale.magScale, FIXED_DATA_SHIFT);
+    data_struct->zm = FIXED_MUL(raw->zm, imu->fixedScale.magScale, FIXED_DATA_SHIFT);
+#endif
+#if ENABLE_BAROMETER
+    data_struct->baro = FIXED_MUL(raw->baro, imu->fixedScale.baroScale, FIXED_DATA_SHIFT);
+#endif
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    data_struct->chksm_crc = raw->chksm_crc;
+#endif
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Triggers a read of the inertial data and populates the fixed-point data struct.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param data_struct A pointer to the fixed-point data struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_GetFixedSensorData(adi_imu_Device *imu, adi_imu_FixedData *data_struct)
+{
+    adi_imu_UnscaledData data;
+
+    imu->status = adi_imu_GetSensorData(imu, &data);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+
+    return adi_imu_FixedScaleSensorData(imu, &data, data_struct);
+}
+
+#endif
@@ -0,0 +1,497 @@
+/**
+  * @file	    adi_imu_stream.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Data-ready driven streaming engine for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "spi_driver.h"
+
+#if ENABLE_STREAMING
+
+#if (STREAM_RING_SIZE & (STREAM_RING_SIZE - 1)) != 0
+    #error "STREAM_RING_SIZE must be a power of two"
+#endif
+
+/* Ring index helpers. The head and tail counters run freely and are masked on access. */
+#define RING_MASK                   (STREAM_RING_SIZE - 1)
+#define RING_LOAD_ACQUIRE(ptr)      __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(ptr, v)  __atomic_store_n((ptr), (v), __ATOMIC_RELEASE)
+
+static void adi_imu_StreamBurstComplete(adi_imu_BurstPipeline *pipe);
+
+/**
+ * @brief Starts the data-ready driven streaming engine.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param drPin The IMU GPIO configured as the data-ready output.
+ *
+ * @param edge The data-ready edge which triggers a burst.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function configures the data-ready polarity in the IMU, clears the sample ring buffer and attaches
+ * adi_imu_StreamDataReadyISR() to the data-ready signal. From then on, every data-ready edge captures exactly
+ * one burst which is decoded directly into the ring buffer. With ENABLE_ASYNC_SPI the burst runs in the
+ * background and is decoded from the transfer completion context. Register accesses must not be issued
+ * while the engine is running since they would share the SPI bus with the data-ready handler. Devices that
+ * share a bus must be attached with adi_imu_BusAddDevice() first.
+ **/
+adi_imu_Status adi_imu_StreamStart(adi_imu_Device *imu, adi_imu_DatRdyGPIO drPin, adi_imu_EdgeType edge)
+{
+    adi_imu_Status status = ADI_IMU_SUCCESS;
+    uint16_t miscCtrl = 0;
+
+    if (imu->streaming)
+    {
+        adi_imu_StreamStop(imu);
+    }
+
+    /* Configure the data-ready polarity to match the requested edge */
+    status = adi_imu_ReadReg(imu, MISC_CTRL_REG, &miscCtrl);
+    if (status != ADI_IMU_SUCCESS)
+    {
+        return status;
+    }
+    if (edge == RISING_EDGE)
+    {
+        miscCtrl |= BITM_MISC_CTRL_REG_DR_POLARITY;
+    }
+    else
+    {
+        miscCtrl &= ~BITM_MISC_CTRL_REG_DR_POLARITY;
+    }
+    status = adi_imu_WriteReg(imu, MISC_CTRL_REG, miscCtrl);
+    if (status != ADI_IMU_SUCCESS)
+    {
+        return status;
+    }
+#if ENABLE_TIMESTAMPS
+    status = adi_imu_TimeSyncInit(imu, &imu->timeSync);
+    if (status != ADI_IMU_SUCCESS)
+    {
+        return status;
+    }
+#endif
+
+    /* Reset the ring buffer and statistics */
+    imu->ring.head = 0;
+    imu->ring.tail = 0;
+    imu->ring.overruns = 0;
+    imu->ring.overrunsReported = 0;
+    imu->reserved = 0;
+    adi_imu_PipelineInit(imu, &imu->pipeline, adi_imu_StreamBurstComplete, imu);
+    imu->streamStats.samples = 0;
+    imu->streamStats.overruns = 0;
+    imu->streamStats.spiErrors = 0;
+    imu->streamStats.checksumErrors = 0;
+#if SUPPORTS_BURST_CNT
+    imu->streamStats.missed = 0;
+    imu->streamStats.duplicates = 0;
+    imu->countValid = FALSE;
+    #if SUPPORTS_PPS
+    imu->countIsTimeStamp = (((miscCtrl & BITM_MISC_CTRL_REG_SYNC_FUNCTION) >> BITP_MISC_CTRL_REG_SYNC_FUNCTION) == SYNC_SCALED) ? TRUE : FALSE;
+    #else
+    imu->countIsTimeStamp = FALSE;
+    #endif
+#endif
+#if ENABLE_SAMPLE_SEQUENCE
+    imu->sequence = 0;
+#endif
+
+    /* Arm the engine before enabling the interrupt so no edge is missed */
+    imu->drPin = drPin;
+    imu->streaming = TRUE;
+    status = gpio_AttachDataReady(imu->csPin, drPin, edge, adi_imu_StreamDataReadyISR, imu);
+    if (status != ADI_IMU_SUCCESS)
+    {
+        imu->streaming = FALSE;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Stops the streaming engine.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return A status code indicating the success of the subroutine.
+ *
+ * This function detaches the data-ready handler and drops any edge still waiting for the shared bus. Samples
+ * already in the ring buffer remain available to adi_imu_StreamRead().
+ **/
+adi_imu_Status adi_imu_StreamStop(adi_imu_Device *imu)
+{
+    if (!imu->streaming)
+    {
+        return ADI_IMU_STREAM_NOT_RUNNING;
+    }
+    imu->streaming = FALSE;
+    gpio_DetachDataReady(imu->csPin, imu->drPin);
+    if (imu->bus)
+    {
+        __atomic_and_fetch(&imu->bus->pending, ~(1UL << imu->busIndex), __ATOMIC_ACQ_REL);
+    }
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Reserves a ring buffer slot and puts a burst on the wire.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return TRUE if a burst was submitted, FALSE if the sample was dropped or the engine is stopped.
+ **/
+static adi_imu_Boolean adi_imu_StreamSubmit(adi_imu_Device *imu)
+{
+    adi_imu_Status status;
+    uint32_t head = imu->ring.head;
+    uint32_t tail = RING_LOAD_ACQUIRE(&imu->ring.tail);
+
+    /* An edge flagged on a shared bus may be scheduled after adi_imu_StreamStop() */
+    if (!imu->streaming)
+    {
+        return FALSE;
+    }
+    if ((head - tail + __atomic_load_n(&imu->reserved, __ATOMIC_ACQUIRE)) >= STREAM_RING_SIZE)
+    {
+        imu->ring.overruns++;
+        imu->streamStats.overruns++;
+        return FALSE;
+    }
+
+    __atomic_add_fetch(&imu->reserved, 1, __ATOMIC_ACQ_REL);
+#if ENABLE_TIMESTAMPS
+    /* The burst returns the newest sample, so it belongs to the newest edge */
+    imu->pipeline.slots[imu->pipeline.submitIdx].edgeNs = imu->edgeNs;
+#endif
+    status = adi_imu_PipelineSubmit(&imu->pipeline);
+    if (status == ADI_IMU_PIPELINE_FULL)
+    {
+        __atomic_sub_fetch(&imu->reserved, 1, __ATOMIC_ACQ_REL);
+        imu->ring.overruns++;
+        imu->streamStats.overruns++;
+        return FALSE;
+    }
+    if (status != ADI_IMU_SUCCESS)
+    {
+        /* Rejected by the transport, so no completion will arrive. Retire the failed slot here */
+        adi_imu_StreamBurstComplete(&imu->pipeline);
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Data-ready handler and ring buffer producer.
+ *
+ * @param context The device context registered by adi_imu_StreamStart().
+ *
+ * This function reserves a ring buffer slot and submits a single burst to the device burst pipeline. The
+ * data-ready context returns as soon as the burst is on the wire; decoding happens in
+ * adi_imu_StreamBurstComplete(), overlapping any burst submitted after it. If the ring buffer is full, or every
+ * pipeline slot is busy, the sample is dropped and the overrun counter is incremented; the consumer is never
+ * blocked. Devices on a shared bus only flag the edge here and are serviced by adi_imu_BusSchedule(). With
+ * ENABLE_TIMESTAMPS the edge time is taken first, before anything which could delay it.
+ **/
+void adi_imu_StreamDataReadyISR(void *context)
+{
+    adi_imu_Device *imu = (adi_imu_Device *) context;
+
+    if (!imu->streaming)
+    {
+        return;
+    }
+#if ENABLE_TIMESTAMPS
+    imu->edgeNs = timer_GetNanos();
+#endif
+
+    if (imu->bus)
+    {
+        __atomic_or_fetch(&imu->bus->pending, (1UL << imu->busIndex), __ATOMIC_ACQ_REL);
+        adi_imu_BusSchedule(imu->bus);
+    }
+    else
+    {
+        adi_imu_StreamSubmit(imu);
+    }
+}
+
+/**
+ * @brief Tracks DATA_CNTR across bursts.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param sample The freshly decoded sample.
+ *
+ * @return TRUE if the sample should be published, FALSE if it duplicates the previous one.
+ *
+ * This function counts the samples the IMU produced between two bursts without being read and tags the
+ * sample with its sequence number. The counter difference is taken modulo 2^16 so DATA_CNTR wrap-around is
+ * handled transparently. In scaled sync mode the counter is TIME_STAMP instead, which still exposes
+ * duplicates but not missed samples.
+ **/
+#if SUPPORTS_BURST_CNT
+static adi_imu_Boolean adi_imu_StreamTrackCount(adi_imu_Device *imu, adi_imu_UnscaledData *sample)
+{
+    uint16_t count = (uint16_t) sample->count;
+    uint16_t delta;
+
+    if (imu->countValid)
+    {
+        delta = (uint16_t) (count - imu->lastCount);
+        if (delta == 0)
+        {
+            imu->streamStats.duplicates++;
+            return FALSE;
+        }
+        if (imu->countIsTimeStamp)
+        {
+            delta = 1;
+        }
+        imu->streamStats.missed += delta - 1;
+#if ENABLE_SAMPLE_SEQUENCE
+        imu->sequence += delta;
+#endif
+    }
+    imu->lastCount = count;
+    imu->countValid = TRUE;
+#if ENABLE_SAMPLE_SEQUENCE
+    sample->sequence = imu->sequence;
+#endif
+
+    return TRUE;
+}
+#endif
+
+/**
+ * @brief Burst pipeline completion handler.
+ *
+ * @param pipe The device burst pipeline.
+ *
+ * This function decodes every completed burst, in order, straight into the slot reserved for it and only
+ * publishes a slot to the consumer once its transfer and checksum are known to be good and DATA_CNTR shows
+ * it is a new sample. On a shared bus it then hands the
+ * bus to the next device with a pending data-ready edge.
+ **/
+static void adi_imu_StreamBurstComplete(adi_imu_BurstPipeline *pipe)
+{
+    adi_imu_Device *imu = (adi_imu_Device *) pipe->context;
+    const uint8_t *burstRx;
+    adi_imu_Status status;
+    uint32_t head;
+#if ENABLE_TIMESTAMPS
+    uint64_t edgeNs;
+#endif
+
+    while (adi_imu_PipelineReady(pipe))
+    {
+        head = imu->ring.head;
+#if ENABLE_TIMESTAMPS
+        edgeNs = pipe->slots[pipe->decodeIdx].edgeNs;
+#endif
+        status = adi_imu_PipelineAcquire(pipe, &burstRx);
+        if (status != ADI_IMU_SUCCESS)
+        {
+            imu->streamStats.spiErrors++;
+        }
+        else if ((status = adi_imu_DecodeBurst(imu, burstRx, &imu->ring.samples[head & RING_MASK])) != ADI_IMU_SUCCESS)
+        {
+            /* The slot was never published, so the corrupt sample is simply overwritten by the next burst */
+            imu->streamStats.checksumErrors++;
+        }
+#if SUPPORTS_BURST_CNT
+        else if (!adi_imu_StreamTrackCount(imu, &imu->ring.samples[head & RING_MASK]))
+        {
+            /* Same sample read twice, leave the slot unpublished */
+        }
+#endif
+        else
+        {
+#if ENABLE_TIMESTAMPS
+            imu->ring.samples[head & RING_MASK].timestamp = adi_imu_TimeSyncUpdate(&imu->timeSync, (uint16_t) imu->ring.samples[head & RING_MASK].count, edgeNs);
+#endif
+            imu->streamStats.samples++;
+            RING_STORE_RELEASE(&imu->ring.head, head + 1);
+        }
+        (void) INSTR_RETURN(STREAM_BURST, status);
+        __atomic_sub_fetch(&imu->reserved, 1, __ATOMIC_ACQ_REL);
+        adi_imu_PipelineRelease(pipe);
+    }
+
+    if (imu->bus)
+    {
+        __atomic_store_n(&imu->bus->busy, FALSE, __ATOMIC_RELEASE);
+        adi_imu_BusSchedule(imu->bus);
+    }
+}
+
+/**
+ * @brief Gets the number of samples waiting in the ring buffer.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @return The number of samples which can be read without blocking.
+ **/
+uint16_t adi_imu_StreamAvailable(adi_imu_Device *imu)
+{
+    return (uint16_t) (RING_LOAD_ACQUIRE(&imu->ring.head) - imu->ring.tail);
+}
+
+/**
+ * @brief Drains a batch of samples from the ring buffer.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param buf A pointer to an array receiving the samples, oldest first.
+ *
+ * @param maxSamples The capacity of buf in samples.
+ *
+ * @param numRead A pointer to the number of samples copied into buf.
+ *
+ * @return ADI_IMU_STREAM_OVERRUN if samples were dropped since the previous call, ADI_IMU_SUCCESS otherwise.
+ *
+ * This function must only be called from a single consumer context per device. Any samples available are
+ * copied out even when an overrun is reported.
+ **/
+adi_imu_Status adi_imu_StreamRead(adi_imu_Device *imu, adi_imu_UnscaledData *buf, uint16_t maxSamples, uint16_t *numRead)
+{
+    adi_imu_Status status = ADI_IMU_SUCCESS;
+    adi_imu_SampleRing *ring = &imu->ring;
+    uint32_t head = RING_LOAD_ACQUIRE(&ring->head);
+    uint32_t tail = ring->tail;
+    uint32_t overruns;
+    uint16_t count = 0;
+
+    while ((tail != head) && (count < maxSamples))
+    {
+        buf[count] = ring->samples[tail & RING_MASK];
+        tail++;
+        count++;
+    }
+    /* Hand the slots back to the producer */
+    RING_STORE_RELEASE(&ring->tail, tail);
+    *numRead = count;
+
+    overruns = ring->overruns;
+    if (overruns != ring->overrunsReported)
+    {
+        ring->overrunsReported = overruns;
+        status = ADI_IMU_STREAM_OVERRUN;
+    }
+
+    return INSTR_RETURN(STREAM_READ, status);
+}
+
+/**
+ * @brief Gets the streaming engine statistics.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param stats A pointer to the statistics struct to be populated.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_StreamGetStats(adi_imu_Device *imu, adi_imu_StreamStats *stats)
+{
+    *stats = imu->streamStats;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Resets a shared bus scheduler.
+ *
+ * @param bus A pointer to the bus scheduler.
+ *
+ * @return A status code indicating the success of the subroutine.
+ **/
+adi_imu_Status adi_imu_BusInit(adi_imu_Bus *bus)
+{
+    bus->numDevices = 0;
+    bus->next = 0;
+    bus->pending = 0;
+    bus->busy = FALSE;
+    bus->scheduling = FALSE;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Attaches a device to a shared bus scheduler.
+ *
+ * @param bus A pointer to the bus scheduler.
+ *
+ * @param imu A pointer to an initialized device context wired to the bus.
+ *
+ * @return ADI_IMU_BUS_FULL if the scheduler has no room left, ADI_IMU_SUCCESS otherwise.
+ *
+ * Once attached, the data-ready handler of the device no longer starts bursts on its own. Bursts for every
+ * device on the bus are instead issued one at a time by adi_imu_BusSchedule().
+ **/
+adi_imu_Status adi_imu_BusAddDevice(adi_imu_Bus *bus, adi_imu_Device *imu)
+{
+    if (bus->numDevices >= BUS_MAX_DEVICES)
+    {
+        return ADI_IMU_BUS_FULL;
+    }
+    imu->bus = bus;
+    imu->busIndex = bus->numDevices;
+    bus->devices[bus->numDevices] = imu;
+    bus->numDevices++;
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Puts the next pending burst on a shared bus.
+ *
+ * @param bus A pointer to the bus scheduler.
+ *
+ * This function is called from the data-ready and burst completion contexts. Whenever the bus is idle it
+ * starts a burst for the next device with a pending data-ready edge, starting after the device served last,
+ * so every device gets an equal share of the bus and the bus never sits idle while an edge is pending.
+ * Nested calls return immediately; the outer call picks up any edge flagged in the meantime.
+ **/
+void adi_imu_BusSchedule(adi_imu_Bus *bus)
+{
+    adi_imu_Device *imu;
+    uint32_t pending;
+    uint8_t idx;
+
+    do
+    {
+        if (__atomic_exchange_n(&bus->scheduling, TRUE, __ATOMIC_ACQ_REL))
+        {
+            return;
+        }
+
+        while (!__atomic_load_n(&bus->busy, __ATOMIC_ACQUIRE) && ((pending = __atomic_load_n(&bus->pending, __ATOMIC_ACQUIRE)) != 0))
+        {
+            /* Find the next pending device in round-robin order */
+            idx = bus->next;
+            while (!(pending & (1UL << idx)))
+            {
+                idx = (idx + 1) % bus->numDevices;
+            }
+            bus->next = (idx + 1) % bus->numDevices;
+            __atomic_and_fetch(&bus->pending, ~(1UL << idx), __ATOMIC_ACQ_REL);
+
+            imu = bus->devices[idx];
+            __atomic_store_n(&bus->busy, TRUE, __ATOMIC_RELEASE);
+            if (!adi_imu_StreamSubmit(imu))
+            {
+                __atomic_store_n(&bus->busy, FALSE, __ATOMIC_RELEASE);
+            }
+        }
+
+        __atomic_store_n(&bus->scheduling, FALSE, __ATOMIC_RELEASE);
+    } while (!__atomic_load_n(&bus->busy, __ATOMIC_ACQUIRE) && (__atomic_load_n(&bus->pending, __ATOMIC_ACQUIRE) != 0));
+}
+
+#endif
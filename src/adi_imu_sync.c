@@ -0,0 +1,248 @@
+/**
+  * @file	    adi_imu_sync.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Sample clock configuration and host timestamping for the adi_imu driver.
+ **/
+
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+
+#if SUPPORTS_EXTERNAL_SYNC
+
+/**
+ * @brief Selects the sample clock source.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param mode The sample clock source.
+ *
+ * @param edge The sync input edge the IMU acts on. Ignored by SYNC_INTERNAL and SYNC_OUTPUT.
+ *
+ * @param syncHz The sync input frequency. SYNC_SCALED sets UP_SCALE from it and needs a frequency of at most
+ * SYNC_SCALED_MAX_HZ which divides MAX_DATA_RATE, e.g. 1 for a GNSS PPS. SYNC_DIRECT and SYNC_PULSE only use it
+ * as the nominal sample rate for timestamping. Ignored otherwise.
+ *
+ * @return ADI_IMU_INVALID_DATA_RATE if syncHz does not suit the mode, otherwise a status code indicating the
+ * success of the SPI transaction.
+ *
+ * Must not be called while the device is streaming. Restart the streaming engine afterwards so the
+ * timestamps follow the new sample clock.
+ **/
+adi_imu_Status adi_imu_SetSyncMode(adi_imu_Device *imu, adi_imu_SyncMode mode, adi_imu_EdgeType edge, uint16_t syncHz)
+{
+    adi_imu_RegWrite writes[2];
+    uint16_t numWrites = 0;
+    uint16_t miscCtrl;
+
+    if ((mode == SYNC_DIRECT) || (mode == SYNC_PULSE) || (mode == SYNC_SCALED))
+    {
+        if (syncHz == 0)
+        {
+            return ADI_IMU_INVALID_DATA_RATE;
+        }
+    }
+    if (mode == SYNC_SCALED)
+    {
+#if SUPPORTS_PPS
+        if ((syncHz > SYNC_SCALED_MAX_HZ) || ((MAX_DATA_RATE % syncHz) != 0))
+        {
+            return ADI_IMU_INVALID_DATA_RATE;
+        }
+        writes[numWrites].pageIDRegAddr = UP_SCALE;
+        writes[numWrites].val = (uint16_t) (MAX_DATA_RATE / syncHz);
+        numWrites++;
+#else
+        return ADI_IMU_INVALID_DATA_RATE;
+#endif
+    }
+
+    imu->status = adi_imu_ReadReg(imu, MISC_CTRL_REG, &miscCtrl);
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    miscCtrl &= ~(BITM_MISC_CTRL_REG_SYNC_FUNCTION | BITM_MISC_CTRL_REG_SYNC_POLARITY);
+    miscCtrl |= ((uint16_t) mode << BITP_MISC_CTRL_REG_SYNC_FUNCTION) & BITM_MISC_CTRL_REG_SYNC_FUNCTION;
+    if (edge == RISING_EDGE)
+    {
+        miscCtrl |= BITM_MISC_CTRL_REG_SYNC_POLARITY;
+    }
+    writes[numWrites].pageIDRegAddr = MISC_CTRL_REG;
+    writes[numWrites].val = miscCtrl;
+    numWrites++;
+
+    imu->status = adi_imu_WriteRegBatch(imu, writes, numWrites);
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->syncHz = ((mode == SYNC_INTERNAL) || (mode == SYNC_OUTPUT)) ? 0 : syncHz;
+    }
+
+    return imu->status;
+}
+
+#endif
+
+#if ENABLE_TIMESTAMPS
+
+/* Share of an early (negative) timestamp error removed per sample, as a power of two */
+#define TIMESYNC_OFFSET_SHIFT       3
+
+/* Weight of a late (positive) error relative to an early one, as a power of two. Interrupt latency only ever
+   delays the edge, so the estimate follows the earliest edges and lets the late ones pull it back slowly */
+#define TIMESYNC_LATE_SHIFT         6
+
+/* Share of the frequency error corrected per sample, as a power of two */
+#define TIMESYNC_SKEW_SHIFT         14
+
+/* Largest clock rate difference tracked, in ppb */
+#define TIMESYNC_MAX_SKEW_PPB       1000000
+
+/**
+ * @brief Resets a timestamp estimator for the current sample clock configuration.
+ *
+ * @param imu A pointer to the device context.
+ *
+ * @param ts A pointer to the estimator state.
+ *
+ * @return A status code indicating the success of the SPI transaction.
+ *
+ * The sample clock source, DEC_RATE and UP_SCALE are taken from the IMU, normally from the register cache.
+ * The streaming engine calls this from adi_imu_StreamStart().
+ **/
+adi_imu_Status adi_imu_TimeSyncInit(adi_imu_Device *imu, adi_imu_TimeSync *ts)
+{
+    adi_imu_TimeSync cleared = { 0 };
+    uint16_t miscCtrl;
+    uint16_t decRate;
+    uint64_t inputHz = MAX_DATA_RATE;
+#if SUPPORTS_PPS
+    uint16_t upScale;
+#endif
+
+    imu->status = adi_imu_ReadReg(imu, MISC_CTRL_REG, &miscCtrl);
+    if (imu->status == ADI_IMU_SUCCESS)
+    {
+        imu->status = adi_imu_ReadReg(imu, DECIMATE_REG, &decRate);
+    }
+    if (imu->status != ADI_IMU_SUCCESS)
+    {
+        return imu->status;
+    }
+    *ts = cleared;
+    ts->mode = (adi_imu_SyncMode) ((miscCtrl & BITM_MISC_CTRL_REG_SYNC_FUNCTION) >> BITP_MISC_CTRL_REG_SYNC_FUNCTION);
+
+#if SUPPORTS_PPS
+    if (ts->mode == SYNC_SCALED)
+    {
+        imu->status = adi_imu_ReadReg(imu, UP_SCALE, &upScale);
+        if (imu->status != ADI_IMU_SUCCESS)
+        {
+            return imu->status;
+        }
+        if (upScale == 0)
+        {
+            upScale = 1;
+        }
+        ts->syncPeriodNs = (imu->syncHz > 0) ? (1000000000UL / imu->syncHz) : (uint32_t) (1000000000ULL * upScale / MAX_DATA_RATE);
+        ts->periodNs = (uint32_t) ((uint64_t) ts->syncPeriodNs * (decRate + 1) / upScale);
+        return ADI_IMU_SUCCESS;
+    }
+#endif
+    if (((ts->mode == SYNC_DIRECT) || (ts->mode == SYNC_PULSE)) && (imu->syncHz > 0))
+    {
+        inputHz = imu->syncHz;
+    }
+    ts->periodNs = (uint32_t) (1000000000ULL * (decRate + 1) / inputHz);
+
+    return ADI_IMU_SUCCESS;
+}
+
+/**
+ * @brief Fuses the data-ready edge time of a sample with its DATA_CNTR or TIME_STAMP.
+ *
+ * @param ts A pointer to the estimator state.
+ *
+ * @param count The DATA_CNTR of the sample, or its TIME_STAMP in SYNC_SCALED.
+ *
+ * @param edgeNs The host time of the data-ready edge of the sample, from timer_GetNanos().
+ *
+ * @return The estimated host time of the sample.
+ *
+ * The counter places every sample on the IMU sample clock, gaps included, so a missed edge or a burst read
+ * late costs nothing. In SYNC_SCALED the sample clock is the sync input itself and TIME_STAMP only has to
+ * pick the sample slot after the last pulse. A second-order loop then tracks the host time of that clock:
+ * the offset follows the earliest edges seen, which removes the interrupt latency jitter, and the skew
+ * follows the drift between the IMU, or sync source, and the host clock. Each update is a handful of integer
+ * operations. A sample repeating the previous counter gets the previous timestamp.
+ **/
+uint64_t adi_imu_TimeSyncUpdate(adi_imu_TimeSync *ts, uint16_t count, uint64_t edgeNs)
+{
+    uint64_t deviceNs;
+    int64_t dx;
+    int64_t predicted;
+    int64_t error;
+    int64_t weighted;
+    int64_t skew;
+
+    if (ts->valid && (count == ts->lastCount))
+    {
+        return ts->hostNs - TIMESYNC_LATENCY_NS;
+    }
+
+    /* Place the sample on the IMU time line */
+#if SUPPORTS_PPS
+    if (ts->mode == SYNC_SCALED)
+    {
+        if (ts->valid && (count < ts->lastCount))
+        {
+            ts->pulseNs += ts->syncPeriodNs;
+        }
+        deviceNs = ts->pulseNs + (((uint64_t) count * TIME_STAMP_LSB_NS + ts->periodNs / 2) / ts->periodNs) * ts->periodNs;
+    }
+    else
+#endif
+    {
+        deviceNs = ts->deviceNs + (uint64_t) (uint16_t) (count - ts->lastCount) * ts->periodNs;
+    }
+    ts->lastCount = count;
+
+    if (!ts->valid)
+    {
+        ts->valid = TRUE;
+        ts->deviceNs = deviceNs;
+        ts->hostNs = edgeNs;
+        ts->skewPpb = 0;
+        return ts->hostNs - TIMESYNC_LATENCY_NS;
+    }
+
+    dx = (int64_t) (deviceNs - ts->deviceNs);
+    predicted = (int64_t) ts->hostNs + dx + (dx * ts->skewPpb) / 1000000000LL;
+    error = (int64_t) edgeNs - predicted;
+    if ((error > TIMESYNC_RESYNC_NS) || (error < -TIMESYNC_RESYNC_NS) || (dx <= 0))
+    {
+        /* Lost track, e.g. the sync input stopped. Start over from this edge */
+        ts->deviceNs = deviceNs;
+        ts->hostNs = edgeNs;
+        ts->skewPpb = 0;
+        return ts->hostNs - TIMESYNC_LATENCY_NS;
+    }
+
+    weighted = (error < 0) ? error : (error / (1 << TIMESYNC_LATE_SHIFT));
+    skew = ts->skewPpb + (weighted * 1000000000LL / dx) / (1 << TIMESYNC_SKEW_SHIFT);
+    if (skew > TIMESYNC_MAX_SKEW_PPB)
+    {
+        skew = TIMESYNC_MAX_SKEW_PPB;
+    }
+    else if (skew < -TIMESYNC_MAX_SKEW_PPB)
+    {
+        skew = -TIMESYNC_MAX_SKEW_PPB;
+    }
+    ts->skewPpb = (int32_t) skew;
+    ts->deviceNs = deviceNs;
+    ts->hostNs = (uint64_t) (predicted + weighted / (1 << TIMESYNC_OFFSET_SHIFT));
+
+    return ts->hostNs - TIMESYNC_LATENCY_NS;
+}
+
+#endif
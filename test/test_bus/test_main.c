@@ -0,0 +1,264 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Four simulated IMUs streaming through one shared-bus scheduler.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_STREAMING
+
+/* IMUs sharing the bus, one per simulated chip select */
+#define TEST_NUM_IMUS                   4
+
+/* Virtual time each test streams for, in milliseconds */
+#define TEST_STREAM_MS                  1000
+
+/* Shift of the tag word within a decoded output. 16-bit bursts only carry the upper word of each output */
+#if SENSOR_DATA_32BIT
+    #define TEST_TAG_SHIFT              16
+#else
+    #define TEST_TAG_SHIFT              0
+#endif
+
+/* Output rate of each IMU. Different rates make any cross-talk between the devices show up in the counters */
+static const uint16_t test_Rates[TEST_NUM_IMUS] = { 200, 100, 50, 25 };
+
+static adi_imu_Device test_Imus[TEST_NUM_IMUS];
+static adi_imu_Bus test_Bus;
+
+/* Samples read back from each IMU and the last one seen, for the sequence checks */
+static uint32_t test_Samples[TEST_NUM_IMUS];
+static uint32_t test_BadOwner[TEST_NUM_IMUS];
+static uint32_t test_BadSequence[TEST_NUM_IMUS];
+static int32_t test_LastIndex[TEST_NUM_IMUS];
+
+/**
+ * @brief Sample source tagging the upper word of every output with the chip select of the IMU and the sample index.
+ **/
+static void test_Source(uint8_t csPin, uint32_t index, imu_sim_Sample *sample, void *context)
+{
+    int32_t tag = (int32_t) (((csPin + 1) << 12) | (index & 0x0FFF)) << 16;
+
+    (void) context;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        sample->gyro[i] = tag;
+        sample->accel[i] = -tag;
+        sample->deltaAngle[i] = tag;
+        sample->deltaVelocity[i] = -tag;
+    }
+    sample->temperature = (int16_t) csPin;
+}
+
+/**
+ * @brief Drains the ring of every IMU and checks each sample belongs to it and follows the previous one.
+ **/
+static void test_Drain(void)
+{
+    static adi_imu_UnscaledData buf[STREAM_RING_SIZE];
+    uint16_t numRead;
+
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imus[d], buf, STREAM_RING_SIZE, &numRead));
+        for (uint16_t i = 0; i < numRead; i++)
+        {
+            int32_t tag = buf[i].xg >> TEST_TAG_SHIFT;
+            int32_t index = tag & 0x0FFF;
+
+            if (((tag >> 12) != d + 1) || (buf[i].za != -buf[i].xg) || (buf[i].temperature != d))
+            {
+                test_BadOwner[d]++;
+            }
+            if ((test_LastIndex[d] >= 0) && (index <= test_LastIndex[d]))
+            {
+                test_BadSequence[d]++;
+            }
+            test_LastIndex[d] = index;
+        }
+        test_Samples[d] += numRead;
+    }
+}
+
+/**
+ * @brief Streams every IMU for TEST_STREAM_MS, draining the rings once per millisecond.
+ **/
+static void test_Stream(void)
+{
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imus[d], DIO1, RISING_EDGE));
+    }
+    imu_sim_ClearStats();
+    for (uint32_t ms = 0; ms < TEST_STREAM_MS; ms++)
+    {
+        delay_MS(1);
+        test_Drain();
+    }
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        adi_imu_StreamStop(&test_Imus[d]);
+    }
+    test_Drain();
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    adi_imu_BusInit(&test_Bus);
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        imu_sim_SetSampleSource(d, test_Source, 0);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imus[d], d));
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetDataRate(&test_Imus[d], test_Rates[d]));
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_BusAddDevice(&test_Bus, &test_Imus[d]));
+        test_Samples[d] = 0;
+        test_BadOwner[d] = 0;
+        test_BadSequence[d] = 0;
+        test_LastIndex[d] = -1;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/* Every sample read from an IMU carries its own tag, in order */
+void test_bus_no_data_crosstalk(void)
+{
+    test_Stream();
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_GREATER_THAN_UINT32(0, test_Samples[d]);
+        TEST_ASSERT_EQUAL_UINT32(0, test_BadOwner[d]);
+        TEST_ASSERT_EQUAL_UINT32(0, test_BadSequence[d]);
+    }
+}
+
+/* Each IMU delivers its own rate and its counters only count its own bursts */
+void test_bus_per_device_counters(void)
+{
+    adi_imu_StreamStats stats;
+    imu_sim_Stats simStats;
+
+    test_Stream();
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        uint32_t expected = (uint32_t) test_Rates[d] * TEST_STREAM_MS / 1000;
+
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imus[d], &stats));
+        TEST_ASSERT_UINT32_WITHIN(1, expected, test_Samples[d]);
+        TEST_ASSERT_EQUAL_UINT32(test_Samples[d], stats.samples);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.overruns);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.spiErrors);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.checksumErrors);
+#if SUPPORTS_BURST_CNT
+        TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+#endif
+
+        imu_sim_GetStats(d, &simStats);
+        TEST_ASSERT_EQUAL_UINT32(stats.samples, simStats.bursts);
+        TEST_ASSERT_EQUAL_UINT32(0, simStats.stallViolations);
+        TEST_ASSERT_EQUAL_UINT32(0, simStats.busyViolations);
+    }
+}
+
+/* Stopping one IMU leaves the others streaming */
+void test_bus_stop_one_device(void)
+{
+    adi_imu_StreamStats stats;
+
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imus[d], DIO1, RISING_EDGE));
+    }
+    adi_imu_StreamStop(&test_Imus[1]);
+    for (uint32_t ms = 0; ms < TEST_STREAM_MS; ms++)
+    {
+        delay_MS(1);
+        test_Drain();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, test_Samples[1]);
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imus[d], &stats));
+        TEST_ASSERT_EQUAL_UINT32(0, stats.overruns);
+        TEST_ASSERT_EQUAL_UINT32(0, test_BadOwner[d]);
+        if (d != 1)
+        {
+            TEST_ASSERT_UINT32_WITHIN(1, (uint32_t) test_Rates[d] * TEST_STREAM_MS / 1000, test_Samples[d]);
+        }
+    }
+}
+
+/* An edge still pending on the bus when its device stops is dropped, not turned into a burst */
+void test_bus_stop_drops_pending_edge(void)
+{
+    imu_sim_Stats simStats;
+    uint32_t bursts;
+
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imus[d], DIO1, RISING_EDGE));
+    }
+    for (uint32_t ms = 0; ms < TEST_STREAM_MS / 10; ms++)
+    {
+        delay_MS(1);
+        test_Drain();
+    }
+
+    /* Flagged as if the edge arrived while another device held the bus */
+    __atomic_or_fetch(&test_Bus.pending, 1UL << 1, __ATOMIC_ACQ_REL);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStop(&test_Imus[1]));
+    TEST_ASSERT_EQUAL_HEX32(0, test_Bus.pending & (1UL << 1));
+    imu_sim_GetStats(1, &simStats);
+    bursts = simStats.bursts;
+
+    /* Flagged after the stop, the scheduler must still not read the stopped device */
+    __atomic_or_fetch(&test_Bus.pending, 1UL << 1, __ATOMIC_ACQ_REL);
+    for (uint32_t ms = 0; ms < TEST_STREAM_MS / 10; ms++)
+    {
+        delay_MS(1);
+        test_Drain();
+    }
+    imu_sim_GetStats(1, &simStats);
+    TEST_ASSERT_EQUAL_UINT32(bursts, simStats.bursts);
+    TEST_ASSERT_EQUAL_UINT16(0, adi_imu_StreamAvailable(&test_Imus[1]));
+    for (uint8_t d = 0; d < TEST_NUM_IMUS; d++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0, test_BadOwner[d]);
+        TEST_ASSERT_EQUAL_UINT32(0, test_BadSequence[d]);
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_STREAMING
+    RUN_TEST(test_bus_no_data_crosstalk);
+    RUN_TEST(test_bus_per_device_counters);
+    RUN_TEST(test_bus_stop_one_device);
+    RUN_TEST(test_bus_stop_drops_pending_edge);
+#endif
+    return UNITY_END();
+}
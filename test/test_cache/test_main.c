@@ -0,0 +1,201 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Register shadow cache policies: immutable, write-through and volatile registers.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_REG_CACHE
+
+static adi_imu_Device test_Imu;
+static imu_sim_Stats test_SimStats;
+
+/**
+ * @brief Reads a register through the driver and returns how many SPI transfers it took.
+ **/
+static uint32_t test_Read(uint16_t reg, uint16_t *val)
+{
+    uint32_t before;
+
+    imu_sim_GetStats(0, &test_SimStats);
+    before = test_SimStats.transfers;
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadReg(&test_Imu, reg, val));
+    imu_sim_GetStats(0, &test_SimStats);
+    return test_SimStats.transfers - before;
+}
+
+/**
+ * @brief Gets the cache statistics of the test IMU.
+ **/
+static adi_imu_CacheStats test_Stats(void)
+{
+    adi_imu_CacheStats stats;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_GetCacheStats(&test_Imu, &stats));
+    return stats;
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    /* Start every test from an empty cache */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CacheReset(&test_Imu));
+}
+
+void tearDown(void)
+{
+}
+
+/* An immutable register is read from the IMU once and served from memory afterwards, even after an invalidate */
+void test_cache_immutable_read_once(void)
+{
+    uint16_t prodId = imu_sim_PeekReg(0, PROD_ID);
+    uint16_t val;
+    adi_imu_CacheStats stats;
+
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(PROD_ID, &val));
+    TEST_ASSERT_EQUAL_HEX16(prodId, val);
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(PROD_ID, &val));
+    TEST_ASSERT_EQUAL_HEX16(prodId, val);
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CacheInvalidate(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(PROD_ID, &val));
+    TEST_ASSERT_EQUAL_HEX16(prodId, val);
+
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hits);
+}
+
+/* A write-through register reaches the IMU on every write and reads back the written value without bus traffic */
+void test_cache_write_through(void)
+{
+    uint32_t before;
+    uint16_t val;
+    adi_imu_CacheStats stats;
+
+    imu_sim_GetStats(0, &test_SimStats);
+    before = test_SimStats.transfers;
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, FILT_CTRL, 0x0003));
+    imu_sim_GetStats(0, &test_SimStats);
+    TEST_ASSERT_GREATER_THAN_UINT32(before, test_SimStats.transfers);
+    TEST_ASSERT_EQUAL_HEX16(0x0003, imu_sim_PeekReg(0, FILT_CTRL));
+
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(FILT_CTRL, &val));
+    TEST_ASSERT_EQUAL_HEX16(0x0003, val);
+
+    /* A second write replaces the shadow copy */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, FILT_CTRL, 0x0005));
+    TEST_ASSERT_EQUAL_HEX16(0x0005, imu_sim_PeekReg(0, FILT_CTRL));
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(FILT_CTRL, &val));
+    TEST_ASSERT_EQUAL_HEX16(0x0005, val);
+
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hits);
+}
+
+/* A write-through register which was never written is filled by its first read */
+void test_cache_write_through_fill_on_read(void)
+{
+    uint16_t decRate = imu_sim_PeekReg(0, DEC_RATE);
+    uint16_t val;
+    adi_imu_CacheStats stats;
+
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(DEC_RATE, &val));
+    TEST_ASSERT_EQUAL_HEX16(decRate, val);
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(DEC_RATE, &val));
+    TEST_ASSERT_EQUAL_HEX16(decRate, val);
+
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+}
+
+/* Invalidating drops the write-through copies, so a change made behind the driver's back is picked up */
+void test_cache_invalidate_drops_write_through(void)
+{
+    uint16_t val;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, FILT_CTRL, 0x0002));
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(PROD_ID, &val));
+    imu_sim_PokeReg(0, FILT_CTRL, 0x0004);
+
+    /* Stale until invalidated */
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(FILT_CTRL, &val));
+    TEST_ASSERT_EQUAL_HEX16(0x0002, val);
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CacheInvalidate(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(FILT_CTRL, &val));
+    TEST_ASSERT_EQUAL_HEX16(0x0004, val);
+    TEST_ASSERT_EQUAL_UINT32(0, test_Read(PROD_ID, &val));
+}
+
+/* Volatile registers always go to the IMU and are not counted as hits or misses */
+void test_cache_volatile_always_read(void)
+{
+    uint16_t val;
+    adi_imu_CacheStats stats;
+
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        imu_sim_PokeReg(0, USER_SCR1, (uint16_t) (0x1230 + i));
+        TEST_ASSERT_EQUAL_UINT32(1, test_Read(USER_SCR1, &val));
+        TEST_ASSERT_EQUAL_HEX16(0x1230 + i, val);
+        TEST_ASSERT_EQUAL_UINT32(1, test_Read(DIAG_STAT, &val));
+    }
+
+    /* Writes to a volatile register do not create a shadow copy either */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, USER_SCR1, 0x5A5A));
+    imu_sim_PokeReg(0, USER_SCR1, 0xA5A5);
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(USER_SCR1, &val));
+    TEST_ASSERT_EQUAL_HEX16(0xA5A5, val);
+
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hits);
+}
+
+/* A software reset reloads the configuration from flash, so the write-through copies are dropped */
+void test_cache_software_reset_invalidates(void)
+{
+    uint16_t val;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, FILT_CTRL, 0x0006));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SoftwareReset(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(1, test_Read(FILT_CTRL, &val));
+    TEST_ASSERT_EQUAL_HEX16(imu_sim_PeekReg(0, FILT_CTRL), val);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_REG_CACHE
+    RUN_TEST(test_cache_immutable_read_once);
+    RUN_TEST(test_cache_write_through);
+    RUN_TEST(test_cache_write_through_fill_on_read);
+    RUN_TEST(test_cache_invalidate_drops_write_through);
+    RUN_TEST(test_cache_volatile_always_read);
+    RUN_TEST(test_cache_software_reset_invalidates);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Capture state machine: start, wait, record load and capture buffer download.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if SUPPORTS_CAPTURE
+
+/* Records stored before each test, so the first capture is record TEST_RECORDS */
+#define TEST_RECORDS                    7
+
+/* Time one capture takes in the simulator at the default AVG_CNT, in ns */
+#define TEST_CAPTURE_NS                 ((uint64_t) CAPTURE_TIME_SAMPLES * (1000000000ULL / IMU_SIM_BASE_RATE))
+
+static adi_imu_Device test_Imu;
+
+/**
+ * @brief Read command word of a register on page 0.
+ **/
+static uint16_t test_ReadWord(uint16_t reg)
+{
+    return (uint16_t) ((reg & 0xFF) << 8);
+}
+
+/**
+ * @brief Byte write command word of a register on page 0.
+ **/
+static uint16_t test_WriteWord(uint16_t reg, uint8_t val)
+{
+    return (uint16_t) (((0x80 | (reg & 0xFF)) << 8) | val);
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetRecordMode(&test_Imu, REC_MODE_MANUAL_TIME));
+    imu_sim_PokeReg(0, REG_REC_CNTR, TEST_RECORDS);
+}
+
+void tearDown(void)
+{
+}
+
+/* Starting a capture latches REC_CNTR, then sets the capture bit, and returns before the record is complete */
+void test_capture_start_latches_counter(void)
+{
+    const uint16_t expected[] = {
+        test_ReadWord(REG_REC_CNTR), 0x0000,
+        test_WriteWord(COMMAND_REG, BITM_COMMAND_REG_CAPTURE & 0xFF),
+        test_WriteWord(COMMAND_REG + 1, BITM_COMMAND_REG_CAPTURE >> 8),
+    };
+    uint16_t trace[8];
+
+    imu_sim_StartTrace(0, trace, 8);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StartCapture(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT16(4, imu_sim_StopTrace(0));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, trace, 4);
+    TEST_ASSERT_EQUAL_UINT16(TEST_RECORDS, test_Imu.recordCount);
+    TEST_ASSERT_EQUAL_UINT16(TEST_RECORDS, imu_sim_PeekReg(0, REG_REC_CNTR));
+}
+
+/* Waiting less than the capture takes times out, and waiting again returns once REC_CNTR has moved on, within
+   one poll interval of the end of the capture */
+void test_capture_wait_and_timeout(void)
+{
+    uint64_t startNs;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StartCapture(&test_Imu));
+    startNs = imu_sim_Now();
+
+    TEST_ASSERT_EQUAL(ADI_IMU_CAPTURE_TIMEOUT, adi_imu_WaitCapture(&test_Imu, 5));
+    TEST_ASSERT_EQUAL(ADI_IMU_CAPTURE_TIMEOUT, test_Imu.status);
+    TEST_ASSERT_EQUAL_UINT16(TEST_RECORDS, imu_sim_PeekReg(0, REG_REC_CNTR));
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WaitCapture(&test_Imu, 100));
+    TEST_ASSERT_EQUAL_UINT16(TEST_RECORDS + 1, imu_sim_PeekReg(0, REG_REC_CNTR));
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs >= TEST_CAPTURE_NS);
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs < TEST_CAPTURE_NS + 2000000ULL * CAPTURE_POLL_INTERVAL_MS);
+}
+
+/* A download points BUF_PNTR at the first entry and then only reads the axis buffer register, across several
+   transactions. Loading a stored record replaces the buffer contents */
+void test_capture_load_record_and_read_buffer(void)
+{
+    const uint16_t start = 100;
+    const uint16_t count = 70;
+    uint16_t out[70];
+    uint16_t trace[80];
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StartCapture(&test_Imu));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WaitCapture(&test_Imu, 100));
+
+    imu_sim_StartTrace(0, trace, 80);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadCaptureBuffer(&test_Imu, CAPTURE_AXIS_Y, start, count, out));
+    TEST_ASSERT_EQUAL_UINT16(2 + count + 1, imu_sim_StopTrace(0));
+    TEST_ASSERT_EQUAL_HEX16(test_WriteWord(REG_BUF_PNTR, start & 0xFF), trace[0]);
+    TEST_ASSERT_EQUAL_HEX16(test_WriteWord(REG_BUF_PNTR + 1, start >> 8), trace[1]);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX16(test_ReadWord(CAPTURE_BUF_REG(CAPTURE_AXIS_Y)), trace[2 + i]);
+        TEST_ASSERT_EQUAL_HEX16(imu_sim_CaptureSample(0, TEST_RECORDS, CAPTURE_AXIS_Y, start + i), out[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX16(0x0000, trace[2 + count]);
+    TEST_ASSERT_EQUAL_UINT16(start + count, imu_sim_PeekReg(0, REG_BUF_PNTR));
+
+    imu_sim_StartTrace(0, trace, 80);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_LoadRecord(&test_Imu, 3));
+    TEST_ASSERT_EQUAL_UINT16(2, imu_sim_StopTrace(0));
+    TEST_ASSERT_EQUAL_HEX16(test_WriteWord(REG_REC_PNTR, 3), trace[0]);
+    TEST_ASSERT_EQUAL_HEX16(test_WriteWord(REG_REC_PNTR + 1, 0), trace[1]);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadCaptureBuffer(&test_Imu, CAPTURE_AXIS_X, 0, 10, out));
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX16(imu_sim_CaptureSample(0, 3, CAPTURE_AXIS_X, i), out[i]);
+    }
+}
+
+/* A full capture lays the axes out one after the other */
+void test_capture_record_all_axes(void)
+{
+    const uint16_t samplesPerAxis = 48;
+    uint16_t out[CAPTURE_AXES * 48];
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CaptureRecord(&test_Imu, 100, samplesPerAxis, out));
+    for (uint8_t axis = 0; axis < CAPTURE_AXES; axis++)
+    {
+        for (uint16_t i = 0; i < samplesPerAxis; i++)
+        {
+            TEST_ASSERT_EQUAL_HEX16(imu_sim_CaptureSample(0, TEST_RECORDS, axis, i), out[axis * samplesPerAxis + i]);
+        }
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if SUPPORTS_CAPTURE
+    RUN_TEST(test_capture_start_latches_counter);
+    RUN_TEST(test_capture_wait_and_timeout);
+    RUN_TEST(test_capture_load_record_and_read_buffer);
+    RUN_TEST(test_capture_record_all_axes);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,200 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Burst checksum verification against injected bit flips.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_BURST_MODE & VERIFY_BURST_CHECKSUM
+
+/* Virtual time the streaming test runs for, in milliseconds */
+#define TEST_STREAM_MS                  100
+
+static adi_imu_Device test_Imu;
+
+/* Payload bytes of the burst of the detected model, everything after the trigger word */
+static uint16_t test_PayloadLength(void)
+{
+    return test_Imu.model->burstXferLength - 2;
+}
+
+/**
+ * @brief Reads one burst into rx without decoding it.
+ **/
+static void test_CaptureBurst(uint8_t *rx)
+{
+    uint8_t tx[BURST_XFER_LENGTH];
+    adi_imu_SpiXfer xfer;
+
+    xfer.txBuf = tx;
+    xfer.rxBuf = rx;
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SubmitBurst(&test_Imu, &xfer, 0, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WaitTransfer(&xfer));
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+}
+
+void tearDown(void)
+{
+}
+
+/* Clean bursts are accepted and not counted */
+void test_checksum_clean_bursts_pass(void)
+{
+    adi_imu_UnscaledData data;
+
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        delay_US(500);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_GetSensorData(&test_Imu, &data));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, test_Imu.checksumErrors);
+}
+
+/* Every single-bit flip of every payload byte, checksum included, is rejected and counted */
+void test_checksum_single_bit_flips(void)
+{
+    adi_imu_UnscaledData data;
+    uint32_t flips = 0;
+
+    for (uint16_t byte = 0; byte < test_PayloadLength(); byte++)
+    {
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            imu_sim_CorruptNextBurst(0, byte, (uint8_t) (1 << bit));
+            TEST_ASSERT_EQUAL(ADI_IMU_BURST_CHECKSUM_FAILED, adi_imu_GetSensorData(&test_Imu, &data));
+            flips++;
+            TEST_ASSERT_EQUAL_UINT32(flips, test_Imu.checksumErrors);
+        }
+    }
+    /* The next burst is clean again */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_GetSensorData(&test_Imu, &data));
+}
+
+/* Multi-bit flips within one byte always change the byte sum */
+void test_checksum_multi_bit_flips_in_one_byte(void)
+{
+    static const uint8_t masks[] = { 0x03, 0x81, 0x5A, 0xF0, 0xFF };
+    adi_imu_UnscaledData data;
+    uint32_t flips = 0;
+
+    for (uint16_t byte = 0; byte < test_PayloadLength(); byte++)
+    {
+        for (uint8_t m = 0; m < sizeof(masks); m++)
+        {
+            imu_sim_CorruptNextBurst(0, byte, masks[m]);
+            TEST_ASSERT_EQUAL(ADI_IMU_BURST_CHECKSUM_FAILED, adi_imu_GetSensorData(&test_Imu, &data));
+            flips++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(flips, test_Imu.checksumErrors);
+}
+
+/* Flips spread over several data bytes. The checksum is a byte sum, so only flips which cannot cancel are used:
+   every flipped bit goes from 0 to 1, and the checksum word itself is left alone */
+void test_checksum_multi_byte_flips(void)
+{
+    uint8_t burst[BURST_XFER_LENGTH];
+    uint8_t corrupted[BURST_XFER_LENGTH];
+    adi_imu_UnscaledData data;
+    uint16_t len = test_PayloadLength() - 2;
+
+    delay_US(500);
+    test_CaptureBurst(burst);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DecodeBurst(&test_Imu, burst, &data));
+
+    for (uint16_t first = 0; first < len; first++)
+    {
+        for (uint8_t spread = 1; spread <= 3; spread++)
+        {
+            uint8_t flipped = 0;
+
+            for (uint16_t i = 0; i < sizeof(corrupted); i++)
+            {
+                corrupted[i] = burst[i];
+            }
+            for (uint16_t byte = first; (byte < len) && (flipped <= spread); byte += spread + 1)
+            {
+                uint8_t zeros = (uint8_t) ~corrupted[2 + byte];
+
+                if (zeros)
+                {
+                    /* Set the lowest clear bit */
+                    corrupted[2 + byte] |= (uint8_t) (zeros & -zeros);
+                    flipped++;
+                }
+            }
+            if (flipped < 2)
+            {
+                continue;
+            }
+            TEST_ASSERT_EQUAL(ADI_IMU_BURST_CHECKSUM_FAILED, adi_imu_DecodeBurst(&test_Imu, corrupted, &data));
+        }
+    }
+}
+
+/* A corrupted burst is dropped by the streaming engine and counted, the rest of the stream is unaffected */
+void test_checksum_stream_drops_corrupted_burst(void)
+{
+    static adi_imu_UnscaledData buf[STREAM_RING_SIZE];
+    adi_imu_StreamStats stats;
+    imu_sim_Stats simStats;
+    uint32_t samples = 0;
+    uint16_t numRead;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetDataRate(&test_Imu, 200));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imu, DIO1, RISING_EDGE));
+    imu_sim_ClearStats();
+    for (uint32_t ms = 0; ms < TEST_STREAM_MS; ms++)
+    {
+        if (ms == TEST_STREAM_MS / 2)
+        {
+            imu_sim_CorruptNextBurst(0, 3, 0x10);
+        }
+        delay_MS(1);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imu, buf, STREAM_RING_SIZE, &numRead));
+        samples += numRead;
+    }
+    adi_imu_StreamStop(&test_Imu);
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imu, &stats));
+    imu_sim_GetStats(0, &simStats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.checksumErrors);
+    TEST_ASSERT_EQUAL_UINT32(simStats.bursts - 1, samples);
+    TEST_ASSERT_EQUAL_UINT32(samples, stats.samples);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_BURST_MODE & VERIFY_BURST_CHECKSUM
+    RUN_TEST(test_checksum_clean_bursts_pass);
+    RUN_TEST(test_checksum_single_bit_flips);
+    RUN_TEST(test_checksum_multi_bit_flips_in_one_byte);
+    RUN_TEST(test_checksum_multi_byte_flips);
+    RUN_TEST(test_checksum_stream_drops_corrupted_burst);
+#endif
+    return UNITY_END();
+}
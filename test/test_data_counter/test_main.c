@@ -0,0 +1,189 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		DATA_CNTR tracking of the streaming engine: skipped samples, duplicates and wrap-around.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_STREAMING & SUPPORTS_BURST_CNT
+
+/* Output rate used by every test, in Hz */
+#define TEST_RATE_HZ                    200
+
+static adi_imu_Device test_Imu;
+static adi_imu_UnscaledData test_Buf[STREAM_RING_SIZE];
+static uint32_t test_Samples;
+
+/**
+ * @brief Streams for a number of milliseconds, draining the ring once per millisecond.
+ **/
+static void test_Run(uint32_t ms)
+{
+    uint16_t numRead;
+
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        delay_MS(1);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imu, test_Buf, STREAM_RING_SIZE, &numRead));
+        test_Samples += numRead;
+    }
+}
+
+/**
+ * @brief Gets the streaming statistics of the test IMU.
+ **/
+static adi_imu_StreamStats test_Stats(void)
+{
+    adi_imu_StreamStats stats;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imu, &stats));
+    return stats;
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetDataRate(&test_Imu, TEST_RATE_HZ));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imu, DIO1, RISING_EDGE));
+    test_Samples = 0;
+}
+
+void tearDown(void)
+{
+    adi_imu_StreamStop(&test_Imu);
+}
+
+/* A stream read on every data-ready edge neither misses nor repeats a sample */
+void test_counter_clean_stream(void)
+{
+    adi_imu_StreamStats stats;
+
+    test_Run(1000);
+    stats = test_Stats();
+    TEST_ASSERT_UINT32_WITHIN(1, TEST_RATE_HZ, test_Samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+}
+
+/* A jump of DATA_CNTR is reported as that many missed samples */
+void test_counter_skip_is_counted(void)
+{
+    adi_imu_StreamStats stats;
+    uint16_t count;
+
+    test_Run(50);
+    count = imu_sim_PeekReg(0, DATA_CNTR);
+    imu_sim_PokeReg(0, DATA_CNTR, (uint16_t) (count + 5));
+    test_Run(50);
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(5, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+
+    count = imu_sim_PeekReg(0, DATA_CNTR);
+    imu_sim_PokeReg(0, DATA_CNTR, (uint16_t) (count + 1000));
+    test_Run(50);
+    stats = test_Stats();
+    TEST_ASSERT_EQUAL_UINT32(1005, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(test_Samples, stats.samples);
+}
+
+/* A burst whose DATA_CNTR did not advance is discarded and counted as a duplicate */
+void test_counter_duplicate_is_dropped(void)
+{
+    adi_imu_StreamStats stats;
+    imu_sim_Stats simStats;
+    uint16_t count;
+
+    imu_sim_ClearStats();
+    test_Run(50);
+    count = imu_sim_PeekReg(0, DATA_CNTR);
+    imu_sim_PokeReg(0, DATA_CNTR, (uint16_t) (count - 1));
+    test_Run(50);
+    stats = test_Stats();
+    imu_sim_GetStats(0, &simStats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.duplicates);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(simStats.bursts - 1, test_Samples);
+}
+
+/* DATA_CNTR wrapping from 0xFFFF to 0x0000 is a normal increment */
+void test_counter_wrap_around(void)
+{
+    adi_imu_StreamStats stats;
+    uint16_t count;
+
+    test_Run(20);
+    count = imu_sim_PeekReg(0, DATA_CNTR);
+    imu_sim_PokeReg(0, DATA_CNTR, 0xFFFD);
+    test_Run(100);
+    stats = test_Stats();
+    TEST_ASSERT_TRUE(imu_sim_PeekReg(0, DATA_CNTR) < 0x0100);
+    /* Only the jump to 0xFFFD is a skip, crossing the wrap is not */
+    TEST_ASSERT_EQUAL_UINT32(0xFFFD - count, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+}
+
+#if ENABLE_SAMPLE_SEQUENCE
+/* Missed samples leave matching gaps in the sequence numbers */
+void test_counter_sequence_gaps(void)
+{
+    uint16_t numRead;
+    uint64_t last = 0;
+    uint64_t gaps = 0;
+    adi_imu_Boolean haveLast = FALSE;
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        if (i == 50)
+        {
+            imu_sim_PokeReg(0, DATA_CNTR, (uint16_t) (imu_sim_PeekReg(0, DATA_CNTR) + 7));
+        }
+        delay_MS(1);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imu, test_Buf, STREAM_RING_SIZE, &numRead));
+        for (uint16_t j = 0; j < numRead; j++)
+        {
+            if (haveLast)
+            {
+                gaps += test_Buf[j].sequence - last - 1;
+            }
+            last = test_Buf[j].sequence;
+            haveLast = TRUE;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(7, (uint32_t) gaps);
+}
+#endif
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_STREAMING & SUPPORTS_BURST_CNT
+    RUN_TEST(test_counter_clean_stream);
+    RUN_TEST(test_counter_skip_is_counted);
+    RUN_TEST(test_counter_duplicate_is_dropped);
+    RUN_TEST(test_counter_wrap_around);
+#if ENABLE_SAMPLE_SEQUENCE
+    RUN_TEST(test_counter_sequence_gaps);
+#endif
+#endif
+    return UNITY_END();
+}
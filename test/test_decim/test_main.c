@@ -0,0 +1,231 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Host CIC decimators and the output rate planner.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+/* The planner expectations below are for parts with arbitrary on-chip decimation from MAX_DATA_RATE = 2000 */
+#if ENABLE_DECIMATION & SUPPORTS_ARBITRARY_DEC_RATE
+
+/* Largest factor whose CIC gain, factor ^ DECIM_CIC_ORDER, stays within 2^32 */
+#define TEST_MAX_FACTOR                 1625
+
+static adi_imu_Device test_Imu;
+
+/**
+ * @brief Feeds a constant sample to a decimator until it has produced numOutputs outputs.
+ **/
+static void test_FeedConstant(adi_imu_Decimator *dec, int32_t val, uint16_t numOutputs, adi_imu_UnscaledData *out)
+{
+    adi_imu_UnscaledData raw = { 0 };
+    uint16_t count = 0;
+    uint32_t inputs = 0;
+
+    raw.xg = val;
+    raw.yg = ~val;
+    raw.zg = val / 2;
+    raw.xa = val;
+    raw.ya = val / 3;
+    raw.za = -(val / 5);
+    raw.temperature = val / 7;
+    while (count < numOutputs)
+    {
+        if (adi_imu_Decimate(dec, &raw, out))
+        {
+            count++;
+        }
+        inputs++;
+    }
+    TEST_ASSERT_EQUAL_UINT32((uint32_t) numOutputs * dec->factor, inputs);
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+}
+
+void tearDown(void)
+{
+}
+
+/* Once the filter has filled, a constant input comes out unchanged: the gain is divided out exactly, including
+   at the ends of the 32-bit range and for the largest allowed factor */
+void test_decim_dc_gain_exact(void)
+{
+    const uint16_t factors[] = { 1, 2, 10, 64, TEST_MAX_FACTOR };
+    const int32_t values[] = { 0, 1, -1, 12345, -987654, INT32_MAX, INT32_MIN };
+    adi_imu_Decimator dec;
+    adi_imu_UnscaledData out;
+
+    for (uint8_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++)
+    {
+        for (uint8_t v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+        {
+            int32_t val = values[v];
+
+            TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DecimatorInit(&dec, factors[f]));
+            /* The first DECIM_CIC_ORDER outputs still see the zeros the filter started from */
+            test_FeedConstant(&dec, val, DECIM_CIC_ORDER + 2, &out);
+            TEST_ASSERT_EQUAL_INT32(val, out.xg);
+            TEST_ASSERT_EQUAL_INT32(~val, out.yg);
+            TEST_ASSERT_EQUAL_INT32(val / 2, out.zg);
+            TEST_ASSERT_EQUAL_INT32(val, out.xa);
+            TEST_ASSERT_EQUAL_INT32(val / 3, out.ya);
+            TEST_ASSERT_EQUAL_INT32(-(val / 5), out.za);
+            TEST_ASSERT_EQUAL_INT32(val / 7, out.temperature);
+        }
+    }
+}
+
+#if SUPPORTS_BURST_STATUS
+/* The status of every input is OR'd into the next output and cleared after it */
+void test_decim_status_accumulates(void)
+{
+    adi_imu_Decimator dec;
+    adi_imu_UnscaledData raw = { 0 };
+    adi_imu_UnscaledData out;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DecimatorInit(&dec, 4));
+    raw.status = 0x0002;
+    TEST_ASSERT_FALSE(adi_imu_Decimate(&dec, &raw, &out));
+    raw.status = 0x0000;
+    TEST_ASSERT_FALSE(adi_imu_Decimate(&dec, &raw, &out));
+    raw.status = 0x0080;
+    TEST_ASSERT_FALSE(adi_imu_Decimate(&dec, &raw, &out));
+    raw.status = 0x0000;
+    TEST_ASSERT_TRUE(adi_imu_Decimate(&dec, &raw, &out));
+    TEST_ASSERT_EQUAL_HEX16(0x0082, out.status);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_FALSE(adi_imu_Decimate(&dec, &raw, &out));
+    }
+    TEST_ASSERT_TRUE(adi_imu_Decimate(&dec, &raw, &out));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, out.status);
+}
+#endif
+
+/* The IMU takes the largest factor common to every output and the host decimators make up the rest */
+void test_decim_plan_factor_selection(void)
+{
+    const uint16_t common[] = { 100, 50 };
+    const uint16_t coprime[] = { 400, 250 };
+    const uint16_t native[] = { 1 };
+    const uint16_t several[] = { 500, 250, 100, 20 };
+    adi_imu_DecimationPlan plan;
+
+    /* Ratios 20 and 40 */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_PlanDecimation(common, 2, &plan));
+    TEST_ASSERT_EQUAL_UINT16(20, plan.deviceFactor);
+    TEST_ASSERT_EQUAL_HEX16(19, plan.decimate);
+    TEST_ASSERT_EQUAL_UINT8(2, plan.numOutputs);
+    TEST_ASSERT_EQUAL_UINT16(1, plan.hostFactor[0]);
+    TEST_ASSERT_EQUAL_UINT16(2, plan.hostFactor[1]);
+#if SUPPORTS_BARTLETT_FILTER
+    /* Sized for the faster output, first null at 2000 / 2^4 = 125 Hz */
+    TEST_ASSERT_EQUAL_HEX16(4, plan.filter);
+#endif
+
+    /* Ratios 5 and 8 share no factor, so the IMU runs at full rate */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_PlanDecimation(coprime, 2, &plan));
+    TEST_ASSERT_EQUAL_UINT16(1, plan.deviceFactor);
+    TEST_ASSERT_EQUAL_HEX16(0, plan.decimate);
+    TEST_ASSERT_EQUAL_UINT16(5, plan.hostFactor[0]);
+    TEST_ASSERT_EQUAL_UINT16(8, plan.hostFactor[1]);
+
+    /* A single rate within reach of the IMU needs no host stage */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_PlanDecimation(native, 1, &plan));
+    TEST_ASSERT_EQUAL_UINT16(MAX_DATA_RATE, plan.deviceFactor);
+    TEST_ASSERT_EQUAL_HEX16(MAX_DATA_RATE - 1, plan.decimate);
+    TEST_ASSERT_EQUAL_UINT16(1, plan.hostFactor[0]);
+#if SUPPORTS_BARTLETT_FILTER
+    TEST_ASSERT_EQUAL_HEX16(FILTER_SIZE_MAX, plan.filter);
+#endif
+
+    /* Ratios 4, 8, 20 and 100, in request order */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_PlanDecimation(several, 4, &plan));
+    TEST_ASSERT_EQUAL_UINT16(4, plan.deviceFactor);
+    TEST_ASSERT_EQUAL_UINT16(1, plan.hostFactor[0]);
+    TEST_ASSERT_EQUAL_UINT16(2, plan.hostFactor[1]);
+    TEST_ASSERT_EQUAL_UINT16(5, plan.hostFactor[2]);
+    TEST_ASSERT_EQUAL_UINT16(25, plan.hostFactor[3]);
+}
+
+/* Rates the part cannot produce, too many outputs and host factors whose gain would overflow are rejected */
+void test_decim_plan_rejects_unsupported(void)
+{
+    const uint16_t zero[] = { 0 };
+    const uint16_t tooFast[] = { MAX_DATA_RATE * 2 };
+    const uint16_t notDivisor[] = { 300 };
+    const uint16_t mixed[] = { 100, 300 };
+    const uint16_t tooMany[DECIM_MAX_OUTPUTS + 1] = { 100, 100, 100, 100, 100 };
+    const uint16_t gainOverflow[] = { MAX_DATA_RATE, 1 };
+    adi_imu_DecimationPlan plan;
+    adi_imu_Decimator dec;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(zero, 1, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(tooFast, 1, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(notDivisor, 1, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(mixed, 2, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(tooMany, 0, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(tooMany, DECIM_MAX_OUTPUTS + 1, &plan));
+    /* Full rate forces an on-chip factor of 1, leaving a host factor of 2000 for the 1 Hz output */
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_PlanDecimation(gainOverflow, 2, &plan));
+
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_DecimatorInit(&dec, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DecimatorInit(&dec, TEST_MAX_FACTOR));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_DecimatorInit(&dec, TEST_MAX_FACTOR + 1));
+}
+
+/* Applying a plan programs the IMU and resets one decimator per output */
+void test_decim_apply_plan(void)
+{
+    const uint16_t rates[] = { 100, 50 };
+    adi_imu_DecimationPlan plan;
+    adi_imu_Decimator decimators[2];
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_PlanDecimation(rates, 2, &plan));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ApplyDecimationPlan(&test_Imu, &plan, decimators));
+    TEST_ASSERT_EQUAL_HEX16(plan.decimate, imu_sim_PeekReg(0, DECIMATE_REG));
+#if SUPPORTS_BARTLETT_FILTER
+    TEST_ASSERT_EQUAL_HEX16(plan.filter, imu_sim_PeekReg(0, FILTER_REG));
+#endif
+    TEST_ASSERT_EQUAL_UINT16(1, decimators[0].factor);
+    TEST_ASSERT_EQUAL_UINT16(2, decimators[1].factor);
+    TEST_ASSERT_EQUAL_UINT16(0, decimators[1].phase);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_DECIMATION & SUPPORTS_ARBITRARY_DEC_RATE
+    RUN_TEST(test_decim_dc_gain_exact);
+#if SUPPORTS_BURST_STATUS
+    RUN_TEST(test_decim_status_accumulates);
+#endif
+    RUN_TEST(test_decim_plan_factor_selection);
+    RUN_TEST(test_decim_plan_rejects_unsupported);
+    RUN_TEST(test_decim_apply_plan);
+#endif
+    return UNITY_END();
+}
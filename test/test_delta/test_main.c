@@ -0,0 +1,174 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Delta window integration against the closed-form constant-rate and coning results.
+ **/
+
+#include <unity.h>
+#include <math.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_DELTA_INTEGRATION
+
+#define TEST_PI                         3.14159265358979323846
+#define TEST_DEG_TO_RAD                 (TEST_PI / 180.0)
+
+static adi_imu_Device test_Imu;
+
+/* Size of one delta output LSB after scaling, in degrees and m/s */
+static double test_AngleLsb;
+static double test_VelocityLsb;
+
+/**
+ * @brief Builds a raw delta sample from angles in degrees and velocities in m/s, rounded to the nearest LSB.
+ **/
+static void test_Sample(adi_imu_UnscaledData *raw, const double *dAngle, const double *dVelocity)
+{
+    adi_imu_UnscaledData cleared = { 0 };
+
+    *raw = cleared;
+    raw->xg = (int32_t) lround(dAngle[0] / test_AngleLsb);
+    raw->yg = (int32_t) lround(dAngle[1] / test_AngleLsb);
+    raw->zg = (int32_t) lround(dAngle[2] / test_AngleLsb);
+    raw->xa = (int32_t) lround(dVelocity[0] / test_VelocityLsb);
+    raw->ya = (int32_t) lround(dVelocity[1] / test_VelocityLsb);
+    raw->za = (int32_t) lround(dVelocity[2] / test_VelocityLsb);
+}
+
+void setUp(void)
+{
+    adi_imu_UnscaledData raw = { 0 };
+    adi_imu_ScaledData scaled;
+
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+
+    raw.xg = 1;
+    raw.xa = 1;
+    adi_imu_ScaleSensorData(&test_Imu, &raw, &scaled);
+    test_AngleLsb = scaled.xg;
+    test_VelocityLsb = scaled.xa;
+}
+
+void tearDown(void)
+{
+}
+
+/* A constant rate needs no coning correction, and a constant specific force in a rotating frame picks up
+   exactly the rotation correction: N dv + N^2 / 2 (dtheta x dv) */
+void test_delta_constant_rate(void)
+{
+    const uint16_t window = 20;
+    const double dAngle[3] = { 0.05, -0.02, 0.03 };
+    const double dVelocity[3] = { 0.01, 0.004, -0.0098 };
+    adi_imu_DeltaIntegrator integ;
+    adi_imu_DeltaSummary summary;
+    adi_imu_UnscaledData raw;
+    adi_imu_ScaledData scaled;
+    double theta[3];
+    double v[3];
+    double expected[3];
+
+    test_Sample(&raw, dAngle, dVelocity);
+    adi_imu_ScaleSensorData(&test_Imu, &raw, &scaled);
+    theta[0] = scaled.xg * TEST_DEG_TO_RAD;
+    theta[1] = scaled.yg * TEST_DEG_TO_RAD;
+    theta[2] = scaled.zg * TEST_DEG_TO_RAD;
+    v[0] = scaled.xa;
+    v[1] = scaled.ya;
+    v[2] = scaled.za;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DeltaInit(&integ, window));
+    for (uint16_t i = 0; i < window - 1; i++)
+    {
+        TEST_ASSERT_FALSE(adi_imu_DeltaAdd(&test_Imu, &integ, &raw, &summary));
+    }
+    TEST_ASSERT_TRUE(adi_imu_DeltaAdd(&test_Imu, &integ, &raw, &summary));
+    TEST_ASSERT_EQUAL_UINT16(window, summary.samples);
+
+    expected[0] = window * v[0] + 0.5 * window * window * (theta[1] * v[2] - theta[2] * v[1]);
+    expected[1] = window * v[1] + 0.5 * window * window * (theta[2] * v[0] - theta[0] * v[2]);
+    expected[2] = window * v[2] + 0.5 * window * window * (theta[0] * v[1] - theta[1] * v[0]);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-5 * window * fabs(dAngle[i]), window * theta[i] / TEST_DEG_TO_RAD, summary.dAngle[i]);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-5, expected[i], summary.dVelocity[i]);
+    }
+
+    /* The integrator starts over for the next window */
+    TEST_ASSERT_EQUAL_UINT16(0, integ.samples);
+}
+
+/* Coning motion over one full cycle of N samples: the delta angles sweep a circle in the xy plane, so the plain
+   sums cancel and only the coning term remains, a^2 N / 4 cot(pi / N) about z */
+void test_delta_coning(void)
+{
+    const uint16_t window = 16;
+    const double amplitude = 20.0;
+    const double zero[3] = { 0.0, 0.0, 0.0 };
+    adi_imu_DeltaIntegrator integ;
+    adi_imu_DeltaSummary summary;
+    adi_imu_UnscaledData raw;
+    double dAngle[3];
+    double a = amplitude * TEST_DEG_TO_RAD;
+    double expected = a * a * window / 4.0 / tan(TEST_PI / window) / TEST_DEG_TO_RAD;
+    /* Rounding every input to an LSB moves the sums by up to half an LSB per sample, and each cross product
+       term by up to the accumulated rotation times that */
+    double tolerance = window * test_AngleLsb * (1.0 + window * a) + 1e-5 * expected;
+    uint16_t completed = 0;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DeltaInit(&integ, window));
+    for (uint16_t k = 0; k < window; k++)
+    {
+        dAngle[0] = amplitude * cos(2.0 * TEST_PI * k / window);
+        dAngle[1] = amplitude * sin(2.0 * TEST_PI * k / window);
+        dAngle[2] = 0.0;
+        test_Sample(&raw, dAngle, zero);
+        if (adi_imu_DeltaAdd(&test_Imu, &integ, &raw, &summary))
+        {
+            completed++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT16(1, completed);
+
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, 0.0, summary.dAngle[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, 0.0, summary.dAngle[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, expected, summary.dAngle[2]);
+    /* The correction is what tells coning apart from no rotation at all */
+    TEST_ASSERT_TRUE(expected > 10.0 * tolerance);
+}
+
+/* An empty window is rejected */
+void test_delta_empty_window(void)
+{
+    adi_imu_DeltaIntegrator integ;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_DATA_RATE, adi_imu_DeltaInit(&integ, 0));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_DELTA_INTEGRATION
+    RUN_TEST(test_delta_constant_rate);
+    RUN_TEST(test_delta_coning);
+    RUN_TEST(test_delta_empty_window);
+#endif
+    return UNITY_END();
+}
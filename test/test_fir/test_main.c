@@ -0,0 +1,188 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		FIR coefficient bank uploads, the bank shadow cache and flash commits.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if SUPPORTS_FIR_BANKS & ENABLE_FIR_BANK_CACHE
+
+static adi_imu_Device test_Imu;
+static imu_sim_Stats test_SimStats;
+
+/**
+ * @brief Fills a bank with a coefficient set, different for every seed.
+ **/
+static void test_Coeffs(int16_t *coeffs, uint16_t seed)
+{
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+        coeffs[tap] = (int16_t) ((seed * 4099u) ^ (tap * 1021u) ^ 0x8001u);
+    }
+}
+
+/**
+ * @brief Returns the number of CS assertions the IMU has seen since imu_sim_ClearStats().
+ **/
+static uint32_t test_CsAssertions(void)
+{
+    imu_sim_GetStats(0, &test_SimStats);
+    return test_SimStats.csAssertions;
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    imu_sim_ClearStats();
+}
+
+void tearDown(void)
+{
+}
+
+/* A bank unknown to the cache is written in full and reads back unchanged */
+void test_fir_write_read_round_trip(void)
+{
+    int16_t coeffs[FIR_BANK_TAPS];
+    int16_t readBack[FIR_BANK_TAPS];
+
+    test_Coeffs(coeffs, 2);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 2, coeffs));
+    /* One page write and two byte writes per tap */
+    TEST_ASSERT_EQUAL_UINT32(1 + 2 * FIR_BANK_TAPS, test_CsAssertions());
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+        TEST_ASSERT_EQUAL_HEX16((uint16_t) coeffs[tap], imu_sim_PeekReg(0, FIR_COEF_REG(2, tap)));
+    }
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadFirBank(&test_Imu, 2, readBack));
+    TEST_ASSERT_EQUAL_INT16_ARRAY(coeffs, readBack, FIR_BANK_TAPS);
+    /* The other banks are untouched */
+    TEST_ASSERT_EQUAL_HEX16(0, imu_sim_PeekReg(0, FIR_COEF_REG(1, 0)));
+    TEST_ASSERT_EQUAL_HEX16(0, imu_sim_PeekReg(0, FIR_COEF_REG(3, 0)));
+}
+
+/* Once the bank is cached, only the taps which changed go out, and an unchanged bank costs no SPI traffic */
+void test_fir_write_changed_taps_only(void)
+{
+    int16_t coeffs[FIR_BANK_TAPS];
+    uint16_t trace[16];
+    uint16_t expected[4];
+
+    test_Coeffs(coeffs, 5);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 5, coeffs));
+
+    coeffs[3] = 0x1234;
+    coeffs[FIR_BANK_TAPS - 1] = -2;
+    expected[0] = (uint16_t) (((0x80 | (FIR_COEF_REG(5, 3) & 0xFF)) << 8) | 0x34);
+    expected[1] = (uint16_t) (((0x80 | ((FIR_COEF_REG(5, 3) & 0xFF) + 1)) << 8) | 0x12);
+    expected[2] = (uint16_t) (((0x80 | (FIR_COEF_REG(5, FIR_BANK_TAPS - 1) & 0xFF)) << 8) | 0xFE);
+    expected[3] = (uint16_t) (((0x80 | ((FIR_COEF_REG(5, FIR_BANK_TAPS - 1) & 0xFF) + 1)) << 8) | 0xFF);
+
+    /* Bank F is still the active page, so not even a page write is needed */
+    imu_sim_StartTrace(0, trace, 16);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 5, coeffs));
+    TEST_ASSERT_EQUAL_UINT16(4, imu_sim_StopTrace(0));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, trace, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, imu_sim_PeekReg(0, FIR_COEF_REG(5, 3)));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFE, imu_sim_PeekReg(0, FIR_COEF_REG(5, FIR_BANK_TAPS - 1)));
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 5, coeffs));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+}
+
+/* A bank read back from the IMU is cached as well, so rewriting it is free */
+void test_fir_read_fills_cache(void)
+{
+    int16_t coeffs[FIR_BANK_TAPS];
+
+    for (uint8_t tap = 0; tap < FIR_BANK_TAPS; tap++)
+    {
+        imu_sim_PokeReg(0, FIR_COEF_REG(0, tap), (uint16_t) (0x0100 + tap));
+    }
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadFirBank(&test_Imu, 0, coeffs));
+    TEST_ASSERT_EQUAL_INT16(0x0100 + 7, coeffs[7]);
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 0, coeffs));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+    /* Nothing was uploaded, so there is nothing to commit either */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CommitFirBanks(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+}
+
+/* A commit issues one flash update after an upload and none when nothing changed. Committed banks survive a
+   reset, uncommitted ones do not and must be written in full again */
+void test_fir_commit_only_when_dirty(void)
+{
+    int16_t coeffs[FIR_BANK_TAPS];
+    int16_t other[FIR_BANK_TAPS];
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CommitFirBanks(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+
+    test_Coeffs(coeffs, 1);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 1, coeffs));
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CommitFirBanks(&test_Imu));
+    TEST_ASSERT_TRUE(test_CsAssertions() > 0);
+    TEST_ASSERT_FALSE(test_Imu.firDirty);
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CommitFirBanks(&test_Imu));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+
+    /* Upload another bank without committing it, then reset */
+    test_Coeffs(other, 3);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 3, other));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SoftwareReset(&test_Imu));
+    TEST_ASSERT_EQUAL_HEX16((uint16_t) coeffs[9], imu_sim_PeekReg(0, FIR_COEF_REG(1, 9)));
+    TEST_ASSERT_EQUAL_HEX16(0, imu_sim_PeekReg(0, FIR_COEF_REG(3, 9)));
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteFirBank(&test_Imu, 3, other));
+    TEST_ASSERT_EQUAL_UINT32(1 + 2 * FIR_BANK_TAPS, test_CsAssertions());
+}
+
+/* Banks beyond FIR_BANK_COUNT are refused without touching the bus */
+void test_fir_invalid_bank(void)
+{
+    int16_t coeffs[FIR_BANK_TAPS] = { 0 };
+
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_FIR_BANK, adi_imu_WriteFirBank(&test_Imu, FIR_BANK_COUNT, coeffs));
+    TEST_ASSERT_EQUAL(ADI_IMU_INVALID_FIR_BANK, adi_imu_ReadFirBank(&test_Imu, FIR_BANK_COUNT, coeffs));
+    TEST_ASSERT_EQUAL_UINT32(0, test_CsAssertions());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if SUPPORTS_FIR_BANKS & ENABLE_FIR_BANK_CACHE
+    RUN_TEST(test_fir_write_read_round_trip);
+    RUN_TEST(test_fir_write_changed_taps_only);
+    RUN_TEST(test_fir_read_fills_cache);
+    RUN_TEST(test_fir_commit_only_when_dirty);
+    RUN_TEST(test_fir_invalid_bank);
+#endif
+    return UNITY_END();
+}
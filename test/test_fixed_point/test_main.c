@@ -0,0 +1,248 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Error bounds of the Q16.16 fixed-point path against the exact and floating-point scaling.
+ **/
+
+#include <unity.h>
+#include <float.h>
+#include <math.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_FIXED_POINT_DATA
+
+/* Largest error of a Q16.16 output against the exact scaled value, in Q16.16 LSBs. Half an LSB comes from
+   rounding the product, at most a quarter from rounding the scale factor over the full input range */
+#define TEST_FIXED_MAX_LSB              0.75
+
+/* Relative error of the floating-point path: the input conversion, the scale factor and the multiply are each
+   rounded to single precision */
+#define TEST_FLOAT_MAX_REL              (3.0 * FLT_EPSILON / 2.0)
+
+#define TEST_Q16_LSB                    (1.0 / 65536.0)
+
+/* Distance between two swept input values. Odd, so every bit pattern of the low word gets exercised */
+#if SENSOR_DATA_32BIT
+    #define TEST_SWEEP_STEP             0x10001LL
+    #define TEST_RAW_MIN                INT32_MIN
+    #define TEST_RAW_MAX                INT32_MAX
+#else
+    #define TEST_SWEEP_STEP             1LL
+    #define TEST_RAW_MIN                INT16_MIN
+    #define TEST_RAW_MAX                INT16_MAX
+#endif
+
+/* RANG_MDL settings of the simulated IMU, one per gyro range. RANG_MDL[3:2] is the adi_imu_RangeReg value */
+static const uint16_t test_RangMdl[] = { 0x0003, 0x0007, 0x000F };
+
+/* The ADIS16470 has no BURST_SEL, so it cannot be initialized for delta bursts */
+#if ENABLE_DELTA_DATA & ENABLE_BURST_MODE
+static const uint16_t test_ProdIds[] = { 16475, 16477 };
+#else
+static const uint16_t test_ProdIds[] = { 16470, 16475, 16477 };
+#endif
+
+static adi_imu_Device test_Imu;
+
+/* Worst errors seen by the last sweep, in Q16.16 LSBs */
+static double test_WorstExact;
+static double test_WorstFloat;
+
+#if ENABLE_SCALED_DATA
+/* Full scale of the delta outputs. The single-precision scale macros round them, so the reference uses these */
+#if ENABLE_DELTA_DATA
+static double test_DeltaAngleRange(adi_imu_RangeReg range)
+{
+    return (range == RANGE_125DPS) ? 360.0 : ((range == RANGE_500DPS) ? 720.0 : 2160.0);
+}
+
+static double test_DeltaVelocityRange(uint16_t prodId)
+{
+    return (prodId == 16475) ? 100.0 : 400.0;
+}
+#endif
+
+/**
+ * @brief Gyro units per LSB of the compiled data mode for a range setting, in double precision.
+ **/
+static double test_GyroUnitsPerLsb(adi_imu_RangeReg range)
+{
+#if ENABLE_DELTA_DATA & SENSOR_DATA_32BIT
+    return test_DeltaAngleRange(range) / 2147483648.0;
+#elif ENABLE_DELTA_DATA
+    return test_DeltaAngleRange(range) / 32768.0;
+#elif SENSOR_DATA_32BIT
+    return 1.0 / (double) GYRO_32BIT_SCALE_FOR_RANGE(range);
+#else
+    return 1.0 / (double) GYRO_16BIT_SCALE_FOR_RANGE(range);
+#endif
+}
+
+/**
+ * @brief Accelerometer units per LSB of the compiled data mode for a product, in double precision.
+ **/
+static double test_AccelUnitsPerLsb(uint16_t prodId)
+{
+#if ENABLE_DELTA_DATA & SENSOR_DATA_32BIT
+    return test_DeltaVelocityRange(prodId) / 2147483648.0;
+#elif ENABLE_DELTA_DATA
+    return test_DeltaVelocityRange(prodId) / 32768.0;
+#elif SENSOR_DATA_32BIT
+    return (double) STANDARD_GRAVITY / (double) ACCEL_32BIT_SCALE_FOR_PROD_ID(prodId);
+#else
+    return (double) STANDARD_GRAVITY / (double) ACCEL_16BIT_SCALE_FOR_PROD_ID(prodId);
+#endif
+}
+
+/**
+ * @brief Checks one Q16.16 output against the exact value and the floating-point output.
+ **/
+static void test_CheckValue(int32_t fixed, float scaled, double exact)
+{
+    double value = (double) fixed * TEST_Q16_LSB;
+    double errExact = fabs(value - exact) / TEST_Q16_LSB;
+    double errFloat = fabs(value - (double) scaled) / TEST_Q16_LSB;
+    double floatBound = TEST_FIXED_MAX_LSB + fabs(exact) * TEST_FLOAT_MAX_REL / TEST_Q16_LSB;
+
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(TEST_FIXED_MAX_LSB, errExact);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(floatBound, errFloat);
+    if (errExact > test_WorstExact)
+    {
+        test_WorstExact = errExact;
+    }
+    if (errFloat > test_WorstFloat)
+    {
+        test_WorstFloat = errFloat;
+    }
+}
+
+/**
+ * @brief Sweeps the raw range of every inertial field for one simulated IMU configuration.
+ **/
+static void test_SweepInertial(uint16_t prodId, uint16_t rangMdl)
+{
+    const imu_sim_Config config = { prodId, rangMdl, 0x0001 };
+    adi_imu_UnscaledData raw = { 0 };
+    adi_imu_FixedData fixed;
+    adi_imu_ScaledData scaled;
+    double gyroUnits;
+    double accelUnits;
+
+    imu_sim_Reset(&config);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    gyroUnits = test_GyroUnitsPerLsb((adi_imu_RangeReg) (rangMdl & 0x000C));
+    accelUnits = test_AccelUnitsPerLsb(prodId);
+
+    for (int64_t v = TEST_RAW_MIN; v <= TEST_RAW_MAX; v += TEST_SWEEP_STEP)
+    {
+        /* Opposite signs on the second axis of each sensor, the extremes on the third */
+        raw.xg = (int32_t) v;
+        raw.yg = (int32_t) (TEST_RAW_MIN + TEST_RAW_MAX - v);
+        raw.zg = (v < 0) ? TEST_RAW_MIN : TEST_RAW_MAX;
+        raw.xa = raw.xg;
+        raw.ya = raw.yg;
+        raw.za = raw.zg;
+
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_FixedScaleSensorData(&test_Imu, &raw, &fixed));
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ScaleSensorData(&test_Imu, &raw, &scaled));
+        test_CheckValue(fixed.xg, scaled.xg, raw.xg * gyroUnits);
+        test_CheckValue(fixed.yg, scaled.yg, raw.yg * gyroUnits);
+        test_CheckValue(fixed.zg, scaled.zg, raw.zg * gyroUnits);
+        test_CheckValue(fixed.xa, scaled.xa, raw.xa * accelUnits);
+        test_CheckValue(fixed.ya, scaled.ya, raw.ya * accelUnits);
+        test_CheckValue(fixed.za, scaled.za, raw.za * accelUnits);
+    }
+}
+#endif
+
+void setUp(void)
+{
+    test_WorstExact = 0.0;
+    test_WorstFloat = 0.0;
+}
+
+void tearDown(void)
+{
+}
+
+#if ENABLE_SCALED_DATA
+/* Gyro and accelerometer outputs, every model and gyro range of the family */
+void test_fixed_inertial_error_bound(void)
+{
+    for (uint8_t p = 0; p < sizeof(test_ProdIds) / sizeof(test_ProdIds[0]); p++)
+    {
+        for (uint8_t r = 0; r < sizeof(test_RangMdl) / sizeof(test_RangMdl[0]); r++)
+        {
+            test_SweepInertial(test_ProdIds[p], test_RangMdl[r]);
+        }
+    }
+}
+
+/* Temperature, the whole 16-bit TEMP_OUT range */
+void test_fixed_temperature_error_bound(void)
+{
+    adi_imu_UnscaledData raw = { 0 };
+    adi_imu_FixedData fixed;
+    adi_imu_ScaledData scaled;
+
+    imu_sim_Reset(0);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    for (int32_t v = INT16_MIN; v <= INT16_MAX; v++)
+    {
+        raw.temperature = v;
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_FixedScaleSensorData(&test_Imu, &raw, &fixed));
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ScaleSensorData(&test_Imu, &raw, &scaled));
+        test_CheckValue(fixed.temperature, scaled.temperature, v / (double) TEMPERATURE_SCALE + (double) TEMPERATURE_OFFSET);
+    }
+}
+#endif
+
+/* Rounding is to nearest, symmetric around zero */
+void test_fixed_rounding_is_symmetric(void)
+{
+    adi_imu_UnscaledData raw = { 0 };
+    adi_imu_FixedData pos;
+    adi_imu_FixedData neg;
+
+    imu_sim_Reset(0);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    for (int32_t v = 1; v < 4096; v += 7)
+    {
+        raw.xg = v;
+        raw.xa = v;
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_FixedScaleSensorData(&test_Imu, &raw, &pos));
+        raw.xg = -v;
+        raw.xa = -v;
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_FixedScaleSensorData(&test_Imu, &raw, &neg));
+        TEST_ASSERT_INT32_WITHIN(1, -pos.xg, neg.xg);
+        TEST_ASSERT_INT32_WITHIN(1, -pos.xa, neg.xa);
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_FIXED_POINT_DATA
+#if ENABLE_SCALED_DATA
+    RUN_TEST(test_fixed_inertial_error_bound);
+    RUN_TEST(test_fixed_temperature_error_bound);
+#endif
+    RUN_TEST(test_fixed_rounding_is_symmetric);
+#endif
+    return UNITY_END();
+}
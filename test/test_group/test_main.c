@@ -0,0 +1,118 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Group bring-up of several IMUs, with and without a faulted device.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#define TEST_NUM_IMUS                   4
+
+/* Index of the faulted device */
+#define TEST_FAULTED                    2
+
+/* Written to every IMU once it is up */
+#define TEST_DECIMATE                   0x0007
+
+static adi_imu_Device test_Imus[TEST_NUM_IMUS];
+static uint8_t test_CsPins[TEST_NUM_IMUS];
+static const adi_imu_RegWrite test_Config[] = { { DECIMATE_REG, TEST_DECIMATE } };
+
+/**
+ * @brief Checks that a device came up as a usable, configured IMU.
+ **/
+static void test_CheckUp(uint8_t i)
+{
+    uint16_t prodId;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, test_Imus[i].status);
+    TEST_ASSERT_EQUAL_UINT16(imu_sim_PeekReg(test_CsPins[i], PRODUCT_ID_REG), test_Imus[i].model->prodId);
+    TEST_ASSERT_EQUAL_HEX16(TEST_DECIMATE, imu_sim_PeekReg(test_CsPins[i], DECIMATE_REG));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadReg(&test_Imus[i], PRODUCT_ID_REG, &prodId));
+    TEST_ASSERT_EQUAL_UINT16(test_Imus[i].model->prodId, prodId);
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    for (uint8_t i = 0; i < TEST_NUM_IMUS; i++)
+    {
+        test_CsPins[i] = i;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/* Every IMU comes up and is configured, and with ready polling the reset is waited for only as long as it takes */
+void test_group_all_up(void)
+{
+    uint64_t startNs = imu_sim_Now();
+
+    imu_sim_SetCommandTime(20);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_InitGroup(test_Imus, test_CsPins, TEST_NUM_IMUS, BOOT_SOFTWARE_RESET, test_Config, 1));
+    for (uint8_t i = 0; i < TEST_NUM_IMUS; i++)
+    {
+        test_CheckUp(i);
+    }
+#if ENABLE_READY_POLL
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs < (uint64_t) RESET_RECOVERY_TIME_MS * 1000000ULL / 2);
+#else
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs >= (uint64_t) RESET_RECOVERY_TIME_MS * 1000000ULL);
+#endif
+}
+
+/* An IMU answering with a product ID outside the family is reported, skipped, and left unconfigured */
+void test_group_wrong_product(void)
+{
+    imu_sim_PokeReg(test_CsPins[TEST_FAULTED], PRODUCT_ID_REG, 0x1234);
+
+    TEST_ASSERT_EQUAL(ADI_IMU_PRODID_VERIFY_FAILED, adi_imu_InitGroup(test_Imus, test_CsPins, TEST_NUM_IMUS, BOOT_POWER_ON, test_Config, 1));
+    for (uint8_t i = 0; i < TEST_NUM_IMUS; i++)
+    {
+        if (i != TEST_FAULTED)
+        {
+            test_CheckUp(i);
+        }
+    }
+    TEST_ASSERT_EQUAL(ADI_IMU_PRODID_VERIFY_FAILED, test_Imus[TEST_FAULTED].status);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, imu_sim_PeekReg(test_CsPins[TEST_FAULTED], DECIMATE_REG));
+}
+
+/* A chip select with no IMU behind it fails at the transport, and does not hold up the others */
+void test_group_missing_device(void)
+{
+    uint64_t startNs = imu_sim_Now();
+
+    test_CsPins[TEST_FAULTED] = IMU_SIM_MAX_DEVICES;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SPIRW_FAILED, adi_imu_InitGroup(test_Imus, test_CsPins, TEST_NUM_IMUS, BOOT_POWER_ON, test_Config, 1));
+    for (uint8_t i = 0; i < TEST_NUM_IMUS; i++)
+    {
+        if (i != TEST_FAULTED)
+        {
+            test_CheckUp(i);
+        }
+    }
+    TEST_ASSERT_EQUAL(ADI_IMU_SPIRW_FAILED, test_Imus[TEST_FAULTED].status);
+#if ENABLE_READY_POLL
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs < (uint64_t) POWER_ON_TIME_MS * 1000000ULL / 2);
+#else
+    TEST_ASSERT_TRUE(imu_sim_Now() - startNs >= (uint64_t) POWER_ON_TIME_MS * 1000000ULL);
+#endif
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_group_all_up);
+    RUN_TEST(test_group_wrong_product);
+    RUN_TEST(test_group_missing_device);
+    return UNITY_END();
+}
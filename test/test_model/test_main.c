@@ -0,0 +1,166 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Model detection from PROD_ID and the burst decoder of members without a 32-bit burst.
+ **/
+
+#include <string.h>
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+/* PROD_ID of every member, in MODEL_TABLE order */
+#define TEST_PROD_ID(id, has32BitBurst, burstSel)   id,
+static const uint16_t test_ProdIds[] = { MODEL_TABLE(TEST_PROD_ID) };
+#undef TEST_PROD_ID
+
+#define TEST_NUM_MODELS                 (sizeof(test_ProdIds) / sizeof(test_ProdIds[0]))
+
+/* Answered by no member of any family */
+#define TEST_UNKNOWN_PROD_ID            0x1234
+
+static adi_imu_Device test_Imu;
+
+/**
+ * @brief Makes the simulated IMU answer a PROD_ID. adi_imu_Init() left the immutable PROD_ID in the register
+ * cache, so the whole cache is dropped.
+ **/
+static void test_Answer(uint16_t prodId)
+{
+    imu_sim_PokeReg(0, PRODUCT_ID_REG, prodId);
+#if ENABLE_REG_CACHE
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_CacheReset(&test_Imu));
+#endif
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+}
+
+void tearDown(void)
+{
+}
+
+/* Every member of the table is detected from its PROD_ID and selects its own description */
+void test_model_detect_every_member(void)
+{
+    for (uint8_t i = 0; i < TEST_NUM_MODELS; i++)
+    {
+        const adi_imu_Model *model = adi_imu_FindModel(test_ProdIds[i]);
+
+        TEST_ASSERT_NOT_NULL(model);
+        TEST_ASSERT_EQUAL_UINT16(test_ProdIds[i], model->prodId);
+        test_Answer(test_ProdIds[i]);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_DetectModel(&test_Imu));
+        TEST_ASSERT_EQUAL_PTR(model, test_Imu.model);
+    }
+    /* The default description is the first entry */
+    TEST_ASSERT_EQUAL_PTR(adi_imu_FindModel(test_ProdIds[0]), adi_imu_FindModel(ADI_IMU_MODEL_DEFAULT));
+}
+
+/* A part outside the family, including one answering ADI_IMU_MODEL_DEFAULT, is refused and the previous
+   description is kept */
+void test_model_detect_unknown(void)
+{
+    const adi_imu_Model *previous = test_Imu.model;
+
+    TEST_ASSERT_NULL(adi_imu_FindModel(TEST_UNKNOWN_PROD_ID));
+    test_Answer(TEST_UNKNOWN_PROD_ID);
+    TEST_ASSERT_EQUAL(ADI_IMU_PRODID_VERIFY_FAILED, adi_imu_DetectModel(&test_Imu));
+    TEST_ASSERT_EQUAL(ADI_IMU_PRODID_VERIFY_FAILED, test_Imu.status);
+    TEST_ASSERT_EQUAL_PTR(previous, test_Imu.model);
+
+    test_Answer(ADI_IMU_MODEL_DEFAULT);
+    TEST_ASSERT_EQUAL(ADI_IMU_PRODID_VERIFY_FAILED, adi_imu_DetectModel(&test_Imu));
+    TEST_ASSERT_EQUAL_PTR(previous, test_Imu.model);
+}
+
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT
+#ifdef BURST_LAYOUT_NARROW
+
+/**
+ * @brief Stores a big-endian word at a payload byte index of a burst frame and returns its byte sum.
+ **/
+static uint16_t test_PutWord(uint8_t *frame, uint16_t index, uint16_t val)
+{
+    frame[index + BURST_PAYLOAD_OFFSET] = (uint8_t) (val >> 8);
+    frame[index + BURST_PAYLOAD_OFFSET + 1] = (uint8_t) val;
+    return (uint16_t) ((val >> 8) + (val & 0xFF));
+}
+
+/**
+ * @brief Builds a 16-bit burst frame of the ADIS16470, with a valid checksum.
+ **/
+static void test_NarrowFrame(uint8_t *frame)
+{
+    uint16_t checksum = 0;
+
+    memset(frame, 0xA5, BURST_PAYLOAD_OFFSET + BURST_NARROW_BYTE_LENGTH);
+    checksum += test_PutWord(frame, 0, 0x0004);
+    checksum += test_PutWord(frame, 2, 0x1234);
+    checksum += test_PutWord(frame, 4, 0xFFFE);
+    checksum += test_PutWord(frame, 6, 0x8000);
+    checksum += test_PutWord(frame, 8, 0x7FFF);
+    checksum += test_PutWord(frame, 10, 0x0001);
+    checksum += test_PutWord(frame, 12, 0xC350);
+    checksum += test_PutWord(frame, 14, 0xFF38);
+    checksum += test_PutWord(frame, 16, 0xBEEF);
+    test_PutWord(frame, BURST_NARROW_CHECKSUM_INDEX, checksum);
+}
+
+/* The ADIS16470 keeps its 16-bit burst in a 32-bit build, and the narrow decoder widens the inertial fields to
+   32-bit LSBs while leaving the temperature and counter as they are */
+void test_model_decode_narrow_burst(void)
+{
+    const adi_imu_Model *model = adi_imu_FindModel(16470);
+    uint8_t frame[BURST_PAYLOAD_OFFSET + BURST_NARROW_BYTE_LENGTH];
+    adi_imu_UnscaledData data;
+
+    TEST_ASSERT_NOT_NULL(model);
+    TEST_ASSERT_EQUAL_UINT16(BURST_NARROW_BYTE_LENGTH + 2, model->burstXferLength);
+    TEST_ASSERT_EQUAL_HEX16(0, model->burstCtrl);
+    TEST_ASSERT_TRUE(model->decodeBurst != adi_imu_FindModel(16475)->decodeBurst);
+
+    test_NarrowFrame(frame);
+    memset(&data, 0, sizeof(data));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, model->decodeBurst(frame, &data));
+    TEST_ASSERT_EQUAL_HEX32(0x0004, data.status);
+    TEST_ASSERT_EQUAL_INT32(0x12340000, data.xg);
+    TEST_ASSERT_EQUAL_INT32(-2 * 65536, data.yg);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, data.zg);
+    TEST_ASSERT_EQUAL_INT32(0x7FFF0000, data.xa);
+    TEST_ASSERT_EQUAL_INT32(65536, data.ya);
+    TEST_ASSERT_EQUAL_INT32((int32_t) (int16_t) 0xC350 * 65536, data.za);
+    TEST_ASSERT_EQUAL_INT32(-200, data.temperature);
+    TEST_ASSERT_EQUAL_HEX32(0xBEEF, data.count);
+#if SUPPORTS_BURST_CHECKSUM_CRC
+    TEST_ASSERT_EQUAL_HEX32(IMU_GET_16BITS(frame, BURST_NARROW_CHECKSUM_INDEX + BURST_PAYLOAD_OFFSET), data.chksm_crc);
+#endif
+
+#if VERIFY_BURST_CHECKSUM
+    /* A flipped payload bit fails the checksum */
+    frame[BURST_PAYLOAD_OFFSET + 7] ^= 0x10;
+    TEST_ASSERT_EQUAL(ADI_IMU_BURST_CHECKSUM_FAILED, model->decodeBurst(frame, &data));
+#endif
+}
+
+#endif
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_model_detect_every_member);
+    RUN_TEST(test_model_detect_unknown);
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT
+#ifdef BURST_LAYOUT_NARROW
+    RUN_TEST(test_model_decode_narrow_burst);
+#endif
+#endif
+    return UNITY_END();
+}
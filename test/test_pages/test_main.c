@@ -0,0 +1,183 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Page selection of paged IMUs: register array reads and batched writes across pages.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if SUPPORTS_PAGES & SUPPORTS_FIR_BANKS
+
+/* Registers in the mixed-page read list, more than one SPI_BUFF_SIZE transaction holds */
+#define TEST_NUM_REGS                   40
+
+static adi_imu_Device test_Imu;
+static imu_sim_Stats test_SimStats;
+
+/**
+ * @brief Value poked into a register, unique across pages.
+ **/
+static uint16_t test_Value(uint16_t pageIDRegAddr)
+{
+    return (uint16_t) (0x5A00 ^ (pageIDRegAddr * 7));
+}
+
+/**
+ * @brief Builds a read list cycling through page 0 and two FIR bank pages, and pokes the value of every listed
+ * register into the simulator.
+ **/
+static void test_MixedList(uint16_t *regList)
+{
+    for (uint16_t i = 0; i < TEST_NUM_REGS; i++)
+    {
+        switch (i % 3)
+        {
+        case 0:
+            /* X_ANULL to GLOB_CMD, which hold their value between samples */
+            regList[i] = REG_X_ANULL + 2 * ((i / 3) % 21);
+            break;
+        case 1:
+            regList[i] = FIR_COEF_REG(1, i % FIR_BANK_TAPS);
+            break;
+        default:
+            regList[i] = FIR_COEF_REG(4, (i * 5) % FIR_BANK_TAPS);
+            break;
+        }
+        imu_sim_PokeReg(0, regList[i], test_Value(regList[i]));
+    }
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    TEST_ASSERT_EQUAL_UINT16(0, test_Imu.activePage);
+}
+
+void tearDown(void)
+{
+}
+
+/* A list spanning three pages and several transactions comes back in list order, every capture selects each
+   page at most once, and the pipeline adds a single dummy frame at the very end */
+void test_pages_read_array_across_pages(void)
+{
+    const uint16_t timesToRead = 3;
+    uint16_t regList[TEST_NUM_REGS];
+    uint16_t out[TEST_NUM_REGS * 3];
+
+    test_MixedList(regList);
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadRegArray(&test_Imu, regList, out, TEST_NUM_REGS, timesToRead));
+
+    for (uint16_t n = 0; n < timesToRead; n++)
+    {
+        for (uint16_t i = 0; i < TEST_NUM_REGS; i++)
+        {
+            TEST_ASSERT_EQUAL_HEX16(test_Value(regList[i]), out[n * TEST_NUM_REGS + i]);
+        }
+    }
+
+    /* The first capture starts on page 0 and selects pages 2 and 5, every later one starts on the page the
+       previous capture ended on and selects the other two */
+    imu_sim_GetStats(0, &test_SimStats);
+    TEST_ASSERT_EQUAL_UINT32(2 * timesToRead, test_SimStats.pageWrites);
+    TEST_ASSERT_EQUAL_UINT32(TEST_NUM_REGS * timesToRead + 2 * timesToRead + 1, test_SimStats.csAssertions);
+    TEST_ASSERT_TRUE(test_SimStats.transfers > 1);
+    TEST_ASSERT_EQUAL_UINT16(imu_sim_PeekReg(0, PAGE_ID_REG), test_Imu.activePage);
+}
+
+/* With the IMU page unknown, a single-page list selects its page once, in the first capture only */
+void test_pages_read_array_unknown_page(void)
+{
+    uint16_t regList[TEST_NUM_REGS];
+    uint16_t out[TEST_NUM_REGS * 2];
+
+    for (uint16_t i = 0; i < TEST_NUM_REGS; i++)
+    {
+        regList[i] = FIR_COEF_REG(2, (TEST_NUM_REGS - 1 - i) % FIR_BANK_TAPS);
+        imu_sim_PokeReg(0, regList[i], test_Value(regList[i]));
+    }
+    /* Left on another page by a previous session */
+    imu_sim_PokeReg(0, PAGE_ID_REG, 5);
+    test_Imu.activePage = ADI_IMU_PAGE_UNKNOWN;
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_ReadRegArray(&test_Imu, regList, out, TEST_NUM_REGS, 2));
+    for (uint16_t i = 0; i < 2 * TEST_NUM_REGS; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX16(test_Value(regList[i % TEST_NUM_REGS]), out[i]);
+    }
+    imu_sim_GetStats(0, &test_SimStats);
+    TEST_ASSERT_EQUAL_UINT32(1, test_SimStats.pageWrites);
+    TEST_ASSERT_EQUAL_UINT16(FIR_BANK_PAGE(2), imu_sim_PeekReg(0, PAGE_ID_REG));
+    TEST_ASSERT_EQUAL_UINT16(FIR_BANK_PAGE(2), test_Imu.activePage);
+}
+
+/* A mixed-page batch inserts a PAGE_ID write only where the page changes, including after an explicit PAGE_ID
+   write in the list, and sends everything in one transaction */
+void test_pages_write_batch_sequence(void)
+{
+    const adi_imu_RegWrite writes[] = {
+        { FIR_COEF_REG(0, 0), 0x1234 },
+        { FIR_COEF_REG(0, 1), 0xABCD },
+        { REG_USER_SCRATCH, 0x5678 },
+        { PAGE_ID_REG, 3 },
+        { FIR_COEF_REG(2, 5), 0x0F0F },
+        { FIR_COEF_REG(5, FIR_BANK_TAPS - 1), 0xFFFF },
+    };
+    const uint16_t expected[] = {
+        0x8001, 0x8234, 0x8312, 0x84CD, 0x85AB,
+        0x8000, 0xDA78, 0xDB56,
+        0x8003, 0x8100, 0x8C0F, 0x8D0F,
+        0x8006, 0xC0FF, 0xC1FF,
+    };
+    const uint16_t numWrites = sizeof(writes) / sizeof(writes[0]);
+    const uint16_t numWords = sizeof(expected) / sizeof(expected[0]);
+    uint16_t trace[32];
+
+    imu_sim_ClearStats();
+    imu_sim_StartTrace(0, trace, 32);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteRegBatch(&test_Imu, writes, numWrites));
+    TEST_ASSERT_EQUAL_UINT16(numWords, imu_sim_StopTrace(0));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, trace, numWords);
+
+    imu_sim_GetStats(0, &test_SimStats);
+    TEST_ASSERT_EQUAL_UINT32(1, test_SimStats.transfers);
+    TEST_ASSERT_EQUAL_UINT16(FIR_BANK_PAGE(5), test_Imu.activePage);
+    for (uint16_t i = 0; i < numWrites; i++)
+    {
+        if (writes[i].pageIDRegAddr != PAGE_ID_REG)
+        {
+            TEST_ASSERT_EQUAL_HEX16(writes[i].val, imu_sim_PeekReg(0, writes[i].pageIDRegAddr));
+        }
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if SUPPORTS_PAGES & SUPPORTS_FIR_BANKS
+    RUN_TEST(test_pages_read_array_across_pages);
+    RUN_TEST(test_pages_read_array_unknown_page);
+    RUN_TEST(test_pages_write_batch_sequence);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,144 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Register-read data path: every field of the family REGREAD_LAYOUT table against the IMU registers.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if !ENABLE_BURST_MODE & SUPPORTS_INERTIAL_DATA
+
+/* Constant outputs with distinct low and high words, both signs and the extremes of the 16-bit words */
+static const imu_sim_Sample test_Sample = {
+    .gyro = { 0x12345678, -0x0123ABCD, 0x7FFF0001 },
+    .accel = { -0x7FFFFFFF - 1, 0x00018000, -0x00000002 },
+    .deltaAngle = { 0x0ABC7FFF, -0x10000000, 0x00008001 },
+    .deltaVelocity = { -0x5A5A5A5A, 0x7FFFFFFF, 0x0000FFFF },
+    .temperature = -321,
+};
+
+/* Written to the registers which are not sample outputs */
+#define TEST_DIAG_STAT                  0x0042
+#define TEST_DATA_CNTR                  0xBEEF
+
+static adi_imu_Device test_Imu;
+
+/**
+ * @brief Sample source feeding the same sample at every data ready.
+ **/
+static void test_Source(uint8_t csPin, uint32_t index, imu_sim_Sample *sample, void *context)
+{
+    (void) csPin;
+    (void) index;
+    (void) context;
+    *sample = test_Sample;
+}
+
+/**
+ * @brief Expected value of one inertial field, the full output or its *_OUT word.
+ **/
+static int32_t test_Expected(int32_t output)
+{
+#if SENSOR_DATA_32BIT
+    return output;
+#else
+    return (int32_t) (int16_t) ((uint32_t) output >> 16);
+#endif
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    imu_sim_SetSampleSource(0, test_Source, 0);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    /* Drop to the slowest output rate and let the sample already due land, so no other one lands between the
+       registers of a read */
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_WriteReg(&test_Imu, DECIMATE_REG, DECIMATE_MAX - 1));
+    imu_sim_Advance(2 * (1000000000ULL / IMU_SIM_BASE_RATE));
+    imu_sim_PokeReg(0, DIAG_STAT, TEST_DIAG_STAT);
+    imu_sim_PokeReg(0, DATA_CNTR, TEST_DATA_CNTR);
+}
+
+void tearDown(void)
+{
+    imu_sim_SetSampleSource(0, 0, 0);
+}
+
+/* Every field of the compiled layout is decoded from its own register, with 32-bit outputs assembled from their
+   *_LOW and *_OUT words and the 16-bit ones sign extended from *_OUT */
+void test_regread_every_field(void)
+{
+#if ENABLE_DELTA_DATA
+    const int32_t *angular = test_Sample.deltaAngle;
+    const int32_t *linear = test_Sample.deltaVelocity;
+#else
+    const int32_t *angular = test_Sample.gyro;
+    const int32_t *linear = test_Sample.accel;
+#endif
+    adi_imu_UnscaledData data;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_GetSensorData(&test_Imu, &data));
+    TEST_ASSERT_EQUAL_INT32(test_Expected(angular[0]), data.xg);
+    TEST_ASSERT_EQUAL_INT32(test_Expected(angular[1]), data.yg);
+    TEST_ASSERT_EQUAL_INT32(test_Expected(angular[2]), data.zg);
+    TEST_ASSERT_EQUAL_INT32(test_Expected(linear[0]), data.xa);
+    TEST_ASSERT_EQUAL_INT32(test_Expected(linear[1]), data.ya);
+    TEST_ASSERT_EQUAL_INT32(test_Expected(linear[2]), data.za);
+    TEST_ASSERT_EQUAL_INT32(test_Sample.temperature, data.temperature);
+#if SUPPORTS_BURST_STATUS
+    TEST_ASSERT_EQUAL_HEX32(TEST_DIAG_STAT, data.status);
+#endif
+#if SUPPORTS_BURST_CNT
+    /* Unsigned, and still the value poked in setUp(), so the read did not straddle a sample */
+    TEST_ASSERT_EQUAL_HEX32(TEST_DATA_CNTR, data.count);
+    TEST_ASSERT_EQUAL_HEX16(TEST_DATA_CNTR, imu_sim_PeekReg(0, DATA_CNTR));
+#endif
+}
+
+/* Register words read for each field decoder */
+#define TEST_WORDS_REG_U16              1
+#define TEST_WORDS_REG_S16              1
+#define TEST_WORDS_REG_S32              2
+#define TEST_FIELD_WORDS(field, reg, decode)    + TEST_WORDS_##decode
+
+/* The registers are read in one pipelined transaction, so the only frame beyond one per register word is the
+   final dummy read */
+void test_regread_single_transaction(void)
+{
+    const uint32_t words = 0 REGREAD_LAYOUT(TEST_FIELD_WORDS);
+    imu_sim_Stats stats;
+    adi_imu_UnscaledData data;
+
+    imu_sim_ClearStats();
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_GetSensorData(&test_Imu, &data));
+    imu_sim_GetStats(0, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.transfers);
+    TEST_ASSERT_EQUAL_UINT32(words + 1, stats.csAssertions);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if !ENABLE_BURST_MODE & SUPPORTS_INERTIAL_DATA
+    RUN_TEST(test_regread_every_field);
+    RUN_TEST(test_regread_single_transaction);
+#endif
+    return UNITY_END();
+}
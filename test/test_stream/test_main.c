@@ -0,0 +1,141 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Streaming engine ring buffer: overruns when the consumer falls behind.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_STREAMING
+
+/* Output rate of the IMU, one sample every 5 ms */
+#define TEST_RATE_HZ                    200
+
+/* Samples dropped by the full ring before the consumer catches up */
+#define TEST_DROPPED                    10
+
+/* Virtual time the ring is given to fill, in milliseconds */
+#define TEST_TIMEOUT_MS                 1000
+
+/* Shift of the tag word within a decoded output. 16-bit bursts only carry the upper word of each output */
+#if SENSOR_DATA_32BIT
+    #define TEST_TAG_SHIFT              16
+#else
+    #define TEST_TAG_SHIFT              0
+#endif
+
+static adi_imu_Device test_Imu;
+
+/**
+ * @brief Sample source tagging the upper word of the x gyroscope and delta angle outputs with the sample index.
+ **/
+static void test_Source(uint8_t csPin, uint32_t index, imu_sim_Sample *sample, void *context)
+{
+    (void) csPin;
+    (void) context;
+    sample->gyro[0] = (int32_t) (index & 0x7FFF) << 16;
+    sample->deltaAngle[0] = sample->gyro[0];
+}
+
+/**
+ * @brief Index of the IMU sample a decoded sample was taken from.
+ **/
+static int32_t test_Index(const adi_imu_UnscaledData *sample)
+{
+    return sample->xg >> TEST_TAG_SHIFT;
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    imu_sim_SetSampleSource(0, test_Source, 0);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetDataRate(&test_Imu, TEST_RATE_HZ));
+}
+
+void tearDown(void)
+{
+    adi_imu_StreamStop(&test_Imu);
+    imu_sim_SetSampleSource(0, 0, 0);
+}
+
+/* With nobody draining, the ring keeps the oldest STREAM_RING_SIZE samples and drops every newer one. The drop is
+   counted, reported once by the next adi_imu_StreamRead(), and shows up as a gap once streaming resumes */
+void test_stream_ring_overrun(void)
+{
+    static adi_imu_UnscaledData buf[STREAM_RING_SIZE];
+    adi_imu_StreamStats stats;
+    uint16_t numRead;
+    int32_t first;
+    uint32_t ms;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamStart(&test_Imu, DIO1, RISING_EDGE));
+    /* Less than one sample per step, so the loop stops on the edge which made the count */
+    for (ms = 0; ms < TEST_TIMEOUT_MS; ms++)
+    {
+        delay_MS(1);
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imu, &stats));
+        if (stats.overruns == TEST_DROPPED)
+        {
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE(ms < TEST_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_UINT32(STREAM_RING_SIZE, stats.samples);
+    TEST_ASSERT_EQUAL_UINT16(STREAM_RING_SIZE, adi_imu_StreamAvailable(&test_Imu));
+
+    /* The overrun is reported by the first read only, and both reads return the oldest samples in order */
+    TEST_ASSERT_EQUAL(ADI_IMU_STREAM_OVERRUN, adi_imu_StreamRead(&test_Imu, buf, STREAM_RING_SIZE / 4, &numRead));
+    TEST_ASSERT_EQUAL_UINT16(STREAM_RING_SIZE / 4, numRead);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imu, &buf[numRead], STREAM_RING_SIZE, &numRead));
+    TEST_ASSERT_EQUAL_UINT16(STREAM_RING_SIZE - STREAM_RING_SIZE / 4, numRead);
+    TEST_ASSERT_EQUAL_UINT16(0, adi_imu_StreamAvailable(&test_Imu));
+    first = test_Index(&buf[0]);
+    for (uint16_t i = 0; i < STREAM_RING_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL_INT32(first + i, test_Index(&buf[i]));
+    }
+
+    /* Once there is room again, the next sample follows the dropped ones */
+    for (ms = 0; (ms < TEST_TIMEOUT_MS) && (adi_imu_StreamAvailable(&test_Imu) == 0); ms++)
+    {
+        delay_MS(1);
+    }
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamRead(&test_Imu, buf, STREAM_RING_SIZE, &numRead));
+    TEST_ASSERT_EQUAL_UINT16(1, numRead);
+    TEST_ASSERT_EQUAL_INT32(first + STREAM_RING_SIZE + TEST_DROPPED, test_Index(&buf[0]));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_StreamGetStats(&test_Imu, &stats));
+    TEST_ASSERT_EQUAL_UINT32(TEST_DROPPED, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.spiErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.checksumErrors);
+#if SUPPORTS_BURST_CNT
+    TEST_ASSERT_EQUAL_UINT32(TEST_DROPPED, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_STREAMING
+    RUN_TEST(test_stream_ring_overrun);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+/**
+  * @file	    test_main.c
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		Sample timestamp estimation: offset and drift convergence, counter wrap and outlier edges.
+ **/
+
+#include <unity.h>
+#include "adi_imu.h"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ENABLE_TIMESTAMPS
+
+/* Host time of the first sample, far enough from 0 that early estimates cannot wrap */
+#define TEST_START_NS                   1000000000ULL
+
+static adi_imu_Device test_Imu;
+static adi_imu_TimeSync test_Ts;
+
+/* Nominal sample period after adi_imu_TimeSyncInit() */
+static uint64_t test_PeriodNs;
+
+static uint32_t test_Seed;
+
+/**
+ * @brief Returns a pseudo-random interrupt latency in [0, maxNs], repeatable across runs.
+ **/
+static uint32_t test_Latency(uint32_t maxNs)
+{
+    test_Seed = test_Seed * 1664525UL + 1013904223UL;
+    return (test_Seed >> 8) % (maxNs + 1);
+}
+
+/**
+ * @brief Host time of sample k on an IMU clock running driftPpb fast relative to the host.
+ **/
+static uint64_t test_TrueNs(uint32_t k, int32_t driftPpb)
+{
+    int64_t elapsed = (int64_t) k * (int64_t) test_PeriodNs;
+
+    return TEST_START_NS + (uint64_t) (elapsed - elapsed * driftPpb / 1000000000LL);
+}
+
+/**
+ * @brief Runs numSamples samples through the estimator and returns the largest timestamp error of the last
+ * quarter, in ns.
+ **/
+static int64_t test_Run(uint16_t firstCount, uint32_t numSamples, int32_t driftPpb, uint32_t maxLatencyNs)
+{
+    int64_t worst = 0;
+    int64_t error;
+    uint64_t stamp;
+
+    for (uint32_t k = 0; k < numSamples; k++)
+    {
+        stamp = adi_imu_TimeSyncUpdate(&test_Ts, (uint16_t) (firstCount + k), test_TrueNs(k, driftPpb) + test_Latency(maxLatencyNs));
+        error = (int64_t) (stamp + TIMESYNC_LATENCY_NS - test_TrueNs(k, driftPpb));
+        if ((k >= numSamples - numSamples / 4) && ((error > worst) || (-error > worst)))
+        {
+            worst = (error < 0) ? -error : error;
+        }
+    }
+    return worst;
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_Init(&test_Imu, 0));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_TimeSyncInit(&test_Imu, &test_Ts));
+    test_PeriodNs = test_Ts.periodNs;
+    test_Seed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+/* The nominal period follows DEC_RATE */
+void test_sync_init_period(void)
+{
+    TEST_ASSERT_EQUAL(SYNC_INTERNAL, test_Ts.mode);
+    TEST_ASSERT_EQUAL_UINT32(1000000000UL / MAX_DATA_RATE, test_Ts.periodNs);
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_SetDataRate(&test_Imu, MAX_DATA_RATE / 4));
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_TimeSyncInit(&test_Imu, &test_Ts));
+    TEST_ASSERT_EQUAL_UINT32(4 * (1000000000UL / MAX_DATA_RATE), test_Ts.periodNs);
+    TEST_ASSERT_FALSE(test_Ts.valid);
+}
+
+/* With interrupt latency jitter and a clock drift, the estimate settles on the earliest edges and the skew on
+   the drift, so the timestamps end up much closer to the true sample times than the raw edges are */
+void test_sync_offset_drift_convergence(void)
+{
+    const int32_t drifts[] = { 0, 50000, -50000, 200000 };
+    const uint32_t maxLatencyNs = 20000;
+
+    for (uint8_t i = 0; i < sizeof(drifts) / sizeof(drifts[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, adi_imu_TimeSyncInit(&test_Imu, &test_Ts));
+        /* 40 s at 2 kHz */
+        TEST_ASSERT_LESS_THAN_INT64(maxLatencyNs / 4, test_Run(0, 80000, drifts[i], maxLatencyNs));
+        TEST_ASSERT_INT32_WITHIN(5000, -drifts[i], test_Ts.skewPpb);
+    }
+}
+
+/* DATA_CNTR wraps from 0xFFFF to 0 without a jump in the timestamps, and a skipped sample keeps its slot */
+void test_sync_counter_wrap(void)
+{
+    uint64_t stamp;
+    uint64_t last = 0;
+    uint16_t count = 0xFFF0;
+
+    for (uint32_t k = 0; k < 64; k++)
+    {
+        if (k == 40)
+        {
+            /* Sample 40 was never read */
+            count++;
+            continue;
+        }
+        stamp = adi_imu_TimeSyncUpdate(&test_Ts, count, TEST_START_NS + k * test_PeriodNs);
+        TEST_ASSERT_EQUAL_UINT64(TEST_START_NS + k * test_PeriodNs - TIMESYNC_LATENCY_NS, stamp);
+        if (k > 0)
+        {
+            TEST_ASSERT_EQUAL_UINT64(((k == 41) ? 2 : 1) * test_PeriodNs, stamp - last);
+        }
+        last = stamp;
+        count++;
+    }
+    TEST_ASSERT_EQUAL_HEX16(0x002F, test_Ts.lastCount);
+
+    /* A repeated counter is the same sample read twice */
+    TEST_ASSERT_EQUAL_UINT64(last, adi_imu_TimeSyncUpdate(&test_Ts, 0x002F, last + 3 * test_PeriodNs));
+}
+
+/* A single very late edge barely moves the estimate, while an error beyond TIMESYNC_RESYNC_NS restarts it */
+void test_sync_outliers(void)
+{
+    const uint32_t maxLatencyNs = 5000;
+    const uint32_t settle = 20000;
+    uint64_t stamp;
+
+    test_Run(0, settle, 0, maxLatencyNs);
+
+    /* Late by almost the resync threshold */
+    stamp = adi_imu_TimeSyncUpdate(&test_Ts, (uint16_t) settle, test_TrueNs(settle, 0) + TIMESYNC_RESYNC_NS / 2);
+    TEST_ASSERT_UINT64_WITHIN(maxLatencyNs + TIMESYNC_RESYNC_NS / 2 / 64, test_TrueNs(settle, 0), stamp + TIMESYNC_LATENCY_NS);
+    stamp = adi_imu_TimeSyncUpdate(&test_Ts, (uint16_t) (settle + 1), test_TrueNs(settle + 1, 0));
+    TEST_ASSERT_UINT64_WITHIN(maxLatencyNs + TIMESYNC_RESYNC_NS / 2 / 64, test_TrueNs(settle + 1, 0), stamp + TIMESYNC_LATENCY_NS);
+
+    /* The sync source jumped, e.g. it was replaced: start over from the new edge */
+    stamp = adi_imu_TimeSyncUpdate(&test_Ts, (uint16_t) (settle + 2), test_TrueNs(settle + 2, 0) + 2 * TIMESYNC_RESYNC_NS);
+    TEST_ASSERT_EQUAL_UINT64(test_TrueNs(settle + 2, 0) + 2 * TIMESYNC_RESYNC_NS - TIMESYNC_LATENCY_NS, stamp);
+    TEST_ASSERT_EQUAL_INT32(0, test_Ts.skewPpb);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ENABLE_TIMESTAMPS
+    RUN_TEST(test_sync_init_period);
+    RUN_TEST(test_sync_offset_drift_convergence);
+    RUN_TEST(test_sync_counter_wrap);
+    RUN_TEST(test_sync_outliers);
+#endif
+    return UNITY_END();
+}
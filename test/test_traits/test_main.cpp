@@ -0,0 +1,190 @@
+/**
+  * @file	    test_main.cpp
+  * @date		10/29/2020
+  * @author		Juan Chong (juan.chong@analog.com)
+  * @brief		C++ model descriptions against the model table and scale factors of the C driver.
+ **/
+
+#include <unity.h>
+#include <type_traits>
+#include "adi_imu_traits.hpp"
+#include "adi_imu_conf.h"
+#include "imu_sim.h"
+
+#if ADIS1647X
+
+using namespace adi_imu;
+
+static adi_imu_Device test_Imu;
+
+/* Data format of the compiled C driver for a model. Register reads are 32-bit for every member, bursts only for
+   members with a 32-bit burst. Imu<> is instantiated with the delta outputs only for members with BURST_SEL */
+template<class Model>
+struct TestFormat
+{
+    static constexpr bool delta = ENABLE_DELTA_DATA;
+    static constexpr bool burstWide = SENSOR_DATA_32BIT && Model::supports32BitBurst;
+    static constexpr bool wide = burstWide || (SENSOR_DATA_32BIT && !ENABLE_BURST_MODE);
+    static constexpr bool refused = ENABLE_BURST_MODE && delta && !Model::supportsDeltaData;
+    static constexpr Output out = delta ? Output::Delta : Output::Inertial;
+    static constexpr Output burstOut = (delta && Model::supportsDeltaData) ? Output::Delta : Output::Inertial;
+    typedef typename std::conditional<wide, Burst32, Burst16>::type Format;
+    typedef typename std::conditional<burstWide, Burst32, Burst16>::type BurstFormat;
+    typedef Imu<Model, BurstFormat, burstOut> Instance;
+};
+
+/**
+ * @brief Brings up the simulated IMU as the model and initializes both the C driver and Imu<> against it.
+ *
+ * @return The status of adi_imu_Init().
+ **/
+template<class Model>
+static adi_imu_Status test_Bringup(void)
+{
+    const imu_sim_Config config = { Model::prodId, (uint16_t) (Model::range | 0x0003), 1 };
+    typename TestFormat<Model>::Instance imu(0);
+
+    imu_sim_Reset(&config);
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, imu.Init());
+    TEST_ASSERT_EQUAL_HEX16(Model::range, imu_sim_PeekReg(0, RANG_MDL) & Model::rangeMask);
+
+    return adi_imu_Init(&test_Imu, 0);
+}
+
+/**
+ * @brief Checks the traits of one model against the C model table and the scale factors adi_imu_Init() derives.
+ **/
+template<class Model>
+static void test_CheckModel(void)
+{
+    typedef TestFormat<Model> Compiled;
+    typedef BurstScale<Model, typename Compiled::Format, Compiled::out> Factor;
+    const adi_imu_Model *entry = adi_imu_FindModel(Model::prodId);
+
+    /* Every described model is a member of the C family and the capabilities agree */
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_UINT16(Model::prodId, entry->prodId);
+    TEST_ASSERT_EQUAL_UINT16(Model::stallTimeUs, entry->stallTimeUs);
+    TEST_ASSERT_EQUAL_UINT16(Model::resetRecoveryTimeMs, entry->resetRecoveryTimeMs);
+#if ENABLE_BURST_MODE
+    TEST_ASSERT_EQUAL(Model::supportsDeltaData, entry->hasBurstSel == TRUE);
+    TEST_ASSERT_EQUAL_UINT16(Compiled::Instance::burstXferLength, entry->burstXferLength);
+#endif
+#if ENABLE_BURST_MODE & SENSOR_DATA_32BIT
+    TEST_ASSERT_EQUAL(Model::supports32BitBurst, entry->burstCtrl != 0);
+#endif
+
+    /* Members which cannot burst the delta outputs are refused by the C driver, and by Imu<> at compile time */
+    if (Compiled::refused)
+    {
+        const imu_sim_Config config = { Model::prodId, (uint16_t) (Model::range | 0x0003), 1 };
+
+        imu_sim_Reset(&config);
+        TEST_ASSERT_EQUAL(ADI_IMU_BURST_NOT_SUPPORTED, adi_imu_Init(&test_Imu, 0));
+        return;
+    }
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, test_Bringup<Model>());
+
+#if ENABLE_SCALED_DATA
+    /* The table holds the accelerometer (or delta velocity) factors, RANG_MDL gives the gyroscope ones */
+    TEST_ASSERT_EQUAL_FLOAT((Compiled::out == Output::Delta) ? Model::deltaVel16Scale : Model::accel16Scale, entry->accel16Scale);
+    TEST_ASSERT_EQUAL_FLOAT((Compiled::out == Output::Delta) ? Model::deltaVel16Scale : Model::accel16Scale, test_Imu.scale16.accel16Scale);
+    TEST_ASSERT_EQUAL_FLOAT((Compiled::out == Output::Delta) ? Model::deltaAngle16Scale : Model::gyro16Scale, test_Imu.scale16.gyro16Scale);
+    TEST_ASSERT_EQUAL_FLOAT(Model::tempScale, test_Imu.scale16.tempScale);
+#if SENSOR_DATA_32BIT
+    if (Compiled::wide)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(Factor::accel, entry->accel32Scale);
+        TEST_ASSERT_EQUAL_FLOAT(Factor::accel, test_Imu.scale32.accel32Scale);
+        TEST_ASSERT_EQUAL_FLOAT(Factor::gyro, test_Imu.scale32.gyro32Scale);
+    }
+#else
+    TEST_ASSERT_EQUAL_FLOAT(Factor::accel, test_Imu.scale16.accel16Scale);
+    TEST_ASSERT_EQUAL_FLOAT(Factor::gyro, test_Imu.scale16.gyro16Scale);
+#endif
+#endif
+}
+
+void setUp(void)
+{
+    imu_sim_Reset(0);
+    imu_sim_SetSclk(1000000);
+}
+
+void tearDown(void)
+{
+    imu_sim_Reset(0);
+}
+
+void test_traits_adis16470(void)
+{
+    test_CheckModel<ADIS16470>();
+}
+
+void test_traits_adis16475(void)
+{
+    test_CheckModel<ADIS16475_1>();
+    test_CheckModel<ADIS16475_2>();
+    test_CheckModel<ADIS16475_3>();
+}
+
+void test_traits_adis16477(void)
+{
+    test_CheckModel<ADIS16477_1>();
+    test_CheckModel<ADIS16477_2>();
+    test_CheckModel<ADIS16477_3>();
+}
+
+/* Imu<>::Scale applies the same factors as adi_imu_ScaleSensorData() to a sample */
+void test_traits_scale_matches_driver(void)
+{
+    typedef TestFormat<ADIS16477_2>::Instance TestImu;
+    UnscaledData raw = { 0, 0, 1000, -2000, 3000, -4000, 5000, -6000, 250, 0 };
+    adi_imu_UnscaledData craw = { };
+    ScaledData scaled;
+    adi_imu_ScaledData cscaled;
+
+    TEST_ASSERT_EQUAL(ADI_IMU_SUCCESS, test_Bringup<ADIS16477_2>());
+    craw.xg = raw.xg;
+    craw.yg = raw.yg;
+    craw.zg = raw.zg;
+    craw.xa = raw.xa;
+    craw.ya = raw.ya;
+    craw.za = raw.za;
+    craw.temperature = raw.temperature;
+    TestImu::Scale(raw, scaled);
+    adi_imu_ScaleSensorData(&test_Imu, &craw, &cscaled);
+
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.xg, scaled.xg);
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.yg, scaled.yg);
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.zg, scaled.zg);
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.xa, scaled.xa);
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.ya, scaled.ya);
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.za, scaled.za);
+    /* The C driver adds TEMPERATURE_OFFSET, the traits leave it to the caller */
+    TEST_ASSERT_EQUAL_FLOAT(cscaled.temperature - TEMPERATURE_OFFSET, scaled.temperature);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if ADIS1647X
+    RUN_TEST(test_traits_adis16470);
+    RUN_TEST(test_traits_adis16475);
+    RUN_TEST(test_traits_adis16477);
+    RUN_TEST(test_traits_scale_matches_driver);
+#endif
+    return UNITY_END();
+}